@@ -3,6 +3,9 @@
   TFT display Widget library comprising following classes:
     1. ButtonWidget - button library
     2. SliderWidget - control sliders
+    3. MeterWidget - analogue meters
+    4. GraphWidget, TraceWidget - plot graphs
+    5. ChartWidget - scrolling strip charts
 
 ***************************************************************************************/
 #ifndef _TFT_eWidgetH_
@@ -25,4 +28,5 @@
 #include "widgets/meter/Meter.h"
 #include "widgets/graph/GraphWidget.h"
 #include "widgets/graph/TraceWidget.h"
+#include "widgets/chart/ChartWidget.h"
 #endif
\ No newline at end of file
@@ -0,0 +1,353 @@
+/***************************************************************************************
+** Code for the scrolling strip chart UI element
+** Per-series sample rings, auto scaling and sprite scrolling, see ChartWidget.h
+***************************************************************************************/
+
+#include "ChartWidget.h"
+
+/***************************************************************************************
+** Function name:           ChartWidget
+** Description:             Constructor with pointer to the TFT instance
+***************************************************************************************/
+ChartWidget::ChartWidget(TFT_eSPI *tft) : _spr(tft)
+{
+  memset(_series, 0, sizeof(_series));
+}
+
+ChartWidget::~ChartWidget(void)
+{
+  deleteChart();
+}
+
+/***************************************************************************************
+** Function name:           createChart
+** Description:             Create the chart sprite, the ring capacity follows the width
+***************************************************************************************/
+bool ChartWidget::createChart(uint16_t chartWidth, uint16_t chartHeight, uint8_t xStep, uint16_t bgColor)
+{
+  deleteChart();
+
+  if (xStep < 1) xStep = 1;
+  _width    = chartWidth;
+  _height   = chartHeight;
+  _xStep    = xStep;
+  // One sample more than fits, so the line into the left edge is still drawn
+  _capacity = (chartWidth - 1) / xStep + 2;
+  _bgColor  = bgColor;
+
+  // 8 bits per pixel: plenty for lines on a flat background, half the RAM
+  _spr.setColorDepth(8);
+  if (_spr.createSprite(_width, _height) == nullptr) return false;
+  _spr.setScrollRect(0, 0, _width, _height, _bgColor);
+  _spr.fillSprite(_bgColor);
+
+  _columns = 0;
+  _drawn   = 0;
+  _redraw  = true;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           deleteChart
+** Description:             Free the sprite and all series buffers
+***************************************************************************************/
+void ChartWidget::deleteChart(void)
+{
+  for (uint8_t i = 0; i < _seriesCount; i++) freeSeries(&_series[i]);
+  _seriesCount = 0;
+  _spr.deleteSprite();
+}
+
+void ChartWidget::freeSeries(Series *s)
+{
+  free(s->data);
+  free(s->minQ);
+  free(s->maxQ);
+  memset(s, 0, sizeof(Series));
+}
+
+/***************************************************************************************
+** Function name:           addSeries
+** Description:             Allocate the ring buffer and queues for a new series
+***************************************************************************************/
+int8_t ChartWidget::addSeries(uint16_t color)
+{
+  if (_seriesCount >= CHART_MAX_SERIES || _capacity == 0) return -1;
+
+  Series *s = &_series[_seriesCount];
+  memset(s, 0, sizeof(Series));
+  s->data = (float *)malloc(_capacity * sizeof(float));
+  s->minQ = (uint32_t *)malloc(_capacity * sizeof(uint32_t));
+  s->maxQ = (uint32_t *)malloc(_capacity * sizeof(uint32_t));
+  if (!s->data || !s->minQ || !s->maxQ) {
+    freeSeries(s);
+    return -1;
+  }
+  s->color = color;
+  return _seriesCount++;
+}
+
+/***************************************************************************************
+** Function name:           setChartGrid
+** Description:             Set the grid spacing and colour
+***************************************************************************************/
+void ChartWidget::setChartGrid(uint16_t xGridPoints, uint8_t yDivisions, uint16_t gridColor)
+{
+  _xGridPoints = xGridPoints;
+  _yDivisions  = yDivisions ? yDivisions : 1;
+  _gridColor   = gridColor;
+  _redraw      = true;
+}
+
+/***************************************************************************************
+** Function name:           setChartScale
+** Description:             Fixed Y range
+***************************************************************************************/
+void ChartWidget::setChartScale(float ymin, float ymax)
+{
+  _autoScale = false;
+  _yMin   = ymin;
+  _yMax   = (ymax > ymin) ? ymax : ymin + 1.0;
+  _redraw = true;
+}
+
+/***************************************************************************************
+** Function name:           setAutoScale
+** Description:             Fit the Y range to the samples in view
+***************************************************************************************/
+void ChartWidget::setAutoScale(float minSpan)
+{
+  _autoScale = true;
+  _minSpan   = (minSpan > 0) ? minSpan : 1.0;
+  _redraw    = true;
+}
+
+/***************************************************************************************
+** Function name:           addPoint
+** Description:             Append a sample, dropping the oldest once the ring is full
+***************************************************************************************/
+void ChartWidget::addPoint(uint8_t series, float yval)
+{
+  if (series >= _seriesCount) return;
+  Series *s = &_series[series];
+
+  uint32_t n = s->total;
+  if (n >= _capacity) s->sum -= value(s, n - _capacity);
+  s->data[n % _capacity] = yval;
+  s->sum += yval;
+  s->total = n + 1;
+
+  // Re-add the sum once per lap so float rounding cannot build up
+  if (s->total % _capacity == 0) {
+    float sum = 0;
+    for (uint16_t i = 0; i < _capacity; i++) sum += s->data[i];
+    s->sum = sum;
+  }
+
+  // Drop samples that left the view from the front of the queues
+  uint32_t oldest = (s->total > _capacity) ? s->total - _capacity : 0;
+  while (s->minLen && s->minQ[s->minHead] < oldest) {
+    s->minHead = (s->minHead + 1) % _capacity;
+    s->minLen--;
+  }
+  while (s->maxLen && s->maxQ[s->maxHead] < oldest) {
+    s->maxHead = (s->maxHead + 1) % _capacity;
+    s->maxLen--;
+  }
+
+  // Samples the new one beats can never be the min (max) again
+  while (s->minLen && value(s, s->minQ[(s->minHead + s->minLen - 1) % _capacity]) >= yval) s->minLen--;
+  s->minQ[(s->minHead + s->minLen++) % _capacity] = n;
+  while (s->maxLen && value(s, s->maxQ[(s->maxHead + s->maxLen - 1) % _capacity]) <= yval) s->maxLen--;
+  s->maxQ[(s->maxHead + s->maxLen++) % _capacity] = n;
+
+  if (s->total > _columns) _columns = s->total;
+}
+
+/***************************************************************************************
+** Function name:           getMin, getMax, getAvg, getLast, getCount
+** Description:             Stats over the samples in view
+***************************************************************************************/
+float ChartWidget::getMin(uint8_t series)
+{
+  if (series >= _seriesCount || _series[series].total == 0) return 0;
+  const Series *s = &_series[series];
+  return value(s, s->minQ[s->minHead]);
+}
+
+float ChartWidget::getMax(uint8_t series)
+{
+  if (series >= _seriesCount || _series[series].total == 0) return 0;
+  const Series *s = &_series[series];
+  return value(s, s->maxQ[s->maxHead]);
+}
+
+float ChartWidget::getAvg(uint8_t series)
+{
+  uint16_t count = getCount(series);
+  if (count == 0) return 0;
+  return _series[series].sum / count;
+}
+
+float ChartWidget::getLast(uint8_t series)
+{
+  if (series >= _seriesCount || _series[series].total == 0) return 0;
+  const Series *s = &_series[series];
+  return value(s, s->total - 1);
+}
+
+uint16_t ChartWidget::getCount(uint8_t series)
+{
+  if (series >= _seriesCount) return 0;
+  uint32_t total = _series[series].total;
+  return (total < _capacity) ? total : _capacity;
+}
+
+/***************************************************************************************
+** Function name:           getPointY
+** Description:             TFT y coordinate of a value at the position last drawn
+***************************************************************************************/
+int16_t ChartWidget::getPointY(float yval)
+{
+  return _ypos + mapY(yval);
+}
+
+int16_t ChartWidget::mapY(float yval)
+{
+  if (yval < _yMin) yval = _yMin;
+  if (yval > _yMax) yval = _yMax;
+  return (_height - 1) - (int16_t)((yval - _yMin) * (_height - 1) / (_yMax - _yMin) + 0.5);
+}
+
+/***************************************************************************************
+** Function name:           updateScale
+** Description:             Fit the auto range, returns true if it changed
+***************************************************************************************/
+// Smallest 1, 2 or 5 x 10^n at or above x
+static float niceStep(float x)
+{
+  float decade = powf(10.0, floorf(log10f(x)));
+  float m = x / decade;
+  if (m <= 1.0) return decade;
+  if (m <= 2.0) return 2.0 * decade;
+  if (m <= 5.0) return 5.0 * decade;
+  return 10.0 * decade;
+}
+
+bool ChartWidget::updateScale(void)
+{
+  bool any = false;
+  float lo = 0, hi = 0;
+  for (uint8_t i = 0; i < _seriesCount; i++) {
+    if (_series[i].total == 0) continue;
+    float smin = getMin(i), smax = getMax(i);
+    if (!any || smin < lo) lo = smin;
+    if (!any || smax > hi) hi = smax;
+    any = true;
+  }
+  if (!any) return false;
+
+  // Grow as soon as a sample leaves the range
+  bool outside = lo < _yMin || hi > _yMax;
+
+  // Fit with some headroom, so noise at the edge does not flip the scale
+  float pad = (hi - lo) / 8;
+  lo -= pad;
+  hi += pad;
+  if (hi - lo < _minSpan) {
+    float mid = (hi + lo) / 2;
+    lo = mid - _minSpan / 2;
+    hi = mid + _minSpan / 2;
+  }
+
+  float step = niceStep((hi - lo) / _yDivisions);
+  float ymin, ymax;
+  for (;;) {
+    ymin = floorf(lo / step) * step;
+    ymax = ymin + step * _yDivisions;
+    if (ymax >= hi) break;
+    step = niceStep(step * 1.5);
+  }
+
+  // Shrink once the padded samples fit a finer step
+  float current = (_yMax - _yMin) / _yDivisions;
+  if (!outside && step >= current * 0.99) return false;
+
+  _yMin = ymin;
+  _yMax = ymax;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           drawGrid
+** Description:             Draw the grid lines between columns x0 and x1
+***************************************************************************************/
+void ChartWidget::drawGrid(int16_t x0, int16_t x1)
+{
+  for (uint8_t k = 0; k <= _yDivisions; k++) {
+    int16_t y = (k * (_height - 1) + _yDivisions / 2) / _yDivisions;
+    _spr.drawFastHLine(x0, y, x1 - x0 + 1, _gridColor);
+  }
+
+  if (_xGridPoints == 0) return;
+  // Vertical lines belong to sample numbers, so they scroll with the data
+  int32_t newest = (int32_t)_columns - 1;
+  for (int32_t x = _width - 1, n = newest; x >= x0; x -= _xStep, n--) {
+    if (x > x1) continue;
+    int32_t r = n % (int32_t)_xGridPoints;
+    if (r == 0) _spr.drawFastVLine(x, 0, _height, _gridColor);
+  }
+}
+
+/***************************************************************************************
+** Function name:           drawSamples
+** Description:             Draw every series from sample number first to the newest
+***************************************************************************************/
+void ChartWidget::drawSamples(uint32_t first)
+{
+  for (uint8_t i = 0; i < _seriesCount; i++) {
+    Series *s = &_series[i];
+    for (uint32_t n = first; n < _columns; n++) {
+      if (!inView(s, n)) continue;
+      int16_t x = columnX(n);
+      int16_t y = mapY(value(s, n));
+      if (n > 0 && inView(s, n - 1)) {
+        _spr.drawLine(columnX(n - 1), mapY(value(s, n - 1)), x, y, s->color);
+      }
+      else _spr.drawPixel(x, y, s->color);
+    }
+  }
+}
+
+/***************************************************************************************
+** Function name:           drawChart
+** Description:             Scroll in the new samples and push the chart to the TFT
+***************************************************************************************/
+bool ChartWidget::drawChart(int16_t x, int16_t y)
+{
+  if (!_spr.created()) return false;
+
+  bool rescaled = _redraw;
+  if (_autoScale && updateScale()) rescaled = true;
+
+  uint32_t fresh = _columns - _drawn;
+  if (rescaled || fresh >= _capacity) {
+    _spr.fillSprite(_bgColor);
+    drawGrid(0, _width - 1);
+    drawSamples((_columns > _capacity) ? _columns - _capacity : 0);
+    _redraw = false;
+  }
+  else if (fresh > 0) {
+    // Constant cost per sample: move the pixels, draw only the exposed strip
+    int16_t dx = fresh * _xStep;
+    _spr.scroll(-dx);
+    drawGrid(_width - dx, _width - 1);
+    drawSamples(_drawn);
+  }
+  _drawn = _columns;
+
+  _xpos = x;
+  _ypos = y;
+  _spr.pushSprite(x, y);
+  return rescaled;
+}
@@ -0,0 +1,122 @@
+/***************************************************************************************
+
+  Scrolling strip chart. Each series keeps its samples in a fixed-capacity
+  ring buffer sized to the chart width, so the oldest sample drops off the
+  left edge as a new one arrives on the right. The chart is drawn into a
+  sprite: a new sample scrolls the sprite left and draws only the exposed
+  strip, then the whole chart is pushed in one go. A full redraw is only
+  needed when the scale changes.
+
+  Running minimum and maximum are kept with monotonic queues and the average
+  with a running sum, so stats and auto-scaling cost the same per sample
+  however long the chart runs.
+
+***************************************************************************************/
+#ifndef _ChartWidgetH_
+#define _ChartWidgetH_
+
+//Standard support
+#include <Arduino.h>
+
+#include <TFT_eSPI.h>
+
+#define CHART_MAX_SERIES 4
+
+class ChartWidget {
+
+ public:
+
+  ChartWidget(TFT_eSPI *tft);
+  ~ChartWidget(void);
+
+  // Sample spacing xStep in pixels sets the capacity: one ring slot per
+  // sample that fits the width, plus one. Returns false if memory ran out.
+  bool createChart(uint16_t chartWidth, uint16_t chartHeight, uint8_t xStep, uint16_t bgColor);
+  void deleteChart(void);
+
+  // Returns the series index, or -1 when all series are in use
+  int8_t addSeries(uint16_t color);
+
+  // Vertical grid line every xGridPoints samples (0 = none), scrolls with the data.
+  // yDivisions horizontal bands between the scale limits.
+  void setChartGrid(uint16_t xGridPoints, uint8_t yDivisions, uint16_t gridColor);
+
+  // Fixed Y range, values outside are clamped to the edge
+  void setChartScale(float ymin, float ymax);
+  // Fit the Y range to the samples in view, on 1/2/5 grid steps,
+  // never narrower than minSpan
+  void setAutoScale(float minSpan);
+
+  void addPoint(uint8_t series, float yval);
+
+  // Render the new samples and push the chart to the TFT.
+  // Returns true when the scale changed, so axis labels need redrawing.
+  bool drawChart(int16_t x, int16_t y);
+
+  // Stats over the samples in view, 0 if the series is empty
+  float getMin(uint8_t series);
+  float getMax(uint8_t series);
+  float getAvg(uint8_t series);
+  float getLast(uint8_t series);
+  uint16_t getCount(uint8_t series);
+
+  uint16_t getCapacity(void) { return _capacity; }
+  float getScaleMin(void) { return _yMin; }
+  float getScaleMax(void) { return _yMax; }
+
+  // TFT y coordinate of a value at the position last drawn
+  int16_t getPointY(float yval);
+
+ private:
+
+  struct Series {
+    float    *data;      // Ring, sample n in slot n % capacity
+    uint32_t *minQ;      // Sample numbers with increasing values
+    uint32_t *maxQ;      // Sample numbers with decreasing values
+    uint16_t minHead, minLen;
+    uint16_t maxHead, maxLen;
+    uint32_t total;      // Samples ever added
+    float    sum;        // Of the samples in view
+    uint16_t color;
+  };
+
+  void  freeSeries(Series *s);
+  float value(const Series *s, uint32_t n) { return s->data[n % _capacity]; }
+  bool  inView(const Series *s, uint32_t n) { return n < s->total && n + _capacity >= s->total; }
+
+  bool  updateScale(void);
+  int16_t mapY(float yval);
+  int16_t columnX(uint32_t n) { return (_width - 1) - (int32_t)(_columns - 1 - n) * _xStep; }
+  void  drawGrid(int16_t x0, int16_t x1);
+  void  drawSamples(uint32_t first);
+
+  TFT_eSprite _spr;
+
+  uint16_t _width = 0;
+  uint16_t _height = 0;
+  uint8_t  _xStep = 1;
+  uint16_t _capacity = 0;
+  uint16_t _bgColor = TFT_BLACK;
+
+  Series  _series[CHART_MAX_SERIES];
+  uint8_t _seriesCount = 0;
+  uint32_t _columns = 0;     // Newest sample number across the series, plus one
+  uint32_t _drawn = 0;       // _columns at the last drawChart()
+  bool     _redraw = true;
+
+  // Scale
+  bool  _autoScale = false;
+  float _minSpan = 1.0;
+  float _yMin = 0.0;
+  float _yMax = 100.0;
+
+  // Grid
+  uint16_t _xGridPoints = 0;
+  uint8_t  _yDivisions = 4;
+  uint16_t _gridColor = TFT_DARKGREY;
+
+  int16_t _xpos = 0;
+  int16_t _ypos = 0;
+};
+
+#endif
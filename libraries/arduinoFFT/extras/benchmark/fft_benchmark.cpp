@@ -0,0 +1,151 @@
+/*
+
+        Host benchmark: fixed-point against float ArduinoFFT
+
+        Build and run from this folder:
+          g++ -O2 -std=c++11 -I../../src fft_benchmark.cpp \
+              ../../src/arduinoFFT.cpp ../../src/arduinoFFTFixed.cpp -o fft_benchmark
+          ./fft_benchmark
+
+        For every size it transforms the same test signal (two tones and some
+        noise, 12-bit like an ADC reading) with ArduinoFFT<double> as the
+        reference, ArduinoFFT<float>, ArduinoFFT<int32_t> and
+        ArduinoFFT<int16_t>, and reports the time per forward transform plus
+        magnitude, and the error of the magnitudes against the reference
+        (as SNR over the spectrum and the worst single bin).
+
+        Host timings say little about the ESP32-C3: a desktop CPU has an FPU,
+        the C3 emulates every float operation in software. Use them to compare
+        the two integer paths; the accuracy columns carry over as they are.
+
+        This program is free software: you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation, either version 3 of the License, or
+        (at your option) any later version.
+
+*/
+
+#include "arduinoFFT.h"
+#include <chrono>
+#include <vector>
+
+static const float samplingFrequency = 8000;
+static const int repeats = 2000;
+
+static void makeSignal(std::vector<double> &out, uint_fast16_t samples) {
+  uint32_t seed = 12345;
+  out.resize(samples);
+  for (uint_fast16_t i = 0; i < samples; i++) {
+    seed = seed * 1103515245 + 12345;
+    double noise = ((int)((seed >> 16) & 0xFF) - 128) / 128.0;
+    double t = i / (double)samplingFrequency;
+    out[i] = 1200 * sin(twoPi * 440 * t) + 300 * sin(twoPi * 1870 * t) +
+             20 * noise;
+  }
+}
+
+template <typename T> struct Run {
+  double usPerTransform;
+  std::vector<double> magnitude; // In the units of the reference
+};
+
+template <typename T>
+static Run<T> runFFT(const std::vector<double> &signal, double inputScale) {
+  uint_fast16_t samples = signal.size();
+  std::vector<T> vReal(samples), vImag(samples);
+  ArduinoFFT<T> FFT(vReal.data(), vImag.data(), samples, samplingFrequency);
+  Run<T> run;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++) {
+    for (uint_fast16_t i = 0; i < samples; i++) {
+      vReal[i] = (T)(signal[i] * inputScale);
+      vImag[i] = 0;
+    }
+    FFT.compute(FFTDirection::Forward);
+    FFT.complexToMagnitude();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  run.usPerTransform =
+      std::chrono::duration<double, std::micro>(stop - start).count() /
+      repeats;
+
+  double outputScale = 1.0 / inputScale;
+  run.magnitude.resize((samples >> 1) + 1);
+  for (uint_fast16_t i = 0; i <= (samples >> 1); i++) {
+    run.magnitude[i] = vReal[i] * outputScale;
+  }
+  return run;
+}
+
+// The fixed-point output is X / 2^blockExponent
+template <typename T>
+static Run<T> runFixed(const std::vector<double> &signal, int inputShift) {
+  uint_fast16_t samples = signal.size();
+  std::vector<T> vReal(samples), vImag(samples);
+  ArduinoFFT<T> FFT(vReal.data(), vImag.data(), samples, samplingFrequency);
+  Run<T> run;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++) {
+    for (uint_fast16_t i = 0; i < samples; i++) {
+      vReal[i] = (T)lround(ldexp(signal[i], inputShift));
+      vImag[i] = 0;
+    }
+    FFT.compute(FFTDirection::Forward);
+    FFT.complexToMagnitude();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  run.usPerTransform =
+      std::chrono::duration<double, std::micro>(stop - start).count() /
+      repeats;
+
+  run.magnitude.resize((samples >> 1) + 1);
+  for (uint_fast16_t i = 0; i <= (samples >> 1); i++) {
+    run.magnitude[i] = ldexp(vReal[i], FFT.blockExponent() - inputShift);
+  }
+  return run;
+}
+
+static void compare(const char *name, double us,
+                    const std::vector<double> &reference,
+                    const std::vector<double> &magnitude) {
+  double signal = 0, error = 0, worst = 0, peak = 0;
+  for (size_t i = 0; i < reference.size(); i++) {
+    double e = magnitude[i] - reference[i];
+    signal += reference[i] * reference[i];
+    error += e * e;
+    if (fabs(e) > worst)
+      worst = fabs(e);
+    if (reference[i] > peak)
+      peak = reference[i];
+  }
+  double snr = error > 0 ? 10 * log10(signal / error) : 999;
+  printf("  %-16s %9.2f us   SNR %6.1f dB   worst bin %7.3f %% of peak\n",
+         name, us, snr, 100 * worst / peak);
+}
+
+int main() {
+  printf("ArduinoFFT fixed-point benchmark, %d transforms per size\n", repeats);
+  for (uint_fast16_t samples = 64; samples <= 1024; samples <<= 1) {
+    std::vector<double> signal;
+    makeSignal(signal, samples);
+    printf("\n%u samples\n", (unsigned)samples);
+
+    Run<double> reference = runFFT<double>(signal, 1.0);
+    Run<float> single = runFFT<float>(signal, 1.0);
+    // Inputs fill about the same share of the range as a 12-bit ADC reading
+    Run<int32_t> q31 = runFixed<int32_t>(signal, 19);
+    Run<int16_t> q15 = runFixed<int16_t>(signal, 3);
+
+    compare("double (ref)", reference.usPerTransform, reference.magnitude,
+            reference.magnitude);
+    compare("float", single.usPerTransform, reference.magnitude,
+            single.magnitude);
+    compare("int32_t (Q31)", q31.usPerTransform, reference.magnitude,
+            q31.magnitude);
+    compare("int16_t (Q15)", q15.usPerTransform, reference.magnitude,
+            q15.magnitude);
+  }
+  return 0;
+}
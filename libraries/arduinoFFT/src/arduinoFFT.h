@@ -139,4 +139,7 @@ static const float _c2[] PROGMEM = {
     0.0000479369, 0.0000239684};
 #endif
 
+/* Q15 / Q31 specializations: ArduinoFFT<int16_t> and ArduinoFFT<int32_t> */
+#include "arduinoFFTFixed.h"
+
 #endif
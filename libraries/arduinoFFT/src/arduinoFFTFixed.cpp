@@ -0,0 +1,497 @@
+/*
+        FFT library, fixed-point path
+        Copyright (C) 2010 Didier Longueville
+        Copyright (C) 2014 Enrique Condes
+        Copyright (C) 2020 Bim Overbohm (template, speed improvements)
+
+        This program is free software: you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation, either version 3 of the License, or
+        (at your option) any later version.
+
+        This program is distributed in the hope that it will be useful,
+        but WITHOUT ANY WARRANTY; without even the implied warranty of
+        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+        GNU General Public License for more details.
+
+        You should have received a copy of the GNU General Public License
+        along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#include "arduinoFFT.h"
+
+// Bitwise integer square root
+static uint64_t isqrt64(uint64_t value) {
+  uint64_t result = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+  while (bit > value)
+    bit >>= 2;
+  while (bit) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return result;
+}
+
+template <typename T> ArduinoFFTFixed<T>::ArduinoFFTFixed() {}
+
+template <typename T>
+ArduinoFFTFixed<T>::ArduinoFFTFixed(T *vReal, T *vImag, uint_fast16_t samples,
+                                    float samplingFrequency,
+                                    bool windowingFactors)
+    : _samples(samples), _samplingFrequency(samplingFrequency), _vImag(vImag),
+      _vReal(vReal) {
+  buildTwiddles(samples);
+  if (windowingFactors) {
+    _windowingFactors = new T[samples / 2];
+  }
+}
+
+template <typename T> ArduinoFFTFixed<T>::~ArduinoFFTFixed(void) {
+  delete[] _cos;
+  delete[] _sin;
+  delete[] _windowingFactors;
+}
+
+template <typename T>
+uint_fast8_t ArduinoFFTFixed<T>::blockExponent(void) const {
+  return _blockExponent;
+}
+
+template <typename T> void ArduinoFFTFixed<T>::complexToMagnitude(void) const {
+  complexToMagnitude(this->_vReal, this->_vImag, this->_samples);
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::complexToMagnitude(T *vReal, T *vImag,
+                                            uint_fast16_t samples) const {
+  // vM is half the size of vReal and vImag
+  for (uint_fast16_t i = 0; i < (samples >> 1) + 1; i++) {
+    acc_t re = vReal[i] < 0 ? -(acc_t)vReal[i] : vReal[i];
+    acc_t im = vImag[i] < 0 ? -(acc_t)vImag[i] : vImag[i];
+#ifndef FFT_FIXED_EXACT_MAGNITUDE
+    if (sizeof(T) <= 2) {
+      // alpha * max + beta * min, alpha = 123/128, beta = 51/128
+      acc_t hi = re > im ? re : im;
+      acc_t lo = re > im ? im : re;
+      vReal[i] = saturate((hi * 123 + lo * 51) >> 7);
+      continue;
+    }
+#endif
+    vReal[i] = saturate(
+        (acc_t)isqrt64((uint64_t)re * (uint64_t)re + (uint64_t)im * (uint64_t)im));
+  }
+}
+
+template <typename T> void ArduinoFFTFixed<T>::compute(FFTDirection dir) const {
+  compute(this->_vReal, this->_vImag, this->_samples, exponent(this->_samples),
+          dir);
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::compute(T *vReal, T *vImag, uint_fast16_t samples,
+                                 FFTDirection dir) const {
+  compute(vReal, vImag, samples, exponent(samples), dir);
+}
+
+// Computes in-place complex-to-complex FFT
+template <typename T>
+void ArduinoFFTFixed<T>::compute(T *vReal, T *vImag, uint_fast16_t samples,
+                                 uint_fast8_t power, FFTDirection dir) const {
+  if (_cos == nullptr || samples < 2 || samples > _tableSamples)
+    return;
+  bool forward = (dir == FFTDirection::Forward);
+
+  // Reverse bits
+  uint_fast16_t j = 0;
+  for (uint_fast16_t i = 0; i < (samples - 1); i++) {
+    if (i < j) {
+      T temp = vReal[i];
+      vReal[i] = vReal[j];
+      vReal[j] = temp;
+      temp = vImag[i];
+      vImag[i] = vImag[j];
+      vImag[j] = temp;
+    }
+    uint_fast16_t k = (samples >> 1);
+    while (k <= j) {
+      j -= k;
+      k >>= 1;
+    }
+    j += k;
+  }
+
+  // Upper bound of the largest component, OR of the magnitudes
+  acc_t peak = 0;
+  for (uint_fast16_t i = 0; i < samples; i++) {
+    acc_t re = vReal[i], im = vImag[i];
+    peak |= (re ^ (re >> (sizeof(acc_t) * 8 - 1))) |
+            (im ^ (im >> (sizeof(acc_t) * 8 - 1)));
+  }
+
+  uint_fast8_t exp = 0;
+  uint_fast8_t l = 0;
+  if (power >= 2) {
+    // Stages 1 and 2 together, a component grows at most four times
+    uint_fast8_t shift = (peak < _full / 4) ? 0 : (peak < _full / 2) ? 1 : 2;
+    peak = radix4Pass(vReal, vImag, samples, forward, shift);
+    exp += shift;
+    l = 2;
+  }
+  for (; l < power; l++) {
+    // A twiddled butterfly grows a component by at most 1 + sqrt(2)
+    uint_fast8_t shift = (peak < ((_full * 53) >> 7))    ? 0
+                         : (peak < ((_full * 106) >> 7)) ? 1
+                                                         : 2;
+    uint_fast16_t half = (uint_fast16_t)1 << l;
+    peak = radix2Stage(vReal, vImag, samples, half, _tableSamples / (half << 1),
+                       forward, shift);
+    exp += shift;
+  }
+
+  // Scaling for reverse transform, to 1 / samples like the float version
+  if (!forward) {
+    for (uint_fast16_t i = 0; i < samples; i++) {
+      if (exp >= power) {
+        vReal[i] = saturate((acc_t)vReal[i] << (exp - power));
+        vImag[i] = saturate((acc_t)vImag[i] << (exp - power));
+      } else {
+        vReal[i] >>= (power - exp);
+        vImag[i] >>= (power - exp);
+      }
+    }
+    exp = 0;
+  }
+  _blockExponent = exp;
+}
+
+template <typename T> void ArduinoFFTFixed<T>::dcRemoval(void) const {
+  dcRemoval(this->_vReal, this->_samples);
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::dcRemoval(T *vData, uint_fast16_t samples) const {
+  // calculate the mean of vData
+  acc_t mean = 0;
+  for (uint_fast16_t i = 0; i < samples; i++) {
+    mean += vData[i];
+  }
+  mean /= (acc_t)samples;
+  // Subtract the mean from vData
+  for (uint_fast16_t i = 0; i < samples; i++) {
+    vData[i] = saturate(vData[i] - mean);
+  }
+}
+
+template <typename T> float ArduinoFFTFixed<T>::majorPeak(void) const {
+  return majorPeak(this->_vReal, this->_samples, this->_samplingFrequency);
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::majorPeak(float *f, float *v) const {
+  majorPeak(this->_vReal, this->_samples, this->_samplingFrequency, f, v);
+}
+
+template <typename T>
+float ArduinoFFTFixed<T>::majorPeak(T *vData, uint_fast16_t samples,
+                                    float samplingFrequency) const {
+  float frequency;
+  majorPeak(vData, samples, samplingFrequency, &frequency, nullptr);
+  return frequency;
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::majorPeak(T *vData, uint_fast16_t samples,
+                                   float samplingFrequency, float *frequency,
+                                   float *magnitude) const {
+  uint_fast16_t IndexOfMaxY = 0;
+  findMaxY(vData, (samples >> 1) + 1, &IndexOfMaxY);
+
+  float y1 = vData[IndexOfMaxY - 1];
+  float y2 = vData[IndexOfMaxY];
+  float y3 = vData[IndexOfMaxY + 1];
+  float delta = 0.5f * ((y1 - y3) / (y1 - (2.0f * y2) + y3));
+  if (IndexOfMaxY == (samples >> 1)) { // To improve calculation on edge values
+    *frequency = ((IndexOfMaxY + delta) * samplingFrequency) / (samples);
+  } else {
+    *frequency = ((IndexOfMaxY + delta) * samplingFrequency) / (samples - 1);
+  }
+  // returned value: interpolated frequency peak apex
+  if (magnitude != nullptr) {
+    *magnitude = fabsf(y1 - (2.0f * y2) + y3);
+  }
+}
+
+template <typename T> float ArduinoFFTFixed<T>::majorPeakParabola(void) const {
+  float freq = 0;
+  majorPeakParabola(this->_vReal, this->_samples, this->_samplingFrequency,
+                    &freq, nullptr);
+  return freq;
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::majorPeakParabola(float *frequency,
+                                           float *magnitude) const {
+  majorPeakParabola(this->_vReal, this->_samples, this->_samplingFrequency,
+                    frequency, magnitude);
+}
+
+template <typename T>
+float ArduinoFFTFixed<T>::majorPeakParabola(T *vData, uint_fast16_t samples,
+                                            float samplingFrequency) const {
+  float freq = 0;
+  majorPeakParabola(vData, samples, samplingFrequency, &freq, nullptr);
+  return freq;
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::majorPeakParabola(T *vData, uint_fast16_t samples,
+                                           float samplingFrequency,
+                                           float *frequency,
+                                           float *magnitude) const {
+  uint_fast16_t IndexOfMaxY = 0;
+  findMaxY(vData, (samples >> 1) + 1, &IndexOfMaxY);
+
+  *frequency = 0;
+  if (IndexOfMaxY > 0) {
+    // Three consecutive bins on a parabola, centred on the peak
+    float y1 = vData[IndexOfMaxY - 1];
+    float y2 = vData[IndexOfMaxY];
+    float y3 = vData[IndexOfMaxY + 1];
+    float a = 0.5f * (y1 + y3) - y2;
+    float b = 0.5f * (y3 - y1);
+
+    // Peak offset from the middle bin
+    float x = (a != 0) ? -b / (2 * a) : 0;
+
+    // And magnitude is at the extrema of the parabola if you want It...
+    if (magnitude != nullptr) {
+      *magnitude = (a * x * x) + (b * x) + y2;
+    }
+
+    // Convert to frequency
+    *frequency = ((IndexOfMaxY + x) * samplingFrequency) / samples;
+  }
+}
+
+template <typename T> uint8_t ArduinoFFTFixed<T>::revision(void) {
+  return (FFT_LIB_REV);
+}
+
+// Replace the data array pointers
+template <typename T>
+void ArduinoFFTFixed<T>::setArrays(T *vReal, T *vImag, uint_fast16_t samples) {
+  _vReal = vReal;
+  _vImag = vImag;
+  if (samples) {
+    _samples = samples;
+    buildTwiddles(samples);
+    delete[] _windowingFactors;
+    _windowingFactors = new T[samples / 2];
+    _isPrecompiled = false;
+  }
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::windowing(FFTWindow windowType, FFTDirection dir,
+                                   bool withCompensation) {
+  // Factors are always kept, computing them needs float math
+  if (this->_windowingFactors == nullptr) {
+    this->_windowingFactors = new T[this->_samples / 2];
+  }
+  if (this->_isPrecompiled && this->_windowFunction == windowType &&
+      this->_precompiledWithCompensation == withCompensation) {
+    windowing(this->_vReal, this->_samples, FFTWindow::Precompiled, dir,
+              this->_windowingFactors, withCompensation);
+  } else {
+    windowing(this->_vReal, this->_samples, windowType, dir,
+              this->_windowingFactors, withCompensation);
+    this->_isPrecompiled = true;
+    this->_precompiledWithCompensation = withCompensation;
+    this->_windowFunction = windowType;
+  }
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::windowing(T *vData, uint_fast16_t samples,
+                                   FFTWindow windowType, FFTDirection dir,
+                                   T *windowingFactors, bool withCompensation) {
+  T *factors = windowingFactors;
+  if (factors == nullptr) {
+    factors = new T[samples / 2];
+  }
+  if (windowingFactors == nullptr || windowType != FFTWindow::Precompiled) {
+    // The float implementation computes the weighing factors once
+    float *ones = new float[samples];
+    float *weights = new float[samples / 2];
+    for (uint_fast16_t i = 0; i < samples; i++) {
+      ones[i] = 1.0f;
+    }
+    ArduinoFFT<float> reference;
+    reference.windowing(ones, samples, windowType, FFTDirection::Forward,
+                        weights, withCompensation);
+    // Fewer fractional bits when compensation pushes factors above 1.0
+    float maxWeight = 0;
+    for (uint_fast16_t i = 0; i < (samples >> 1); i++) {
+      if (fabsf(weights[i]) > maxWeight)
+        maxWeight = fabsf(weights[i]);
+    }
+    _windowShift = _bits - 1;
+    while (_windowShift > 0 &&
+           maxWeight * (float)((acc_t)1 << _windowShift) >= (float)_full) {
+      _windowShift--;
+    }
+    for (uint_fast16_t i = 0; i < (samples >> 1); i++) {
+      factors[i] = saturate(
+          (acc_t)lroundf(weights[i] * (float)((acc_t)1 << _windowShift)));
+    }
+    delete[] ones;
+    delete[] weights;
+  }
+
+  const acc_t round = (acc_t)1 << (_windowShift - 1);
+  for (uint_fast16_t i = 0; i < (samples >> 1); i++) {
+    acc_t w = factors[i];
+    T *a = &vData[i];
+    T *b = &vData[samples - (i + 1)];
+    if (dir == FFTDirection::Forward) {
+      *a = saturate(((acc_t)*a * w + round) >> _windowShift);
+      *b = saturate(((acc_t)*b * w + round) >> _windowShift);
+    } else if (w != 0) {
+      *a = saturate(((acc_t)*a << _windowShift) / w);
+      *b = saturate(((acc_t)*b << _windowShift) / w);
+    }
+  }
+
+  if (windowingFactors == nullptr) {
+    delete[] factors;
+  }
+}
+
+// Private functions
+
+template <typename T>
+void ArduinoFFTFixed<T>::buildTwiddles(uint_fast16_t samples) {
+  if (samples == _tableSamples && _cos != nullptr)
+    return;
+  delete[] _cos;
+  delete[] _sin;
+  _cos = new T[samples / 2];
+  _sin = new T[samples / 2];
+  _tableSamples = samples;
+  // Double for Q31, done once per size
+  for (uint_fast16_t k = 0; k < samples / 2; k++) {
+    double angle = twoPi * k / samples;
+    _cos[k] = saturate((acc_t)llround(cos(angle) * (double)_full));
+    _sin[k] = saturate((acc_t)llround(sin(angle) * (double)_full));
+  }
+}
+
+template <typename T>
+uint_fast8_t ArduinoFFTFixed<T>::exponent(uint_fast16_t value) const {
+  // Calculates the base 2 logarithm of a value
+  uint_fast8_t result = 0;
+  while (value >>= 1)
+    result++;
+  return result;
+}
+
+template <typename T>
+void ArduinoFFTFixed<T>::findMaxY(T *vData, uint_fast16_t length,
+                                  uint_fast16_t *index) const {
+  // A signal with a DC offset produces a spike on bin 0 that should be ignored.
+  // Start the search on bin 1.
+  *index = 1;
+  for (uint_fast16_t i = 1; i < length; i++) {
+    if ((vData[i - 1] < vData[i]) && (vData[i] > vData[i + 1])) {
+      if (vData[i] > vData[*index]) {
+        *index = i;
+      }
+    }
+  }
+}
+
+// Stages 1 and 2 as radix-4 butterflies. The twiddles are 1 and -j (+j for
+// the reverse transform), so there is nothing to multiply. Returns the new
+// peak bound.
+template <typename T>
+typename ArduinoFFTFixed<T>::acc_t
+ArduinoFFTFixed<T>::radix4Pass(T *vReal, T *vImag, uint_fast16_t samples,
+                               bool forward, uint_fast8_t shift) const {
+  const uint_fast8_t sign = sizeof(acc_t) * 8 - 1;
+  acc_t peak = 0;
+  for (uint_fast16_t i = 0; i < samples; i += 4) {
+    acc_t r0 = vReal[i] >> shift, i0 = vImag[i] >> shift;
+    acc_t r1 = vReal[i + 1] >> shift, i1 = vImag[i + 1] >> shift;
+    acc_t r2 = vReal[i + 2] >> shift, i2 = vImag[i + 2] >> shift;
+    acc_t r3 = vReal[i + 3] >> shift, i3 = vImag[i + 3] >> shift;
+
+    acc_t sr = r0 + r1, si = i0 + i1; // Stage 1
+    acc_t dr = r0 - r1, di = i0 - i1;
+    acc_t ur = r2 + r3, ui = i2 + i3;
+    acc_t vr = r2 - r3, vi = i2 - i3;
+    acc_t wr = forward ? vi : -vi; // (-j) * v, or (+j) * v
+    acc_t wi = forward ? -vr : vr;
+
+    acc_t out[8] = {sr + ur, si + ui, dr + wr, di + wi,
+                    sr - ur, si - ui, dr - wr, di - wi};
+    for (uint_fast8_t n = 0; n < 4; n++) {
+      vReal[i + n] = (T)out[2 * n];
+      vImag[i + n] = (T)out[2 * n + 1];
+      peak |= (out[2 * n] ^ (out[2 * n] >> sign)) |
+              (out[2 * n + 1] ^ (out[2 * n + 1] >> sign));
+    }
+  }
+  return peak;
+}
+
+// One radix-2 stage of butterflies `half` apart, twiddles taken every
+// `stride` table entries. Returns the new peak bound.
+template <typename T>
+typename ArduinoFFTFixed<T>::acc_t
+ArduinoFFTFixed<T>::radix2Stage(T *vReal, T *vImag, uint_fast16_t samples,
+                                uint_fast16_t half, uint_fast16_t stride,
+                                bool forward, uint_fast8_t shift) const {
+  const uint_fast8_t sign = sizeof(acc_t) * 8 - 1;
+  const acc_t round = (acc_t)1 << (_bits - 2);
+  acc_t peak = 0;
+  for (uint_fast16_t j = 0; j < half; j++) {
+    acc_t c = _cos[j * stride];
+    acc_t s = forward ? _sin[j * stride] : -(acc_t)_sin[j * stride];
+    for (uint_fast16_t i = j; i < samples; i += (half << 1)) {
+      uint_fast16_t i1 = i + half;
+      acc_t br = vReal[i1] >> shift, bi = vImag[i1] >> shift;
+      // (c - js) * b
+      acc_t tr = (c * br + s * bi + round) >> (_bits - 1);
+      acc_t ti = (c * bi - s * br + round) >> (_bits - 1);
+      acc_t ar = vReal[i] >> shift, ai = vImag[i] >> shift;
+
+      acc_t r0 = ar + tr, i0 = ai + ti;
+      acc_t r1 = ar - tr, i1v = ai - ti;
+      vReal[i] = (T)r0;
+      vImag[i] = (T)i0;
+      vReal[i1] = (T)r1;
+      vImag[i1] = (T)i1v;
+      peak |= (r0 ^ (r0 >> sign)) | (i0 ^ (i0 >> sign)) |
+              (r1 ^ (r1 >> sign)) | (i1v ^ (i1v >> sign));
+    }
+  }
+  return peak;
+}
+
+template <typename T> T ArduinoFFTFixed<T>::saturate(acc_t value) {
+  if (value > _full - 1)
+    return (T)(_full - 1);
+  if (value < -_full)
+    return (T)(-_full);
+  return (T)value;
+}
+
+template class ArduinoFFTFixed<int16_t>;
+template class ArduinoFFTFixed<int32_t>;
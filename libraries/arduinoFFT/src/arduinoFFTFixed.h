@@ -0,0 +1,158 @@
+/*
+
+        FFT library, fixed-point path
+        Copyright (C) 2010 Didier Longueville
+        Copyright (C) 2014 Enrique Condes
+        Copyright (C) 2020 Bim Overbohm (template, speed improvements)
+
+        This program is free software: you can redistribute it and/or modify
+        it under the terms of the GNU General Public License as published by
+        the Free Software Foundation, either version 3 of the License, or
+        (at your option) any later version.
+
+        This program is distributed in the hope that it will be useful,
+        but WITHOUT ANY WARRANTY; without even the implied warranty of
+        MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+        GNU General Public License for more details.
+
+        You should have received a copy of the GNU General Public License
+        along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+/*
+  ArduinoFFT<int16_t> (Q15) and ArduinoFFT<int32_t> (Q31) for targets without
+  an FPU, such as the RISC-V ESP32-C3. They keep the ArduinoFFT API, with
+  frequencies and peak magnitudes returned as float since those are computed
+  once per transform.
+
+  - Twiddle factors are precomputed into a table when the object is created
+    or setArrays() changes the size. compute() then only uses integer math.
+  - The first two stages run as one radix-4 pass (twiddles are 1 and -j, so
+    no multiplications), the rest as radix-2 stages.
+  - Block floating point: before each stage the data is shifted right just
+    enough for that stage not to overflow. The total shift is returned by
+    blockExponent(); forward output is X / 2^blockExponent(). The reverse
+    transform is rescaled to match the float version (divided by samples).
+  - complexToMagnitude() takes an integer square root for int32_t, whose
+    precision the approximation would throw away. int16_t uses the alpha max
+    plus beta min approximation (about 4 % worst-case error, close to its own
+    quantisation); define FFT_FIXED_EXACT_MAGNITUDE to use the square root
+    there too.
+  - Window factors above 1.0 (withCompensation) are stored with fewer
+    fractional bits and the windowed data saturates.
+
+  compute() accepts any power of two up to the size the object was set up
+  with; larger sizes are ignored.
+*/
+
+#ifndef ArduinoFFTFixed_h
+#define ArduinoFFTFixed_h
+
+#include "enumsFFT.h"
+#include <stdint.h>
+
+template <typename T> struct FFTFixedTraits;
+
+template <> struct FFTFixedTraits<int16_t> {
+  typedef int32_t acc_t; // Holds a product of two samples
+  static const uint_fast8_t bits = 16;
+};
+
+template <> struct FFTFixedTraits<int32_t> {
+  typedef int64_t acc_t;
+  static const uint_fast8_t bits = 32;
+};
+
+template <typename T> class ArduinoFFTFixed {
+public:
+  typedef typename FFTFixedTraits<T>::acc_t acc_t;
+
+  ArduinoFFTFixed();
+  ArduinoFFTFixed(T *vReal, T *vImag, uint_fast16_t samples,
+                  float samplingFrequency, bool windowingFactors = false);
+
+  ~ArduinoFFTFixed();
+
+  uint_fast8_t blockExponent(void) const;
+
+  void complexToMagnitude(void) const;
+  void complexToMagnitude(T *vReal, T *vImag, uint_fast16_t samples) const;
+
+  void compute(FFTDirection dir) const;
+  void compute(T *vReal, T *vImag, uint_fast16_t samples,
+               FFTDirection dir) const;
+  void compute(T *vReal, T *vImag, uint_fast16_t samples, uint_fast8_t power,
+               FFTDirection dir) const;
+
+  void dcRemoval(void) const;
+  void dcRemoval(T *vData, uint_fast16_t samples) const;
+
+  float majorPeak(void) const;
+  void majorPeak(float *f, float *v) const;
+  float majorPeak(T *vData, uint_fast16_t samples,
+                  float samplingFrequency) const;
+  void majorPeak(T *vData, uint_fast16_t samples, float samplingFrequency,
+                 float *frequency, float *magnitude) const;
+
+  float majorPeakParabola(void) const;
+  void majorPeakParabola(float *frequency, float *magnitude) const;
+  float majorPeakParabola(T *vData, uint_fast16_t samples,
+                          float samplingFrequency) const;
+  void majorPeakParabola(T *vData, uint_fast16_t samples,
+                         float samplingFrequency, float *frequency,
+                         float *magnitude) const;
+
+  uint8_t revision(void);
+
+  void setArrays(T *vReal, T *vImag, uint_fast16_t samples = 0);
+
+  void windowing(FFTWindow windowType, FFTDirection dir,
+                 bool withCompensation = false);
+  void windowing(T *vData, uint_fast16_t samples, FFTWindow windowType,
+                 FFTDirection dir, T *windowingFactors = nullptr,
+                 bool withCompensation = false);
+
+private:
+  static const uint_fast8_t _bits = FFTFixedTraits<T>::bits;
+  static const acc_t _full = (acc_t)1 << (_bits - 1); // 1.0 in Qn
+
+  /* Variables */
+  mutable uint_fast8_t _blockExponent = 0;
+  bool _isPrecompiled = false;
+  bool _precompiledWithCompensation = false;
+  uint_fast8_t _windowShift = _bits - 1; // Fractional bits of the factors
+  T *_cos = nullptr;                     // cos(2*pi*k/_tableSamples)
+  T *_sin = nullptr;
+  uint_fast16_t _tableSamples = 0;
+  T *_windowingFactors = nullptr;
+  uint_fast16_t _samples = 0;
+  float _samplingFrequency = 0;
+  T *_vImag = nullptr;
+  T *_vReal = nullptr;
+  FFTWindow _windowFunction;
+  /* Functions */
+  void buildTwiddles(uint_fast16_t samples);
+  uint_fast8_t exponent(uint_fast16_t value) const;
+  void findMaxY(T *vData, uint_fast16_t length,
+                uint_fast16_t *index) const;
+  acc_t radix4Pass(T *vReal, T *vImag, uint_fast16_t samples, bool forward,
+                   uint_fast8_t shift) const;
+  acc_t radix2Stage(T *vReal, T *vImag, uint_fast16_t samples,
+                    uint_fast16_t half, uint_fast16_t stride, bool forward,
+                    uint_fast8_t shift) const;
+  static T saturate(acc_t value);
+};
+
+/* Fixed-point element types map onto the implementation above */
+template <> class ArduinoFFT<int16_t> : public ArduinoFFTFixed<int16_t> {
+public:
+  using ArduinoFFTFixed<int16_t>::ArduinoFFTFixed;
+};
+
+template <> class ArduinoFFT<int32_t> : public ArduinoFFTFixed<int32_t> {
+public:
+  using ArduinoFFTFixed<int32_t>::ArduinoFFTFixed;
+};
+
+#endif
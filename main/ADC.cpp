@@ -10,17 +10,35 @@
 #include "Alarm.h"
 #include <math.h>
 #include "driver/adc.h"
+#include "SensorHub.h"
+#include "FixedMath.h"
 MeterWidget volts = MeterWidget(&tft);
 
 #define BAT_PIN         2
 #define ADC_CHANNEL     ADC1_CHANNEL_2
 #define ADC_ATTEN       ADC_ATTEN_DB_12
 #define ADC_WIDTH       ADC_WIDTH_BIT_12
+#define ADC_FRAME_MAX   (ADC_MAX_SAMPLE_RATE * ADC_FRAME_MS / 1000)
 
 static esp_adc_cal_characteristics_t adc1_chars;
 bool cali_enable = false;
 bool stopADCTask = false;
 
+// --- Sampler State ---
+static TaskHandle_t samplerTaskHandle = NULL;
+static volatile uint32_t cmd_rate = ADC_DEFAULT_SAMPLE_RATE;   // Any task writes, sampler applies
+static volatile uint8_t iir_shift = ADC_IIR_SHIFT_DEFAULT;
+static volatile AdcSampleCallback sample_tap = NULL;
+static AdcReadingCallback subscribers[ADC_MAX_SUBSCRIBERS];
+static portMUX_TYPE subscribers_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t active_rate = 0;
+static uint32_t frame_samples = 0;
+static uint32_t decimation = 1;
+
+// --- Latest Reading (seqlock, one writer) ---
+static uint32_t reading_seq = 0;          // Odd while `latest` is being written
+static AdcReading latest = {};
+
 static bool adc_calibration_init() {
     esp_err_t ret = esp_adc_cal_check_efuse(ESP_ADC_CAL_VAL_EFUSE_TP);
     if (ret == ESP_ERR_NOT_SUPPORTED) return false;
@@ -32,35 +50,210 @@ static bool adc_calibration_init() {
     return false;
 }
 
+// Photoresistor divider constants
+#define ADC_VREF_MV 3300
+static const uint32_t R_FIXED = 20000;
+static const uint32_t R10 = 8000;
+static const fix16_t INV_NEG_GAMMA = FIX_FROM_FLOAT(-1.0 / 0.6); // GAMMA = 0.6
+
+static uint32_t rawToMillivolts(uint32_t raw) {
+    if (cali_enable) {
+        return esp_adc_cal_raw_to_voltage(raw, &adc1_chars);
+    }
+    return (raw * 3300) / 4095;
+}
+
+// lux = 10 * (R_photo / R10)^(-1 / GAMMA), in Q16.16 without soft-float.
+// Saturates near 33000 lux, far beyond what the divider resolves.
+static float millivoltsToLux(uint32_t millivolts) {
+    if (millivolts == 0) millivolts = 1;
+    if (millivolts >= ADC_VREF_MV) millivolts = ADC_VREF_MV - 1;
+    fix16_t ratio = (fix16_t)(((uint64_t)millivolts * R_FIXED << 16) / ((uint64_t)(ADC_VREF_MV - millivolts) * R10));
+    fix16_t lux = Fix_Pow(ratio, INV_NEG_GAMMA);
+    if (lux > FIX_MAX / 10) lux = FIX_MAX / 10;
+    return Fix_ToFloat(lux * 10);
+}
+
+// =====================================================================================
+//                                      SAMPLER
+// =====================================================================================
+
+// (Re)starts the DMA driver at `rate`. Frames are ADC_FRAME_MS long.
+static bool configureSampler(uint32_t rate) {
+    if (active_rate != 0) {
+        adc_digi_stop();
+        adc_digi_deinitialize();
+        active_rate = 0;
+    }
+    if (rate < SOC_ADC_SAMPLE_FREQ_THRES_LOW) rate = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+    if (rate > ADC_MAX_SAMPLE_RATE) rate = ADC_MAX_SAMPLE_RATE;
+    frame_samples = rate * ADC_FRAME_MS / 1000;
+    decimation = rate / ADC_OUTPUT_RATE;
+    if (decimation == 0) decimation = 1;
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = frame_samples * SOC_ADC_DIGI_RESULT_BYTES * 4;
+    init.conv_num_each_intr = frame_samples * SOC_ADC_DIGI_RESULT_BYTES;
+    init.adc1_chan_mask = BIT(ADC_CHANNEL);
+    init.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&init) != ESP_OK) {
+        Serial.println("ADC: DMA init failed");
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN;
+    pattern.channel = ADC_CHANNEL;
+    pattern.unit = 0;
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = false;
+    config.conv_limit_num = 250;
+    config.pattern_num = 1;
+    config.adc_pattern = &pattern;
+    config.sample_freq_hz = rate;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    adc_digi_controller_configure(&config);
+    adc_digi_start();
+    active_rate = rate;
+    Serial.printf("ADC: %lu Hz, %lu samples per frame, /%lu\n", rate, frame_samples, decimation);
+    return true;
+}
+
+static void publish(uint32_t raw_q4) {
+    AdcReading r;
+    r.raw_q4 = raw_q4;
+    r.millivolts = rawToMillivolts((raw_q4 + 8) >> 4);
+    r.time_ms = millis();
+
+    // Seqlock writer, single producer. The fences keep the copy between the
+    // two counter bumps for both the compiler and the CPU.
+    uint32_t seq = __atomic_load_n(&reading_seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&reading_seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    latest = r;
+    __atomic_store_n(&reading_seq, seq + 2, __ATOMIC_RELEASE);
+
+    for (int i = 0; i < ADC_MAX_SUBSCRIBERS; i++) {
+        AdcReadingCallback cb = subscribers[i];
+        if (cb != NULL) cb(r);
+    }
+}
+
+static void Sampler_Task(void *pvParameters) {
+    static uint8_t frame[ADC_FRAME_MAX * SOC_ADC_DIGI_RESULT_BYTES];
+    static uint16_t samples[ADC_FRAME_MAX];
+    uint32_t acc = 0, acc_count = 0;
+    int32_t iir_q16 = -1;                   // raw << 16, -1 until the first reading
+
+    for (;;) {
+        if (cmd_rate != active_rate && configureSampler(cmd_rate)) {
+            acc = 0;
+            acc_count = 0;
+        }
+        if (active_rate == 0) { vTaskDelay(pdMS_TO_TICKS(1000)); continue; }
+
+        uint32_t got = 0;
+        if (adc_digi_read_bytes(frame, frame_samples * SOC_ADC_DIGI_RESULT_BYTES, &got, 2 * ADC_FRAME_MS) != ESP_OK) continue;
+
+        size_t count = 0;
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= got; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            adc_digi_output_data_t *p = (adc_digi_output_data_t *)&frame[i];
+            if (p->type2.unit != 0 || p->type2.channel != ADC_CHANNEL) continue;
+            samples[count++] = p->type2.data;
+        }
+        AdcSampleCallback tap = sample_tap;
+        if (tap != NULL && count > 0) tap(samples, count);
+
+        // Decimating oversampling, then the one-pole low-pass
+        for (size_t i = 0; i < count; i++) {
+            acc += samples[i];
+            if (++acc_count < decimation) continue;
+            int32_t x_q16 = (int32_t)(((uint64_t)acc << 16) / acc_count);
+            acc = 0;
+            acc_count = 0;
+            if (iir_q16 < 0) iir_q16 = x_q16;
+            else iir_q16 += (x_q16 - iir_q16) >> iir_shift;
+            publish((uint32_t)iir_q16 >> 12);
+        }
+    }
+}
+
+// Runs on the hub task; the sampler has already done the filtering.
+static void pollLux() {
+    SensorHub_Publish(SENSOR_LUX, readLux());
+}
+
 void setupADC() {
-    adc1_config_width(ADC_WIDTH);
-    adc1_config_channel_atten(ADC_CHANNEL, ADC_ATTEN);
     cali_enable = adc_calibration_init();
+    if (samplerTaskHandle == NULL) {
+        xTaskCreatePinnedToCore(Sampler_Task, "ADC_Sampler", 3072, NULL, 3, &samplerTaskHandle, 0);
+        SensorHub_RegisterDriver("lux", ADC_LUX_PERIOD_MS, pollLux);
+    }
+}
+
+void ADC_SetSampleRate(uint32_t hz) {
+    cmd_rate = hz;
+}
+
+uint32_t ADC_SampleRate() {
+    return active_rate;
+}
+
+void ADC_SetFilterShift(uint8_t shift) {
+    iir_shift = (shift > 12) ? 12 : shift;
+}
+
+bool ADC_Subscribe(AdcReadingCallback callback) {
+    bool added = false;
+    taskENTER_CRITICAL(&subscribers_mux);
+    for (int i = 0; i < ADC_MAX_SUBSCRIBERS && !added; i++) {
+        if (subscribers[i] == callback) added = true;
+    }
+    for (int i = 0; i < ADC_MAX_SUBSCRIBERS && !added; i++) {
+        if (subscribers[i] == NULL) { subscribers[i] = callback; added = true; }
+    }
+    taskEXIT_CRITICAL(&subscribers_mux);
+    return added;
+}
+
+void ADC_Unsubscribe(AdcReadingCallback callback) {
+    taskENTER_CRITICAL(&subscribers_mux);
+    for (int i = 0; i < ADC_MAX_SUBSCRIBERS; i++) {
+        if (subscribers[i] == callback) subscribers[i] = NULL;
+    }
+    taskEXIT_CRITICAL(&subscribers_mux);
+}
+
+void ADC_SetSampleTap(AdcSampleCallback callback) {
+    sample_tap = callback;
+}
+
+AdcReading ADC_Latest() {
+    AdcReading r;
+    uint32_t seq;
+    do {
+        seq = __atomic_load_n(&reading_seq, __ATOMIC_ACQUIRE);
+        r = latest;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || seq != __atomic_load_n(&reading_seq, __ATOMIC_RELAXED));
+    return r;
+}
+
+// Filtered, so cheap enough for any background consumer
+float readLux() {
+    return millivoltsToLux(ADC_Latest().millivolts);
 }
 
 void ADC_Task(void *pvParameters) {
     volts.analogMeter(0, 0, 3.3f, "V", "0", "0.8", "1.6", "2.4", "3.3");
 
-    const float R_FIXED = 20000.0f;
-    const float R10 = 8000.0f;
-    const float GAMMA = 0.6f;
-
     while (!stopADCTask) {
-        uint32_t sum = 0;
-        const int samples = 50;
-        for (int i = 0; i < samples; i++) {
-            sum += adc1_get_raw(ADC_CHANNEL);
-            delay(1);
-        }
-        sum /= samples;
-
-        float voltage_v = 0;
-        if (cali_enable) {
-            uint32_t voltage_mv = esp_adc_cal_raw_to_voltage(sum, &adc1_chars);
-            voltage_v = voltage_mv / 1000.0f;
-        } else {
-            voltage_v = (sum * 3.3) / 4095.0;
-        }
+        AdcReading reading = ADC_Latest();
+        uint32_t sum = (reading.raw_q4 + 8) >> 4;
+        float voltage_v = reading.millivolts / 1000.0f;
         volts.updateNeedle(voltage_v, 0);
 
         // --- Flicker-free display updates using sprite ---
@@ -69,8 +262,7 @@ void ADC_Task(void *pvParameters) {
         menuSprite.setTextColor(TFT_WHITE, TFT_BLACK);
 
         // Calculate and display Lux
-        float r_photo = (voltage_v * R_FIXED) / (3.3f - voltage_v);
-        float lux = pow((r_photo / R10), (1.0f / -GAMMA)) * 10.0f;
+        float lux = millivoltsToLux(reading.millivolts);
 
         char luxStr[10];
         dtostrf(lux, 4, 1, luxStr);
@@ -1,7 +1,47 @@
 #ifndef ADC_H
 #define ADC_H
 
+#include <Arduino.h>
 
+// Photoresistor channel (ADC1 channel 2) sampled continuously through the DMA
+// ADC driver. The sampler task wakes once per hardware frame, averages every
+// sample_rate / ADC_OUTPUT_RATE samples into one oversampled reading (two extra
+// bits at the default rate), smooths that with a one-pole fixed-point IIR
+// low-pass and hands it to the subscribers. Nobody else touches the ADC.
+#define ADC_DEFAULT_SAMPLE_RATE  1000   // Hz
+#define ADC_MAX_SAMPLE_RATE      20000  // Sizes the frame buffers
+#define ADC_OUTPUT_RATE          50     // Filtered readings per second
+#define ADC_FRAME_MS             20     // DMA frame, the sampler wakes once per frame
+#define ADC_IIR_SHIFT_DEFAULT    3      // Time constant of 2^shift readings (160 ms)
+#define ADC_MAX_SUBSCRIBERS      4
+#define ADC_LUX_PERIOD_MS        1000   // Lux published to the sensor hub
+
+struct AdcReading {
+    uint32_t raw_q4;        // 12-bit reading with 4 fractional bits
+    uint16_t millivolts;    // Calibrated
+    uint32_t time_ms;       // millis() of the frame it came from
+};
+
+// Called on the sampler task; keep them short.
+typedef void (*AdcReadingCallback)(const AdcReading& reading);
+typedef void (*AdcSampleCallback)(const uint16_t* samples, size_t count);
+
+// Starts the sampler. Call once at boot.
 void setupADC();
+
+// Takes effect within one frame. The filtered output rate stays ADC_OUTPUT_RATE.
+void ADC_SetSampleRate(uint32_t hz);
+uint32_t ADC_SampleRate();
+void ADC_SetFilterShift(uint8_t shift);
+
+bool ADC_Subscribe(AdcReadingCallback callback);
+void ADC_Unsubscribe(AdcReadingCallback callback);
+// Raw samples of every frame, before decimation. One tap at a time, NULL removes it.
+void ADC_SetSampleTap(AdcSampleCallback callback);
+
+// Latest filtered reading, for callers that just want the current value.
+AdcReading ADC_Latest();
+float readLux();
+
 void ADCMenu();
-#endif 
\ No newline at end of file
+#endif
@@ -0,0 +1,24 @@
+#include "AHT20.h"
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_AHTX0.h>
+#include "SensorHub.h"
+
+static Adafruit_AHTX0 aht;
+
+// Runs on the hub task.
+static void pollAHT20() {
+    sensors_event_t humidity, temp;
+    if (!aht.getEvent(&humidity, &temp)) return; // Busy or no ACK, try next period
+    SensorHub_Publish(SENSOR_AHT20_TEMP, temp.temperature);
+    SensorHub_Publish(SENSOR_AHT20_HUMIDITY, humidity.relative_humidity);
+}
+
+bool AHT20_Init() {
+    Wire.begin(AHT20_SDA_PIN, AHT20_SCL_PIN);
+    if (!aht.begin()) {
+        Serial.println("AHT20: not found");
+        return false;
+    }
+    return SensorHub_RegisterDriver("aht20", AHT20_PERIOD_MS, pollAHT20);
+}
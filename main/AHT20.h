@@ -0,0 +1,13 @@
+#ifndef AHT20_H
+#define AHT20_H
+
+// AHT20 temperature/humidity sensor on I2C, as wired in testAHT20 and Temp/.
+// GPIO20/21 are the UART0 pins, so Serial has to be on USB CDC (it is on this board).
+#define AHT20_SDA_PIN     20
+#define AHT20_SCL_PIN     21
+#define AHT20_PERIOD_MS   5000   // One measurement takes ~80 ms
+
+// Starts I2C and registers the sensor with the hub. False if it does not answer.
+bool AHT20_Init();
+
+#endif // AHT20_H
@@ -4,14 +4,20 @@
 #include "Buzzer.h"
 #include "weather.h" // For time functions
 #include "MQTT.h"    // For exitSubMenu
-#include <EEPROM.h>
+#include "Settings.h"
+#include "MusicBank.h"
+#include "NoteSequencer.h"
+#include "LedEngine.h"
+#include <EEPROM.h> // Legacy layout, only read for migration
 #include <freertos/task.h> // For task management
 #include <pgmspace.h>
 
 #define MAX_ALARMS 10
-#define EEPROM_START_ADDR 0
+#define EEPROM_START_ADDR 0     // Legacy EEPROM layout
 #define EEPROM_MAGIC_KEY 0xAD
+#define ALARM_SETTINGS_VERSION 1
 #define ALARMS_PER_PAGE 5
+#define ALARM_LED_PULSE_MS 1000 // Red pulse on the notify layer while ringing
 
 // --- Global state for alarm ringing ---
 volatile bool g_alarm_is_ringing = false;
@@ -27,7 +33,6 @@ static int last_checked_day = -1;
 
 // --- Task Handles ---
 static TaskHandle_t alarmMusicTaskHandle = NULL;
-static volatile bool stopAlarmMusic = false;
 
 // --- UI State Variables ---
 static int list_selected_index = 0;
@@ -156,14 +161,18 @@ static void drawEditScreen(const AlarmSetting& alarm, EditMode mode, int day_cur
 // =====================================================================================
 
 static void saveAlarms() {
-  EEPROM.write(EEPROM_START_ADDR, EEPROM_MAGIC_KEY);
-  EEPROM.put(EEPROM_START_ADDR + 1, alarms);
-  EEPROM.commit();
+  Settings_Save(SETTINGS_KEY_ALARMS, ALARM_SETTINGS_VERSION, alarms, sizeof(alarms));
 }
 
 static void loadAlarms() {
-  if (EEPROM.read(EEPROM_START_ADDR) == EEPROM_MAGIC_KEY) {
+  bool loaded = Settings_Load(SETTINGS_KEY_ALARMS, ALARM_SETTINGS_VERSION, alarms, sizeof(alarms));
+  if (!loaded && EEPROM.read(EEPROM_START_ADDR) == EEPROM_MAGIC_KEY) {
+    // Migrate alarms saved by older firmware
     EEPROM.get(EEPROM_START_ADDR + 1, alarms);
+    saveAlarms();
+    loaded = true;
+  }
+  if (loaded) {
     alarm_count = 0;
     for (int i = 0; i < MAX_ALARMS; ++i) if (alarms[i].hour != 255) alarm_count++;
   } else {
@@ -187,27 +196,17 @@ static void Alarm_Delete(int index) {
 
 void Alarm_MusicLoop_Task(void *pvParameters) {
     while (true) {
-        for (int i = 0; i < numSongs; i++) {
-            if (stopAlarmMusic) {
-                vTaskDelete(NULL);
-            }
-
-            Song currentSong;
-            memcpy_P(&currentSong, &songs[i], sizeof(Song));
-
-            for (int j = 0; j < currentSong.length; j++) {
-                if (stopAlarmMusic) {
-                    noTone(BUZZER_PIN);
-                    vTaskDelete(NULL);
-                }
-                int note = pgm_read_word(&currentSong.melody[j]);
-                int duration = pgm_read_word(&currentSong.durations[j]);
-                
-                tone(BUZZER_PIN, note, duration * 0.9);
-                vTaskDelay(pdMS_TO_TICKS(duration));
-            }
+        for (int i = 0; i < MusicBank_Count(); i++) {
+            if (!Sequencer_Play(i, 90)) continue; // Slightly detached notes
+            // Stopped or replaced: stay parked until Alarm_StopMusic() deletes us
+            while (Sequencer_WaitEnd() != SEQ_END_FINISHED) {}
             vTaskDelay(pdMS_TO_TICKS(500)); // Pause between songs
         }
+        if (MusicBank_Count() == 0) {
+            // No bank on flash: fall back to a plain beep pattern
+            tone(BUZZER_PIN, 2000, 200);
+            vTaskDelay(pdMS_TO_TICKS(500));
+        }
     }
 }
 
@@ -217,25 +216,26 @@ static void triggerAlarm(int index) {
   Serial.printf("ALARM %d TRIGGERED! PLAYING MUSIC...\n", index);
 
   if (alarmMusicTaskHandle != NULL) {
+      Sequencer_Stop();
       vTaskDelete(alarmMusicTaskHandle);
       alarmMusicTaskHandle = NULL;
   }
 
   exitSubMenu = true;
   g_alarm_is_ringing = true;
-  stopAlarmMusic = false;
+  LedEngine_Notify(0xFF0000, ALARM_LED_PULSE_MS, 0); // Until stopped
   
   xTaskCreatePinnedToCore(Alarm_MusicLoop_Task, "AlarmMusicLoopTask", 8192, NULL, 1, &alarmMusicTaskHandle, 0);
 }
 
 void Alarm_StopMusic() {
+    Sequencer_Stop(); // Before deleting the task that waits on it
     if (alarmMusicTaskHandle != NULL) {
-        stopAlarmMusic = true;
-        vTaskDelay(pdMS_TO_TICKS(50)); // Give task time to stop
-        // No need to delete, task will delete itself.
+        vTaskDelete(alarmMusicTaskHandle);
         alarmMusicTaskHandle = NULL;
     }
     noTone(BUZZER_PIN); // Ensure sound stops immediately
+    LedEngine_ClearNotify();
     g_alarm_is_ringing = false;
     Serial.println("Alarm music stopped by user.");
     menuSprite.setTextFont(1);
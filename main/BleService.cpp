@@ -0,0 +1,143 @@
+#include "BleService.h"
+#include <NimBLEDevice.h>
+#include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "SensorHub.h"
+#include "MQTT.h"
+#include "MqttSpool.h"
+
+// Connection parameters requested from the phone, in 1.25 ms units.
+// A long interval plus slave latency lets the controller skip idle events.
+#define BLE_CONN_MIN_INTERVAL  160   // 200 ms
+#define BLE_CONN_MAX_INTERVAL  320   // 400 ms
+#define BLE_CONN_LATENCY       2
+#define BLE_CONN_TIMEOUT       600   // 6 s, in 10 ms units
+
+// Only notify when a value moved by more than this
+#define BLE_TEMP_DEADBAND_C10  1
+#define BLE_LUX_DEADBAND       5
+
+// --- Objects ---
+static NimBLEServer* bleServer = NULL;
+static NimBLECharacteristic* tempChar = NULL;
+static NimBLECharacteristic* lightChar = NULL;
+static NimBLECharacteristic* statusChar = NULL;
+static TaskHandle_t bleTaskHandle = NULL;
+
+// --- Last notified values ---
+static int16_t lastTempC10 = INT16_MIN;
+static int32_t lastLux = -1;
+
+// =====================================================================================
+//                                     CALLBACKS
+// =====================================================================================
+
+class ServerCallbacks : public NimBLEServerCallbacks {
+    void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo) override {
+        Serial.printf("BLE: connected, interval %u\n", connInfo.getConnInterval());
+        pServer->updateConnParams(connInfo.getConnHandle(), BLE_CONN_MIN_INTERVAL, BLE_CONN_MAX_INTERVAL,
+                                  BLE_CONN_LATENCY, BLE_CONN_TIMEOUT);
+        // Force a full update for the new client
+        lastTempC10 = INT16_MIN;
+        lastLux = -1;
+        if (bleTaskHandle != NULL) xTaskNotifyGive(bleTaskHandle);
+    }
+
+    void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
+        Serial.printf("BLE: disconnected, reason %d\n", reason);
+        // Advertising restarts automatically (advertiseOnDisconnect)
+    }
+};
+
+class CommandCallbacks : public NimBLECharacteristicCallbacks {
+    void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) override {
+        NimBLEAttValue value = pCharacteristic->getValue();
+        char command[64];
+        size_t length = value.length();
+        if (length >= sizeof(command)) length = sizeof(command) - 1;
+        memcpy(command, value.data(), length);
+        command[length] = '\0';
+        Serial.printf("BLE command: %s\n", command);
+        handleRemoteCommand(command);
+    }
+};
+
+static ServerCallbacks serverCallbacks;
+static CommandCallbacks commandCallbacks;
+
+// =====================================================================================
+//                                     NOTIFY TASK
+// =====================================================================================
+
+// Updates all characteristics back to back so the controller sends the
+// notifications in the same connection event instead of waking per value.
+static void publishReadings() {
+    int16_t tempC10 = (int16_t)(SensorHub_Value(SENSOR_DS18B20_TEMP, -127.0f) * 10.0f);
+    float luxValue = SensorHub_Value(SENSOR_LUX, 0.0f);
+    int32_t lux = (luxValue > 65535.0f) ? 65535 : (int32_t)luxValue;
+
+    if (abs(tempC10 - lastTempC10) >= BLE_TEMP_DEADBAND_C10) {
+        lastTempC10 = tempC10;
+        tempChar->setValue(tempC10);
+        tempChar->notify();
+    }
+    if (lastLux < 0 || abs(lux - lastLux) >= BLE_LUX_DEADBAND) {
+        lastLux = lux;
+        lightChar->setValue((uint16_t)lux);
+        lightChar->notify();
+    }
+
+    BleStatusPayload status;
+    status.uptime_s = millis() / 1000;
+    status.free_heap = ESP.getFreeHeap();
+    status.wifi_rssi = (WiFi.status() == WL_CONNECTED) ? (int8_t)WiFi.RSSI() : 0;
+    uint32_t spooled = MqttSpool_Count();
+    status.mqtt_spooled = (spooled > 0xFFFF) ? 0xFFFF : spooled;
+    statusChar->setValue(status); // Read-only for clients, no notify: it changes every second
+}
+
+static void BleService_Task(void *pvParameters) {
+    for (;;) {
+        if (bleServer->getConnectedCount() == 0) {
+            // Nothing to do until a phone connects
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        publishReadings();
+        vTaskDelay(pdMS_TO_TICKS(BLE_UPDATE_PERIOD_MS));
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void BleService_Init() {
+    if (bleServer != NULL) return;
+
+    NimBLEDevice::init(BLE_DEVICE_NAME);
+    bleServer = NimBLEDevice::createServer();
+    bleServer->setCallbacks(&serverCallbacks, false);
+    bleServer->advertiseOnDisconnect(true);
+
+    NimBLEService* service = bleServer->createService(BLE_SERVICE_UUID);
+    tempChar = service->createCharacteristic(BLE_CHAR_TEMP_UUID, NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY);
+    lightChar = service->createCharacteristic(BLE_CHAR_LIGHT_UUID, NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY);
+    statusChar = service->createCharacteristic(BLE_CHAR_STATUS_UUID, NIMBLE_PROPERTY::READ);
+    NimBLECharacteristic* commandChar = service->createCharacteristic(
+        BLE_CHAR_COMMAND_UUID, NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR);
+    commandChar->setCallbacks(&commandCallbacks);
+    service->start();
+
+    NimBLEAdvertising* advertising = NimBLEDevice::getAdvertising();
+    advertising->setName(BLE_DEVICE_NAME);
+    advertising->addServiceUUID(BLE_SERVICE_UUID);
+    // Slow advertising: the clock is stationary, 0.5-1 s discovery is fine
+    advertising->setMinInterval(800);   // 500 ms, 0.625 ms units
+    advertising->setMaxInterval(1600);  // 1 s
+    advertising->start();
+
+    xTaskCreatePinnedToCore(BleService_Task, "BleService", 3072, NULL, 1, &bleTaskHandle, 0);
+    Serial.println("BLE service advertising as " BLE_DEVICE_NAME);
+}
@@ -0,0 +1,32 @@
+#ifndef BLE_SERVICE_H
+#define BLE_SERVICE_H
+
+#include <Arduino.h>
+
+// BLE GATT service for monitoring and controlling the clock without WiFi.
+// Readings are notified together once per update period so they leave in a
+// single connection event, and only when they changed, keeping the radio idle.
+//   Temperature  (read/notify)  int16, 0.1 C
+//   Light        (read/notify)  uint16, lux
+//   Status       (read)         BleStatusPayload
+//   Command      (write)        same text commands as MQTT ("exit", menu or song name)
+#define BLE_DEVICE_NAME        "DeskClock"
+#define BLE_SERVICE_UUID       "8d3e0001-5c2a-4b7e-9f61-3a0c2d7e1b40"
+#define BLE_CHAR_TEMP_UUID     "8d3e0002-5c2a-4b7e-9f61-3a0c2d7e1b40"
+#define BLE_CHAR_LIGHT_UUID    "8d3e0003-5c2a-4b7e-9f61-3a0c2d7e1b40"
+#define BLE_CHAR_STATUS_UUID   "8d3e0004-5c2a-4b7e-9f61-3a0c2d7e1b40"
+#define BLE_CHAR_COMMAND_UUID  "8d3e0005-5c2a-4b7e-9f61-3a0c2d7e1b40"
+
+#define BLE_UPDATE_PERIOD_MS   1000
+
+struct __attribute__((packed)) BleStatusPayload {
+    uint32_t uptime_s;
+    uint32_t free_heap;
+    int8_t   wifi_rssi;     // 0 when WiFi is not connected
+    uint16_t mqtt_spooled;  // Messages waiting in the MQTT spool
+};
+
+// Starts the GATT server, advertising and the notify task.
+void BleService_Init();
+
+#endif // BLE_SERVICE_H
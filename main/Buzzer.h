@@ -12,41 +12,6 @@ enum PlayMode {
   RANDOM_PLAY    // 随机播放
 };
 #include <TFT_eSPI.h>
-#include "Music_processed/cai_bu_tou.h"
-#include "Music_processed/cheng_du.h"
-#include "Music_processed/hai_kuo_tian_kong.h"
-#include "Music_processed/hong_dou.h"
-#include "Music_processed/hou_lai.h"
-#include "Music_processed/kai_shi_dong_le.h"
-#include "Music_processed/lv_se.h"
-#include "Music_processed/qing_hua_ci.h"
-#include "Music_processed/xin_qiang.h"
-#include "Music_processed/you_dian_tian.h"
-#include "Music_processed/chun_jiao_yu_zhi_ming.h"
-#include "Music_processed/Windows.h"
-#include "Music_processed/mi_ren_de_wei_xian.h"
-#include "Music_processed/hong_se_gao_gen_xie.h"
-#include "Music_processed/liang_zhu.h"
-#include "Music_processed/qi_feng_le.h"
-#include "Music_processed/da_hai.h"
-#include "Music_processed/yujian.h"
-#include "Music_processed/Dream_Wedding.h"
-#include "Music_processed/For_Elise.h"
-#include "Music_processed/guo_ji_ge.h"
-#include "Music_processed/Turkish_March.h"
-#include "Music_processed/ye_feng_fei_wu.h"
-#include "Music_processed/bao_wei_huang_he.h"
-#include "Music_processed/bu_zai_you_yu.h"
-#include "Music_processed/Casablanca.h"
-#include "Music_processed/dong_fang_zhi_zhu.h"
-#include "Music_processed/fan_fang_xiang_de_zhong.h"
-#include "Music_processed/ge_chang_zu_guo.h"
-#include "Music_processed/lan_ting_xu.h"
-#include "Music_processed/tong_nian.h"
-#include "Music_processed/wo_shi_yi_zhi_xiao_xiao_niao.h"
-#include "Music_processed/xi_huan_ni.h"
-#include "Music_processed/yi_sheng_you_ni.h"
-#include "Music_processed/zhen_de_ai_ni.h"
 // 音阶频率（Hz）
 #define NOTE_REST 0
 #define NOTE_G3 196
@@ -105,18 +70,8 @@ enum PlayMode {
 
 
 #define DAHAI_TIME_OF_BEAT 714 // 大海节拍时间（ms）
-// Song structure from Buzzer.cpp
-typedef struct {
-  const char* name;
-  const int* melody;
-  const int* durations;
-  int length;
-  int colorSchemeIndex;
-} Song;
-
-// Exposed for watchface hourly chime
-extern const Song songs[] PROGMEM;
-extern const int numSongs;
+// Songs live in the LittleFS music bank (MusicBank.h); song indices below
+// are bank indices.
 extern volatile bool stopBuzzerTask;
 void Buzzer_Task(void *pvParameters);
 void Buzzer_PlayMusic_Task(void *pvParameters);
@@ -9,11 +9,14 @@
 #include "RotaryEncoder.h"
 #include "Alarm.h"
 #include "weather.h"
+#include "TimeSeries.h"
+#include "SensorHub.h"
 // Graph dimensions and position
 #define TEMP_GRAPH_WIDTH  200
 #define TEMP_GRAPH_HEIGHT 135
 #define TEMP_GRAPH_X      20
 #define TEMP_GRAPH_Y      90 
+#define TEMP_GRAPH_DIVS   4
 
 // Temperature display position
 #define TEMP_VALUE_X      20
@@ -32,21 +35,135 @@ DallasTemperature sensors(&oneWire);
 float currentTemperature = -127.0;
 bool stopDS18B20Task = false;
 
-GraphWidget gr = GraphWidget(&tft);
-TraceWidget tr = TraceWidget(&gr);
+ChartWidget tempChart = ChartWidget(&tft);
+static QueueHandle_t chartQueue = NULL; // Hub samples waiting to be plotted
+
+// --- Probe Table ---
+// Written by the update task only. Other tasks read single words and request
+// a resolution through `requested`, which the task compares with `applied`.
+struct Probe {
+    DeviceAddress rom;
+    volatile float temp;
+    volatile uint8_t requested;     // Resolution asked for
+    uint8_t applied;                // Resolution last written to the sensor
+    volatile uint32_t crc_errors;
+};
+
+static Probe probes[DS18B20_MAX_SENSORS];
+static volatile uint8_t probe_count = 0;
+
+enum ConvState {
+    CONV_SCAN,      // Search the bus and cache ROM codes
+    CONV_REQUEST,   // Broadcast a conversion, sleep until it is done
+    CONV_READ,      // Read every cached address
+    CONV_IDLE       // Sleep out the rest of the period
+};
+
+#define DS18B20_MAX_EMPTY_CYCLES  3   // Cycles without any valid read before a rescan
+
+// Runs before the update task starts, then only on the update task.
+static void scanBus() {
+    DeviceAddress rom;
+    uint8_t count = 0;
+
+    probe_count = 0;
+    oneWire.reset_search();
+    while (count < DS18B20_MAX_SENSORS && oneWire.search(rom)) {
+        if (!sensors.validAddress(rom) || !sensors.validFamily(rom)) continue;
+        Probe& p = probes[count];
+        memcpy(p.rom, rom, sizeof(DeviceAddress));
+        p.temp = DEVICE_DISCONNECTED_C;
+        if (p.requested < 9 || p.requested > 12) p.requested = DS18B20_DEFAULT_RESOLUTION;
+        p.applied = 0;
+        p.crc_errors = 0;
+        count++;
+    }
+    probe_count = count;
+    Serial.printf("DS18B20: %d sensor(s) on the bus\n", count);
+}
+
+// Writes changed resolutions and returns the highest one, which sets the wait.
+static uint8_t applyResolutions() {
+    uint8_t slowest = 9;
+    for (uint8_t i = 0; i < probe_count; i++) {
+        Probe& p = probes[i];
+        uint8_t bits = p.requested;
+        if (bits != p.applied && sensors.setResolution(p.rom, bits, true)) {
+            p.applied = bits;
+        }
+        uint8_t wait_bits = p.applied ? p.applied : 12; // Unknown, assume the worst
+        if (wait_bits > slowest) slowest = wait_bits;
+    }
+    return slowest;
+}
+
+// Returns the number of sensors that gave a valid reading.
+static uint8_t readAll() {
+    uint8_t valid = 0;
+    for (uint8_t i = 0; i < probe_count; i++) {
+        Probe& p = probes[i];
+        // Checks the scratchpad CRC; a bad or missing read keeps the last
+        // value here, but the hub is told so its readers can show the error
+        float t = sensors.getTempC(p.rom);
+        if (t == DEVICE_DISCONNECTED_C) {
+            p.crc_errors++;
+            if (i == 0) SensorHub_Publish(SENSOR_DS18B20_TEMP, DEVICE_DISCONNECTED_C);
+            continue;
+        }
+        p.temp = t;
+        valid++;
+        if (i == 0) SensorHub_Publish(SENSOR_DS18B20_TEMP, t);
+    }
+    if (probe_count > 0 && probes[0].temp != DEVICE_DISCONNECTED_C) {
+        currentTemperature = probes[0].temp;
+    }
+    return valid;
+}
 
 void DS18B20_Init() {
   sensors.begin();
+  sensors.setWaitForConversion(false);
+  scanBus();
+  SensorHub_RegisterDriver("ds18b20", DS18B20_PERIOD_MS, NULL); // Publishes from updateTempTask
 }
 
 void updateTempTask(void *pvParameters) {
+    ConvState state = probe_count > 0 ? CONV_REQUEST : CONV_SCAN;
+    TickType_t cycle_start = xTaskGetTickCount();
+    uint8_t empty_cycles = 0;
+
     while(1) {
-        sensors.requestTemperatures();
-        float temp = sensors.getTempCByIndex(0);
-        if (temp != DEVICE_DISCONNECTED_C) {
-            currentTemperature = temp;
+        switch (state) {
+        case CONV_SCAN:
+            scanBus();
+            empty_cycles = 0;
+            if (probe_count == 0) {
+                vTaskDelay(pdMS_TO_TICKS(DS18B20_RESCAN_MS));
+                break;
+            }
+            state = CONV_REQUEST;
+            break;
+
+        case CONV_REQUEST: {
+            cycle_start = xTaskGetTickCount();
+            uint8_t bits = applyResolutions();
+            sensors.requestTemperatures(); // Returns at once, all sensors convert together
+            vTaskDelay(pdMS_TO_TICKS(DallasTemperature::millisToWaitForConversion(bits)));
+            state = CONV_READ;
+            break;
+        }
+
+        case CONV_READ:
+            if (readAll() > 0) empty_cycles = 0;
+            else empty_cycles++;
+            state = (empty_cycles >= DS18B20_MAX_EMPTY_CYCLES) ? CONV_SCAN : CONV_IDLE;
+            break;
+
+        case CONV_IDLE:
+            vTaskDelayUntil(&cycle_start, pdMS_TO_TICKS(DS18B20_PERIOD_MS));
+            state = CONV_REQUEST;
+            break;
         }
-        vTaskDelay(pdMS_TO_TICKS(2000)); // Update every 2 seconds
     }
 }
 
@@ -54,7 +171,7 @@ void createDS18B20Task() {
     xTaskCreate(
         updateTempTask,
         "DS18B20 Update Task",
-        1024,
+        3072,
         NULL,
         1,
         NULL
@@ -65,40 +182,113 @@ float getDS18B20Temp() {
     return currentTemperature;
 }
 
+uint8_t DS18B20_SensorCount() {
+    return probe_count;
+}
+
+float DS18B20_GetTemp(uint8_t index) {
+    if (index >= probe_count) return DEVICE_DISCONNECTED_C;
+    return probes[index].temp;
+}
+
+bool DS18B20_GetAddress(uint8_t index, uint8_t rom[8]) {
+    if (index >= probe_count) return false;
+    memcpy(rom, probes[index].rom, sizeof(DeviceAddress));
+    return true;
+}
+
+bool DS18B20_SetResolution(uint8_t index, uint8_t bits) {
+    if (index >= probe_count || bits < 9 || bits > 12) return false;
+    probes[index].requested = bits;
+    return true;
+}
+
+uint8_t DS18B20_GetResolution(uint8_t index) {
+    if (index >= probe_count) return 0;
+    return probes[index].requested;
+}
+
+uint32_t DS18B20_CrcErrors(uint8_t index) {
+    if (index >= probe_count) return 0;
+    return probes[index].crc_errors;
+}
+
+// Y-axis labels on the chart's grid lines, redrawn when the auto scale changes
+static void drawTempAxis() {
+  uint16_t bg = tft.color565(5, 5, 5);
+  tft.fillRect(0, TEMP_GRAPH_Y - 4, TEMP_GRAPH_X - 1, TEMP_GRAPH_HEIGHT + 8, bg);
+  tft.setTextFont(1);
+  tft.setTextSize(1);
+  tft.setTextDatum(MR_DATUM);
+  tft.setTextColor(TFT_WHITE, bg);
+  float lo = tempChart.getScaleMin(), hi = tempChart.getScaleMax();
+  for (int k = 0; k <= TEMP_GRAPH_DIVS; k++) {
+    float v = lo + (hi - lo) * k / TEMP_GRAPH_DIVS;
+    tft.drawNumber(lroundf(v), TEMP_GRAPH_X - 2, tempChart.getPointY(v));
+  }
+  tft.setTextDatum(TL_DATUM);
+}
+
+// Running stats of the samples in view, under the chart
+static void drawTempStats() {
+  char line[48];
+  snprintf(line, sizeof(line), "Min %.1f  Avg %.1f  Max %.1f",
+           tempChart.getMin(0), tempChart.getAvg(0), tempChart.getMax(0));
+  tft.setTextFont(1);
+  tft.setTextSize(1);
+  tft.setTextDatum(TC_DATUM);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.fillRect(0, STATUS_MESSAGE_Y, tft.width(), 10, TFT_BLACK);
+  tft.drawString(line, tft.width() / 2, STATUS_MESSAGE_Y);
+  tft.setTextDatum(TL_DATUM);
+}
+
+// Runs on the update task: hands the sample to the screen task.
+static void onChartSample(SensorChannel channel, const SensorSample& sample) {
+  xQueueSend(chartQueue, &sample.value, 0); // Full only if the screen stalls; drop it
+}
+
 void DS18B20_Task(void *pvParameters) {
   float lastTemp = -274;
-  float gx = 0.0;
-
-  gr.createGraph(TEMP_GRAPH_WIDTH, TEMP_GRAPH_HEIGHT, tft.color565(5, 5, 5));
-  gr.setGraphScale(0.0, 100.0, 0.0, 40.0); // X-axis 0-100, Y-axis 0-40 (temperature range)
-  gr.setGraphGrid(0.0, 25.0, 0.0, 10.0, TFT_DARKGREY); // Grid every 25 on X, 10 on Y
-  gr.drawGraph(TEMP_GRAPH_X, TEMP_GRAPH_Y);
-  tr.startTrace(TFT_YELLOW);
-
-  // Draw Y-axis labels
-  tft.setTextSize(1); // Set text size for axis labels
-  tft.setTextDatum(MR_DATUM); // Middle-Right datum
-  tft.setTextColor(TFT_WHITE, tft.color565(5, 5, 5)); // Set text color for axis labels
-  tft.drawNumber(40, gr.getPointX(0.0) - 5, gr.getPointY(40.0));
-  tft.drawNumber(30, gr.getPointX(0.0) - 5, gr.getPointY(30.0));
-  tft.drawNumber(20, gr.getPointX(0.0) - 5, gr.getPointY(20.0));
-  tft.drawNumber(10, gr.getPointX(0.0) - 5, gr.getPointY(10.0));
-  tft.drawNumber(0, gr.getPointX(0.0) - 5, gr.getPointY(0.0));
-
-  // Draw X-axis labels
-  tft.setTextDatum(TC_DATUM); // Top-Center datum
-  tft.drawNumber(0, gr.getPointX(0.0), gr.getPointY(0.0) + 5);
-  tft.drawNumber(25, gr.getPointX(25.0), gr.getPointY(0.0) + 5);
-  tft.drawNumber(50, gr.getPointX(50.0), gr.getPointY(0.0) + 5);
-  tft.drawNumber(75, gr.getPointX(75.0), gr.getPointY(0.0) + 5);
-  tft.drawNumber(100, gr.getPointX(100.0), gr.getPointY(0.0) + 5);
+  bool relabel = false;
+
+  // 2 px per reading: the last ~200 s at one reading per DS18B20_PERIOD_MS
+  tempChart.createChart(TEMP_GRAPH_WIDTH, TEMP_GRAPH_HEIGHT, 2, tft.color565(5, 5, 5));
+  tempChart.addSeries(TFT_YELLOW);
+  tempChart.setAutoScale(TEMP_GRAPH_DIVS); // Whole degrees per grid line
+  tempChart.setChartGrid(25, TEMP_GRAPH_DIVS, TFT_DARKGREY);
+
+  // Start with the stored history instead of an empty graph, until live
+  // readings scroll it out. Raw records are TS_RAW_PERIOD_S apart, so they
+  // are interpolated onto the live cadence to keep one x step per reading.
+  const uint32_t span_s = (TEMP_GRAPH_WIDTH / 2) * DS18B20_PERIOD_MS / 1000;
+  TsIterator it;
+  TsRecord rec;
+  uint32_t now = time(nullptr);
+  uint32_t prev_time = 0;
+  float prev = 0;
+  TimeSeries_Query(&it, TS_SERIES_TEMP, 0, now - span_s, now);
+  while (TimeSeries_Next(&it, &rec)) {
+    float v = rec.avg / 10.0f;
+    uint32_t steps = prev_time ? (rec.time - prev_time) * 1000 / DS18B20_PERIOD_MS : 1;
+    for (uint32_t k = 1; k <= steps; k++) tempChart.addPoint(0, prev + (v - prev) * k / steps);
+    prev = v;
+    prev_time = rec.time;
+  }
+  if (tempChart.drawChart(TEMP_GRAPH_X, TEMP_GRAPH_Y)) drawTempAxis();
+
+  // Kept across visits: a publish already in flight may still call back
+  // after the screen unsubscribes
+  if (chartQueue == NULL) chartQueue = xQueueCreate(8, sizeof(float));
+  xQueueReset(chartQueue);
+  SensorHub_Subscribe(onChartSample, SENSOR_MASK(SENSOR_DS18B20_TEMP));
 
   while (1) {
     if (stopDS18B20Task) {
       break;
     }
 
-    float tempC = getDS18B20Temp();
+    float tempC = SensorHub_Value(SENSOR_DS18B20_TEMP, DEVICE_DISCONNECTED_C);
 
     if (tempC != DEVICE_DISCONNECTED_C && tempC > -50 && tempC < 150) {
       tft.fillRect(0, 0, tft.width(), TEMP_GRAPH_Y - 5, TFT_BLACK); // Clear area above graph
@@ -138,16 +328,16 @@ void DS18B20_Task(void *pvParameters) {
       tft.setTextColor(TFT_WHITE, TFT_BLACK); // Ensure text color is white on black background
       tft.drawString(fullTempStr, x_pos, y_pos);
 
-      tr.addPoint(gx, tempC - 0.5);
-      tr.addPoint(gx, tempC);
-      tr.addPoint(gx, tempC + 0.5);
-      gx += 1.0;
-
-      if (gx > 100.0) {
-        gx = 0.0;
-        gr.drawGraph(TEMP_GRAPH_X, TEMP_GRAPH_Y);
-        tr.startTrace(TFT_YELLOW);
+      // The readout refreshes every loop, the chart once per new reading
+      float sample;
+      while (xQueueReceive(chartQueue, &sample, 0) == pdTRUE) {
+        if (sample > DEVICE_DISCONNECTED_C) tempChart.addPoint(0, sample);
+      }
+      if (tempChart.drawChart(TEMP_GRAPH_X, TEMP_GRAPH_Y) || relabel) {
+        drawTempAxis();
+        relabel = false;
       }
+      drawTempStats();
 
       lastTemp = tempC;
     } else {
@@ -158,11 +348,14 @@ void DS18B20_Task(void *pvParameters) {
       tft.setTextSize(2);
       tft.setTextColor(TFT_RED);
       tft.println("Sensor Error!");
+      relabel = true;
     }
 
     vTaskDelay(pdMS_TO_TICKS(500));
   }
 
+  SensorHub_Unsubscribe(onChartSample);
+  tempChart.deleteChart();
   vTaskDelete(NULL);
 }
 
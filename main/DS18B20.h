@@ -1,11 +1,34 @@
 #ifndef __DS18B20_H
 #define __DS18B20_H
 
-extern float currentTemperature;
+#include <Arduino.h>
+
+// Every DS18B20 on the bus is found once at init and addressed by its cached
+// ROM code afterwards. The update task broadcasts one conversion to all of
+// them without waiting, sleeps for the conversion time of the slowest
+// resolution, then reads each scratchpad by address; a read that fails its
+// CRC keeps the previous value, and publishes DEVICE_DISCONNECTED_C to the
+// sensor hub for sensor 0.
+#define DS18B20_MAX_SENSORS          4
+#define DS18B20_DEFAULT_RESOLUTION   12     // Bits, 9-12 (94-750 ms conversion)
+#define DS18B20_PERIOD_MS            2000   // One conversion cycle
+#define DS18B20_RESCAN_MS            30000  // Bus search interval while nothing answers
+
+extern float currentTemperature;   // Sensor 0, kept for existing callers
 
 void DS18B20_Init();
 void createDS18B20Task();
 float getDS18B20Temp();
+
+uint8_t DS18B20_SensorCount();
+// DEVICE_DISCONNECTED_C (-127) until the sensor has given a valid reading.
+float DS18B20_GetTemp(uint8_t index);
+bool DS18B20_GetAddress(uint8_t index, uint8_t rom[8]);
+// Applied by the update task before its next conversion.
+bool DS18B20_SetResolution(uint8_t index, uint8_t bits);
+uint8_t DS18B20_GetResolution(uint8_t index);
+uint32_t DS18B20_CrcErrors(uint8_t index);
+
 void DS18B20Menu();
 
-#endif
\ No newline at end of file
+#endif
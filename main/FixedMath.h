@@ -0,0 +1,260 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include <stdint.h>
+
+// Q16.16 fixed point for the hot paths. The C3 has no FPU, so every float
+// sin/cos/pow is a soft-float libm call; these are integer-only and inline.
+// Angles are a 16-bit fraction of a turn (65536 = 360 degrees), so they wrap
+// for free. sin/cos, atan2 and exp2 read 257-entry tables and interpolate
+// linearly. Largest errors against libm, measured on the host over the full
+// input range by extras/benchmark (below 1.0 the Q16.16 step itself
+// dominates exp2 and pow):
+//   Fix_Sin/Fix_Cos   1.2 LSB (1.8e-5)
+//   Fix_Atan2         1.1 angle units (0.006 degrees)
+//   Fix_Sqrt          exact (floor)
+//   Fix_Log2          1 LSB
+//   Fix_Exp2          1.5e-5 relative
+//   Fix_Pow           5.7e-5 relative for |y| <= 4 while the result stays
+//                     inside Q16.16; about 1e-5 more per unit of |y| beyond
+typedef int32_t fix16_t;
+typedef uint16_t fix_angle_t;
+
+#define FIX_ONE            ((fix16_t)0x00010000)
+#define FIX_HALF           ((fix16_t)0x00008000)
+#define FIX_MAX            ((fix16_t)0x7FFFFFFF)
+#define FIX_MIN            ((fix16_t)0x80000000)
+#define FIX_ANGLE_PER_RAD  10430                    // 65536 / (2 * pi)
+
+// Compile-time conversions for constants; use the functions at run time.
+#define FIX_FROM_INT(i)    ((fix16_t)((i) * 65536))
+#define FIX_FROM_FLOAT(f)  ((fix16_t)((f) >= 0 ? (f) * 65536.0 + 0.5 : (f) * 65536.0 - 0.5))
+#define FIX_DEG(d)         ((fix_angle_t)((int32_t)(d) * 65536 / 360))
+#define FIX_RAD(r)         ((fix_angle_t)(int32_t)((r) * 10430.378350470453))
+
+// --- Tables ---
+// sin over a quarter turn, 256 steps, Q16.16
+inline constexpr int32_t FIX_SIN_LUT[257] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814, 3216, 3617, 4019, 4420,
+    4821, 5222, 5623, 6023, 6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391, 12785, 13180, 13573, 13966,
+    14359, 14751, 15143, 15534, 15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699, 22078, 22457, 22834, 23210,
+    23586, 23961, 24335, 24708, 25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538, 30893, 31248, 31600, 31952,
+    32303, 32652, 33000, 33347, 33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716, 39040, 39362, 39683, 40002,
+    40320, 40636, 40951, 41264, 41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056, 46341, 46624, 46906, 47186,
+    47464, 47741, 48015, 48288, 48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398, 52639, 52878, 53114, 53349,
+    53581, 53812, 54040, 54267, 54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607, 57798, 57986, 58172, 58356,
+    58538, 58718, 58896, 59071, 59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568, 61705, 61839, 61971, 62101,
+    62228, 62353, 62476, 62596, 62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197, 64277, 64354, 64429, 64501,
+    64571, 64639, 64704, 64766, 64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436, 65457, 65476, 65492, 65505,
+    65516, 65525, 65531, 65535, 65536,
+};
+// atan(i / 256) for i = 0..256, in angle units
+inline constexpr uint16_t FIX_ATAN_LUT[257] = {
+    0, 41, 81, 122, 163, 204, 244, 285, 326, 367, 407, 448,
+    489, 529, 570, 610, 651, 692, 732, 773, 813, 854, 894, 935,
+    975, 1015, 1056, 1096, 1136, 1177, 1217, 1257, 1297, 1337, 1377, 1417,
+    1457, 1497, 1537, 1577, 1617, 1656, 1696, 1736, 1775, 1815, 1854, 1894,
+    1933, 1973, 2012, 2051, 2090, 2129, 2168, 2207, 2246, 2285, 2324, 2363,
+    2401, 2440, 2478, 2517, 2555, 2594, 2632, 2670, 2708, 2746, 2784, 2822,
+    2860, 2897, 2935, 2973, 3010, 3047, 3085, 3122, 3159, 3196, 3233, 3270,
+    3307, 3344, 3380, 3417, 3453, 3490, 3526, 3562, 3599, 3635, 3670, 3706,
+    3742, 3778, 3813, 3849, 3884, 3920, 3955, 3990, 4025, 4060, 4095, 4129,
+    4164, 4199, 4233, 4267, 4302, 4336, 4370, 4404, 4438, 4471, 4505, 4539,
+    4572, 4605, 4639, 4672, 4705, 4738, 4771, 4803, 4836, 4869, 4901, 4933,
+    4966, 4998, 5030, 5062, 5094, 5125, 5157, 5188, 5220, 5251, 5282, 5313,
+    5344, 5375, 5406, 5437, 5467, 5498, 5528, 5559, 5589, 5619, 5649, 5679,
+    5708, 5738, 5768, 5797, 5826, 5856, 5885, 5914, 5943, 5972, 6000, 6029,
+    6058, 6086, 6114, 6142, 6171, 6199, 6227, 6254, 6282, 6310, 6337, 6365,
+    6392, 6419, 6446, 6473, 6500, 6527, 6554, 6580, 6607, 6633, 6660, 6686,
+    6712, 6738, 6764, 6790, 6815, 6841, 6867, 6892, 6917, 6943, 6968, 6993,
+    7018, 7043, 7068, 7092, 7117, 7141, 7166, 7190, 7214, 7238, 7262, 7286,
+    7310, 7334, 7358, 7381, 7405, 7428, 7451, 7475, 7498, 7521, 7544, 7566,
+    7589, 7612, 7635, 7657, 7679, 7702, 7724, 7746, 7768, 7790, 7812, 7834,
+    7856, 7877, 7899, 7920, 7942, 7963, 7984, 8005, 8026, 8047, 8068, 8089,
+    8110, 8131, 8151, 8172, 8192,
+};
+// 2^(i / 256) for i = 0..256, Q16.16
+inline constexpr uint32_t FIX_EXP2_LUT[257] = {
+    65536, 65714, 65892, 66071, 66250, 66429, 66609, 66790, 66971, 67153, 67335, 67517,
+    67700, 67884, 68068, 68252, 68438, 68623, 68809, 68996, 69183, 69370, 69558, 69747,
+    69936, 70126, 70316, 70507, 70698, 70889, 71082, 71274, 71468, 71661, 71856, 72050,
+    72246, 72442, 72638, 72835, 73032, 73230, 73429, 73628, 73828, 74028, 74229, 74430,
+    74632, 74834, 75037, 75240, 75444, 75649, 75854, 76060, 76266, 76473, 76680, 76888,
+    77096, 77305, 77515, 77725, 77936, 78147, 78359, 78572, 78785, 78998, 79212, 79427,
+    79642, 79858, 80075, 80292, 80510, 80728, 80947, 81166, 81386, 81607, 81828, 82050,
+    82273, 82496, 82719, 82944, 83169, 83394, 83620, 83847, 84074, 84302, 84531, 84760,
+    84990, 85220, 85451, 85683, 85915, 86148, 86382, 86616, 86851, 87086, 87322, 87559,
+    87796, 88034, 88273, 88513, 88752, 88993, 89234, 89476, 89719, 89962, 90206, 90451,
+    90696, 90942, 91188, 91436, 91684, 91932, 92181, 92431, 92682, 92933, 93185, 93438,
+    93691, 93945, 94200, 94455, 94711, 94968, 95226, 95484, 95743, 96002, 96263, 96524,
+    96785, 97048, 97311, 97575, 97839, 98104, 98370, 98637, 98905, 99173, 99442, 99711,
+    99982, 100253, 100524, 100797, 101070, 101344, 101619, 101895, 102171, 102448, 102726, 103004,
+    103283, 103564, 103844, 104126, 104408, 104691, 104975, 105260, 105545, 105831, 106118, 106406,
+    106694, 106984, 107274, 107565, 107856, 108149, 108442, 108736, 109031, 109326, 109623, 109920,
+    110218, 110517, 110816, 111117, 111418, 111720, 112023, 112327, 112631, 112937, 113243, 113550,
+    113858, 114167, 114476, 114787, 115098, 115410, 115723, 116036, 116351, 116667, 116983, 117300,
+    117618, 117937, 118257, 118577, 118899, 119221, 119544, 119869, 120194, 120519, 120846, 121174,
+    121502, 121832, 122162, 122493, 122825, 123158, 123492, 123827, 124163, 124500, 124837, 125176,
+    125515, 125855, 126197, 126539, 126882, 127226, 127571, 127917, 128263, 128611, 128960, 129310,
+    129660, 130012, 130364, 130718, 131072,
+};
+
+// --- Conversions and Arithmetic ---
+static inline fix16_t Fix_FromInt(int32_t i) { return i * FIX_ONE; }
+static inline int32_t Fix_ToInt(fix16_t x) { return (x + FIX_HALF) >> 16; }     // Rounded
+static inline int32_t Fix_Floor(fix16_t x) { return x >> 16; }
+static inline float Fix_ToFloat(fix16_t x) { return x * (1.0f / 65536.0f); }
+static inline fix16_t Fix_FromFloat(float f) { return (fix16_t)(f * 65536.0f + (f >= 0 ? 0.5f : -0.5f)); }
+
+static inline fix16_t Fix_Mul(fix16_t a, fix16_t b) {
+    return (fix16_t)(((int64_t)a * b + FIX_HALF) >> 16);
+}
+
+static inline fix16_t Fix_Div(fix16_t a, fix16_t b) {
+    if (b == 0) return (a >= 0) ? FIX_MAX : FIX_MIN;
+    return (fix16_t)(((int64_t)a << 16) / b);
+}
+
+// a + (b - a) * t for integers, t in 0..FIX_ONE (or beyond, for overshoot).
+static inline int32_t Fix_Lerp(int32_t a, int32_t b, fix16_t t) {
+    return a + (int32_t)(((int64_t)(b - a) * t + FIX_HALF) >> 16);
+}
+
+// --- Trigonometry ---
+static inline fix_angle_t Fix_AngleFromRad(fix16_t rad) {
+    return (fix_angle_t)(((int64_t)rad * 683565276) >> 32);
+}
+
+static inline fix16_t Fix_Sin(fix_angle_t angle) {
+    uint32_t quadrant = angle >> 14;
+    uint32_t pos = angle & 0x3FFF;
+    if (quadrant & 1) pos = 0x4000 - pos;
+    uint32_t idx = pos >> 6;
+    uint32_t frac = pos & 0x3F;
+    int32_t v = FIX_SIN_LUT[idx];
+    if (frac) v += ((FIX_SIN_LUT[idx + 1] - v) * (int32_t)frac + 32) >> 6;
+    return (quadrant & 2) ? -v : v;
+}
+
+static inline fix16_t Fix_Cos(fix_angle_t angle) {
+    return Fix_Sin((fix_angle_t)(angle + 0x4000));
+}
+
+// Angle of (x, y) from the +x axis. x and y may be in any common unit.
+static inline fix_angle_t Fix_Atan2(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) return 0;
+    uint32_t ax = (x < 0) ? -(uint32_t)x : (uint32_t)x;
+    uint32_t ay = (y < 0) ? -(uint32_t)y : (uint32_t)y;
+    bool steep = ay > ax;
+    uint32_t num = steep ? ax : ay;
+    uint32_t den = steep ? ay : ax;
+    while (den > 0xFFFF) { num >>= 1; den >>= 1; }   // Keeps the ratio in 32 bits
+
+    uint32_t ratio = (num << 16) / den;              // 0..65536
+    uint32_t idx = ratio >> 8;
+    uint32_t frac = ratio & 0xFF;
+    uint32_t a = FIX_ATAN_LUT[idx];
+    if (frac) a += ((FIX_ATAN_LUT[idx + 1] - a) * frac + 128) >> 8;
+
+    if (steep) a = 0x4000 - a;
+    if (x < 0) a = 0x8000 - a;
+    if (y < 0) a = 0x10000 - a;
+    return (fix_angle_t)a;
+}
+
+// --- Roots, Logarithms and Powers ---
+static inline uint32_t Fix_Isqrt(uint64_t x) {
+    uint64_t result = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+        if (x >= result + bit) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+static inline fix16_t Fix_Sqrt(fix16_t x) {
+    return (x <= 0) ? 0 : (fix16_t)Fix_Isqrt((uint64_t)x << 16);
+}
+
+// FIX_MIN for x <= 0.
+static inline fix16_t Fix_Log2(fix16_t x) {
+    if (x <= 0) return FIX_MIN;
+    // Normalise to [1, 2) in Q2.30, then one result bit per squaring
+    int32_t lead = __builtin_clz((uint32_t)x);
+    uint32_t v = (uint32_t)x << (lead - 1);
+    fix16_t result = (15 - lead) * FIX_ONE;
+    for (fix16_t bit = FIX_HALF; bit > 0; bit >>= 1) {
+        v = (uint32_t)(((uint64_t)v * v) >> 30);
+        if (v >= 0x80000000u) {
+            v >>= 1;
+            result += bit;
+        }
+    }
+    return result;
+}
+
+// Saturates at FIX_MAX.
+static inline fix16_t Fix_Exp2(fix16_t x) {
+    int32_t ip = x >> 16;
+    if (ip >= 15) return FIX_MAX;
+    if (ip < -17) return 0;
+    uint32_t f = x & 0xFFFF;
+    uint32_t idx = f >> 8;
+    uint32_t frac = f & 0xFF;
+    uint32_t m = FIX_EXP2_LUT[idx];
+    if (frac) m += ((FIX_EXP2_LUT[idx + 1] - m) * frac + 128) >> 8;
+    if (ip >= 0) return (fix16_t)(m << ip);
+    return (fix16_t)((m + ((1u << -ip) >> 1)) >> -ip);
+}
+
+// x^y for x > 0, 0 otherwise.
+static inline fix16_t Fix_Pow(fix16_t x, fix16_t y) {
+    if (x <= 0) return 0;
+    int64_t e = ((int64_t)y * Fix_Log2(x) + FIX_HALF) >> 16;
+    if (e >= 15 * (int64_t)FIX_ONE) return FIX_MAX;
+    if (e < -17 * (int64_t)FIX_ONE) return 0;
+    return Fix_Exp2((fix16_t)e);
+}
+
+// --- Easing, t in 0..FIX_ONE ---
+static inline fix16_t Fix_EaseOutQuad(fix16_t t) {
+    fix16_t u = FIX_ONE - t;
+    return FIX_ONE - Fix_Mul(u, u);
+}
+
+static inline fix16_t Fix_EaseOutCubic(fix16_t t) {
+    fix16_t u = FIX_ONE - t;
+    return FIX_ONE - Fix_Mul(Fix_Mul(u, u), u);
+}
+
+// Overshoots by about 10% before settling.
+static inline fix16_t Fix_EaseOutBack(fix16_t t) {
+    const fix16_t c1 = FIX_FROM_FLOAT(1.70158);
+    const fix16_t c3 = c1 + FIX_ONE;
+    fix16_t u = t - FIX_ONE;
+    fix16_t u2 = Fix_Mul(u, u);
+    return FIX_ONE + Fix_Mul(c3, Fix_Mul(u2, u)) + Fix_Mul(c1, u2);
+}
+
+static inline fix16_t Fix_SmoothStep(fix16_t t) {
+    return Fix_Mul(Fix_Mul(t, t), 3 * FIX_ONE - 2 * t);
+}
+
+#endif // FIXED_MATH_H
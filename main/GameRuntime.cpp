@@ -0,0 +1,276 @@
+#include "GameRuntime.h"
+#include "RotaryEncoder.h"
+#include "Menu.h"
+#include "MQTT.h"
+#include "Alarm.h"
+
+// --- Input Queue ---
+static GameInput events[GAME_MAX_EVENTS];
+static uint8_t event_head = 0;
+static uint8_t event_count = 0;
+static uint32_t last_click_ms = 0;
+static uint32_t press_start_ms = 0;
+
+// --- Dirty Rects (this frame, and the last one still on screen) ---
+static GameRect dirty[GAME_MAX_DIRTY];
+static uint8_t dirty_count = 0;
+static GameRect shown[GAME_MAX_DIRTY];
+static uint8_t shown_count = 0;
+static bool all_dirty = true;
+static bool repaint = true;     // The sprite was drawn over: the next render is full
+
+static uint32_t steps = 0;
+static bool quit = false;
+
+// =====================================================================================
+//                                       INPUT
+// =====================================================================================
+
+static void pushEvent(GameInputType type, int8_t delta) {
+    if (event_count >= GAME_MAX_EVENTS) return; // Update fell behind, drop the newest
+    GameInput& e = events[(event_head + event_count) % GAME_MAX_EVENTS];
+    e.type = type;
+    e.delta = delta;
+    e.time_ms = millis();
+    event_count++;
+}
+
+static void pollInput() {
+    if (exitSubMenu) {
+        exitSubMenu = false;
+        quit = true;
+        return;
+    }
+    if (g_alarm_is_ringing || readButtonLongPress()) {
+        quit = true;
+        return;
+    }
+
+    int direction = readEncoder();
+    if (direction != 0) pushEvent(GAME_INPUT_TURN, direction);
+
+    if (readButton()) {
+        uint32_t now = millis();
+        if (last_click_ms != 0 && now - last_click_ms < GAME_DOUBLE_CLICK_MS) {
+            quit = true;
+            return;
+        }
+        last_click_ms = now;
+        pushEvent(GAME_INPUT_CLICK, 0);
+    }
+
+    // The long-press bar is drawn straight into the sprite and cleared to
+    // black on release; have the game repaint once it may have been shown.
+    bool down = digitalRead(ENCODER_SW) == LOW;
+    if (down && press_start_ms == 0) {
+        press_start_ms = millis() | 1;
+    } else if (!down && press_start_ms != 0) {
+        if (millis() - press_start_ms >= LONG_PRESS_BAR_MS) repaint = true;
+        press_start_ms = 0;
+    }
+}
+
+bool Game_NextInput(GameInput* input) {
+    if (event_count == 0) return false;
+    *input = events[event_head];
+    event_head = (event_head + 1) % GAME_MAX_EVENTS;
+    event_count--;
+    return true;
+}
+
+// =====================================================================================
+//                                    DIRTY RECTS
+// =====================================================================================
+
+void Game_MarkDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    GameRect r = { x, y, w, h };
+    Game_MarkDirty(r);
+}
+
+void Game_MarkDirty(const GameRect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    if (dirty_count == GAME_MAX_DIRTY) {
+        for (uint8_t i = 1; i < dirty_count; i++) dirty[0] = Game_Union(dirty[0], dirty[i]);
+        dirty_count = 1;
+    }
+    dirty[dirty_count++] = rect;
+}
+
+void Game_MarkAllDirty() {
+    all_dirty = true;
+}
+
+// Pushes this frame's rects and last frame's, overlapping ones merged.
+static void pushDirty(TFT_eSprite& sprite) {
+    if (all_dirty) {
+        sprite.pushSprite(0, 0);
+        all_dirty = false;
+    } else {
+        GameRect rects[GAME_MAX_DIRTY * 2];
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < shown_count; i++) rects[count++] = shown[i];
+        for (uint8_t i = 0; i < dirty_count; i++) rects[count++] = dirty[i];
+
+        // A moving object's old and new rects usually overlap: push them as one
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (uint8_t i = 0; i < count && !merged; i++) {
+                for (uint8_t j = i + 1; j < count; j++) {
+                    if (!Game_Overlap(rects[i], rects[j])) continue;
+                    rects[i] = Game_Union(rects[i], rects[j]);
+                    rects[j] = rects[--count];
+                    merged = true; // The grown rect may now touch earlier ones
+                    break;
+                }
+            }
+        }
+
+        int16_t sw = sprite.width(), sh = sprite.height();
+        for (uint8_t i = 0; i < count; i++) {
+            int16_t x0 = max<int16_t>(rects[i].x, 0);
+            int16_t y0 = max<int16_t>(rects[i].y, 0);
+            int16_t x1 = min<int16_t>(rects[i].x + rects[i].w, sw);
+            int16_t y1 = min<int16_t>(rects[i].y + rects[i].h, sh);
+            if (x1 > x0 && y1 > y0) sprite.pushSprite(x0, y0, x0, y0, x1 - x0, y1 - y0);
+        }
+    }
+
+    memcpy(shown, dirty, dirty_count * sizeof(GameRect));
+    shown_count = dirty_count;
+    dirty_count = 0;
+}
+
+// =====================================================================================
+//                                     MAIN LOOP
+// =====================================================================================
+
+uint32_t Game_Steps() {
+    return steps;
+}
+
+void Game_Run(const GameDef& game) {
+    uint16_t step_ms = game.step_ms ? game.step_ms : 1;
+    uint16_t frame_ms = game.frame_ms ? game.frame_ms : step_ms;
+
+    event_head = event_count = 0;
+    dirty_count = shown_count = 0;
+    all_dirty = true;
+    repaint = true;
+    steps = 0;
+    quit = false;
+    last_click_ms = 0;
+    press_start_ms = 0;
+
+    if (game.start) game.start();
+
+    uint32_t last_ms = millis();
+    uint32_t next_frame_ms = last_ms;
+    uint32_t accumulator = 0;
+
+    while (true) {
+        pollInput();
+        if (quit) break;
+
+        uint32_t now = millis();
+        accumulator += now - last_ms;
+        last_ms = now;
+        for (uint8_t n = 0; accumulator >= step_ms; n++) {
+            if (n == GAME_MAX_CATCHUP) { // Too far behind: slow down instead of spiralling
+                accumulator = 0;
+                break;
+            }
+            game.update();
+            steps++;
+            accumulator -= step_ms;
+        }
+
+        fix16_t alpha = (fix16_t)(((uint32_t)accumulator << 16) / step_ms);
+        bool full = repaint;
+        repaint = false;
+        game.render(menuSprite, alpha, full);
+        if (full) all_dirty = true;
+        pushDirty(menuSprite);
+
+        // Sleep out the frame, still polling so no click or detent is missed
+        next_frame_ms += frame_ms;
+        if ((int32_t)(millis() - next_frame_ms) > (int32_t)frame_ms) next_frame_ms = millis();
+        do {
+            int32_t left = (int32_t)(next_frame_ms - millis());
+            vTaskDelay(pdMS_TO_TICKS(constrain(left, 1, GAME_INPUT_POLL_MS)));
+            pollInput();
+        } while (!quit && (int32_t)(next_frame_ms - millis()) > 0);
+        if (quit) break;
+    }
+
+    if (game.stop) game.stop();
+}
+
+// =====================================================================================
+//                                   ENTITY POOLS
+// =====================================================================================
+
+void GamePool_Clear(GamePool& pool) {
+    memset(pool.items, 0, pool.capacity * sizeof(GameEntity));
+}
+
+GameEntity* GamePool_Spawn(GamePool& pool) {
+    for (uint8_t i = 0; i < pool.capacity; i++) {
+        GameEntity* e = &pool.items[i];
+        if (e->active) continue;
+        memset(e, 0, sizeof(GameEntity));
+        e->active = true;
+        return e;
+    }
+    return NULL;
+}
+
+uint8_t GamePool_Count(const GamePool& pool) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < pool.capacity; i++) count += pool.items[i].active;
+    return count;
+}
+
+void GameEntity_Place(GameEntity* e, int16_t x, int16_t y) {
+    e->x = e->prev_x = Fix_FromInt(x);
+    e->y = e->prev_y = Fix_FromInt(y);
+}
+
+void GameEntity_Move(GameEntity* e) {
+    e->prev_x = e->x;
+    e->prev_y = e->y;
+    e->x += e->vx;
+    e->y += e->vy;
+}
+
+int16_t GameEntity_DrawX(const GameEntity* e, fix16_t alpha) {
+    return Fix_Floor(e->prev_x + Fix_Mul(e->x - e->prev_x, alpha));
+}
+
+int16_t GameEntity_DrawY(const GameEntity* e, fix16_t alpha) {
+    return Fix_Floor(e->prev_y + Fix_Mul(e->y - e->prev_y, alpha));
+}
+
+GameRect GameEntity_Rect(const GameEntity* e) {
+    GameRect r = { (int16_t)Fix_Floor(e->x), (int16_t)Fix_Floor(e->y), e->w, e->h };
+    return r;
+}
+
+// =====================================================================================
+//                                     COLLISION
+// =====================================================================================
+
+bool Game_Overlap(const GameRect& a, const GameRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+bool Game_Contains(const GameRect& r, int16_t x, int16_t y) {
+    return x >= r.x && x < r.x + r.w && y >= r.y && y < r.y + r.h;
+}
+
+GameRect Game_Union(const GameRect& a, const GameRect& b) {
+    int16_t x0 = min(a.x, b.x), y0 = min(a.y, b.y);
+    int16_t x1 = max(a.x + a.w, b.x + b.w), y1 = max(a.y + a.h, b.y + b.h);
+    GameRect r = { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+    return r;
+}
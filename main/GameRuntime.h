@@ -0,0 +1,102 @@
+#ifndef GAME_RUNTIME_H
+#define GAME_RUNTIME_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "FixedMath.h"
+
+// Shared loop for the games. Game_Run owns the timing, the input and the
+// screen: it steps the game at a fixed rate whatever the frame time (with a
+// cap on catch-up steps), renders into the shared menuSprite back buffer
+// with the fraction of a step left over for interpolation, and pushes only
+// the rectangles the game marked dirty this frame and the last one, so what
+// moved away gets cleared too. Button and encoder are polled between frames
+// into an event queue that the update step drains.
+//
+// A double click, a long press, exitSubMenu or a ringing alarm ends the game;
+// games never see those.
+#define GAME_MAX_EVENTS     16
+#define GAME_MAX_DIRTY      8      // Rects per frame, more merge into one
+#define GAME_MAX_CATCHUP    4      // Steps per frame before time is dropped
+#define GAME_INPUT_POLL_MS  5
+#define GAME_DOUBLE_CLICK_MS 500
+
+enum GameInputType : uint8_t {
+    GAME_INPUT_TURN = 0,        // Encoder detent, delta is +1 or -1
+    GAME_INPUT_CLICK,           // Short press, reported on release
+};
+
+struct GameInput {
+    GameInputType type;
+    int8_t delta;
+    uint32_t time_ms;           // millis() when it was polled
+};
+
+struct GameRect {
+    int16_t x, y, w, h;
+};
+
+// Callbacks and rates of one game. `render` repaints the frame into the
+// sprite; `alpha` (0..FIX_ONE) is how far time is past the last step. `full`
+// is set on the first frame and after the sprite was drawn over (the
+// long-press bar): a game that only draws what changed must redraw it all.
+struct GameDef {
+    uint16_t step_ms;
+    uint16_t frame_ms;          // Render period, at most step_ms to use alpha
+    void (*start)();
+    void (*update)();
+    void (*render)(TFT_eSprite& sprite, fix16_t alpha, bool full);
+    void (*stop)();             // May be NULL
+};
+
+// Runs the game until it is left. The first frame is pushed whole.
+void Game_Run(const GameDef& game);
+
+// --- Called from the callbacks ---
+bool Game_NextInput(GameInput* input);
+uint32_t Game_Steps();          // Update steps since start
+void Game_MarkDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+void Game_MarkDirty(const GameRect& rect);
+void Game_MarkAllDirty();
+
+// --- Entity Pools ---
+// Fixed arrays of entities owned by a game; free slots are inactive.
+// Positions and velocities are Q16.16 pixels and pixels per step.
+struct GameEntity {
+    fix16_t x, y;
+    fix16_t vx, vy;
+    fix16_t prev_x, prev_y;     // Position before the last move, for interpolation
+    int16_t w, h;
+    int16_t value;              // Free for the game (lane, colour, score...)
+    bool active;
+};
+
+struct GamePool {
+    GameEntity* items;
+    uint8_t capacity;
+};
+
+#define GAME_POOL(name, size) \
+    static GameEntity name##_items[size]; \
+    static GamePool name = { name##_items, size }
+
+void GamePool_Clear(GamePool& pool);
+// Returns a zeroed active entity, or NULL when the pool is full.
+GameEntity* GamePool_Spawn(GamePool& pool);
+uint8_t GamePool_Count(const GamePool& pool);
+
+// Places an entity without interpolating from its old position.
+void GameEntity_Place(GameEntity* e, int16_t x, int16_t y);
+// prev = position, position += velocity.
+void GameEntity_Move(GameEntity* e);
+// Interpolated top-left corner for drawing.
+int16_t GameEntity_DrawX(const GameEntity* e, fix16_t alpha);
+int16_t GameEntity_DrawY(const GameEntity* e, fix16_t alpha);
+GameRect GameEntity_Rect(const GameEntity* e);
+
+// --- Collision ---
+bool Game_Overlap(const GameRect& a, const GameRect& b);
+bool Game_Contains(const GameRect& r, int16_t x, int16_t y);
+GameRect Game_Union(const GameRect& a, const GameRect& b);
+
+#endif // GAME_RUNTIME_H
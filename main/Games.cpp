@@ -12,35 +12,9 @@
 #include "Games.h"
 #include "Alarm.h"
 #include "MQTT.h"
-#include <vector> // For std::vector
-
-
-// Snake Game Constants
-#define SNAKE_GRID_WIDTH  20
-#define SNAKE_GRID_HEIGHT 20
-#define SNAKE_CELL_SIZE   10 // Pixels per cell
-#define SNAKE_START_X     (SCREEN_WIDTH / 2 - (SNAKE_GRID_WIDTH * SNAKE_CELL_SIZE) / 2)
-#define SNAKE_START_Y     (SCREEN_HEIGHT / 2 - (SNAKE_GRID_HEIGHT * SNAKE_CELL_SIZE) / 2)
-#define SNAKE_INITIAL_LENGTH 3
-#define SNAKE_GAME_SPEED_MS 200 // Milliseconds per frame
-
-enum SnakeDirection {
-  SNAKE_UP,
-  SNAKE_DOWN,
-  SNAKE_LEFT,
-  SNAKE_RIGHT
-};
-
-struct Point {
-  int x;
-  int y;
-};
+#include "FixedMath.h"
+#include "GameRuntime.h"
 
-std::vector<Point> snakeBody;
-Point food;
-SnakeDirection currentDirection;
-bool gameOver;
-int snakeScore;
 
 // --- Layout Configuration ---
 static const int ICON_SIZE = 200;
@@ -81,29 +55,6 @@ bool gamesDetectDoubleClick(bool reset = false) {
   return false;
 }
 
-// --- Button Debouncing Variables ---
-static unsigned long lastButtonDebounceTime = 0;
-static int lastDebouncedButtonState = HIGH; // HIGH = not pressed, LOW = pressed
-const int BUTTON_DEBOUNCE_DELAY = 50; // ms
-
-#define ENCODER_SW 25 // Button pin, copied from RotaryEncoder.cpp
-
-// Function to get debounced button state (true if button is currently pressed and debounced)
-bool getDebouncedButtonState() {
-    int reading = digitalRead(ENCODER_SW); // Raw button read
-
-    if (reading != lastDebouncedButtonState) {
-        lastButtonDebounceTime = millis();
-    }
-
-    if ((millis() - lastButtonDebounceTime) > BUTTON_DEBOUNCE_DELAY) {
-        if (reading != lastDebouncedButtonState) { // State has settled
-            lastDebouncedButtonState = reading;
-        }
-    }
-    return (lastDebouncedButtonState == LOW); // Return true if button is pressed
-}
-
 // --- Menu Definition ---
 struct GameItem {
     const char *name;
@@ -188,10 +139,10 @@ void GamesMenu() {
 
             int16_t start_display = game_display; // Capture the starting position
             for (uint8_t i = 0; i <= ANIMATION_STEPS; i++) { // Loop from 0 to ANIMATION_STEPS
-                float t = (float)i / ANIMATION_STEPS; // Progress from 0.0 to 1.0
-                float eased_t = easeOutQuad(t); // Apply easing
+                fix16_t t = FIX_ONE * i / ANIMATION_STEPS; // Progress from 0 to 1
+                fix16_t eased_t = Fix_EaseOutQuad(t); // Apply easing
 
-                game_display = start_display + (target_display - start_display) * eased_t; // Calculate interpolated position
+                game_display = Fix_Lerp(start_display, target_display, eased_t); // Calculate interpolated position
 
                 drawGameIcons(game_display);
                 vTaskDelay(pdMS_TO_TICKS(15)); // Keep delay for now
@@ -230,383 +181,452 @@ void GamesMenu() {
 }
 
 // --- Breakout Game Implementation ---
-#define PLATFORM_WIDTH  12
-#define PLATFORM_HEIGHT 4
-#define UPT_MOVE_NONE   0
-#define UPT_MOVE_RIGHT  1
-#define UPT_MOVE_LEFT   2
-#define BLOCK_COLS      32
+#define BREAKOUT_STEP_MS 16
+#define BLOCK_COLS      12
 #define BLOCK_ROWS      5
 #define BLOCK_COUNT     (BLOCK_COLS * BLOCK_ROWS)
-
-typedef struct {
-    float x;
-    float y;
-    float velX;
-    float velY;
-} s_ball;
-
-// Placeholder bitmaps (replace with actual ones if available in img.h or define new ones)
-// For simplicity, using simple 1-bit bitmaps as uint16_t arrays for pushImage
-const uint16_t block_bitmap[] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF}; // Example 8x8 white block
-const uint16_t platform_bitmap[] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF}; // Example 16x8 white platform
-const uint16_t ball_bitmap[] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF}; // Example 2x2 white ball
-
-static uint8_t uptMove;
-static s_ball ball;
-static bool* blocks;
+#define BLOCK_W         (SCREEN_WIDTH / BLOCK_COLS)
+#define BLOCK_H         8
+#define BLOCK_TOP       24
+#define PLATFORM_WIDTH  40
+#define PLATFORM_HEIGHT 5
+#define PLATFORM_Y      (SCREEN_HEIGHT - 14)
+#define PLATFORM_STEP   12 // Pixels per encoder detent
+#define BALL_SIZE       4
+#define BALL_SPEED      FIX_FROM_FLOAT(2.5) // Pixels per step
+#define BREAKOUT_HUD_H  12
+
+static const uint16_t blockRowColors[BLOCK_ROWS] = {TFT_RED, TFT_ORANGE, TFT_YELLOW, TFT_GREEN, TFT_CYAN};
+
+GAME_POOL(blocks, BLOCK_COUNT);
+static GameEntity ball;
+static GameEntity platform;
 static uint8_t lives;
 static uint32_t score;
-static uint8_t platformX;
 
-// Helper function to draw bitmaps (adapting from original draw_bitmap)
-void draw_game_bitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h) {
-    menuSprite.pushImage(x, y, w, h, bitmap);
+static void breakoutServe() {
+    GameEntity_Place(&ball, Fix_Floor(platform.x) + (PLATFORM_WIDTH - BALL_SIZE) / 2, PLATFORM_Y - BALL_SIZE - 1);
+    ball.vx = (random(2) ? BALL_SPEED : -BALL_SPEED) / 2;
+    ball.vy = -BALL_SPEED;
 }
 
-// Helper function to draw strings (adapting from original draw_string)
-void draw_game_string(const char *str, int16_t x, int16_t y) {
-    menuSprite.drawString(str, x, y);
-}
+static void breakoutStart() {
+    GamePool_Clear(blocks);
+    for (uint8_t row = 0; row < BLOCK_ROWS; row++) {
+        for (uint8_t col = 0; col < BLOCK_COLS; col++) {
+            GameEntity* block = GamePool_Spawn(blocks);
+            GameEntity_Place(block, col * BLOCK_W, BLOCK_TOP + row * BLOCK_H);
+            block->w = BLOCK_W;
+            block->h = BLOCK_H;
+            block->value = row;
+        }
+    }
 
-// Game draw function
-void breakout_draw() {
-    bool gameEnded = ((score >= BLOCK_COUNT) || (lives == 255));
+    platform.w = PLATFORM_WIDTH;
+    platform.h = PLATFORM_HEIGHT;
+    GameEntity_Place(&platform, (SCREEN_WIDTH - PLATFORM_WIDTH) / 2, PLATFORM_Y);
+    ball.w = ball.h = BALL_SIZE;
+    lives = 3;
+    score = 0;
+    breakoutServe();
+}
 
-    uint8_t platformXtmp = platformX;
+static void breakoutUpdate() {
+    bool gameEnded = (score >= BLOCK_COUNT) || (lives == 0);
 
     // Move platform
-    if (uptMove == UPT_MOVE_RIGHT)
-        platformXtmp += 3;
-    else if (uptMove == UPT_MOVE_LEFT)
-        platformXtmp -= 3;
-    uptMove = UPT_MOVE_NONE;
-
-    // Make sure platform stays on screen
-    if (platformXtmp > 250) // Original code had > 250, which is likely an overflow check. Assuming 0-240 range.
-        platformXtmp = 0;
-    else if (platformXtmp > SCREEN_WIDTH - PLATFORM_WIDTH)
-        platformXtmp = SCREEN_WIDTH - PLATFORM_WIDTH;
-
-    // Draw platform
-    draw_game_bitmap(platformXtmp, SCREEN_HEIGHT - 8, platform_bitmap, PLATFORM_WIDTH, 8);
-
-    platformX = platformXtmp;
+    platform.prev_x = platform.x;
+    GameInput input;
+    while (Game_NextInput(&input)) {
+        if (input.type == GAME_INPUT_CLICK && gameEnded) {
+            breakoutStart();
+            Game_MarkAllDirty();
+            return;
+        }
+        if (input.type == GAME_INPUT_TURN && !gameEnded) {
+            int16_t x = Fix_Floor(platform.x) + input.delta * PLATFORM_STEP;
+            platform.x = Fix_FromInt(constrain(x, 0, SCREEN_WIDTH - PLATFORM_WIDTH));
+        }
+    }
+    if (gameEnded) {
+        GameEntity_Place(&ball, Fix_Floor(ball.x), Fix_Floor(ball.y));
+        return;
+    }
 
     // Move ball
-    if (!gameEnded) {
-        ball.x += ball.velX;
-        ball.y += ball.velY;
-    }
+    GameEntity_Move(&ball);
 
-    bool blockCollide = false;
-    const float ballX = ball.x;
-    const uint8_t ballY = ball.y;
-
-    // Block collision
-    uint32_t idx = 0;
-    for (uint8_t x = 0; x < BLOCK_COLS; x++) {
-        for (uint8_t y = 0; y < BLOCK_ROWS; y++) {
-            if (!blocks[idx] && ballX >= x * 4 && ballX < (x * 4) + 4 && ballY >= (y * 4) + 8 && ballY < (y * 4) + 8 + 4) {
-                tone(BUZZER_PIN, 2000, 50); // Equivalent to buzzer_buzz(100, TONE_2KHZ, ...)
-                // led_flash(LED_GREEN, 50, 255); // No direct equivalent, maybe toggle LED0
-                blocks[idx] = true;
-                blockCollide = true;
-                score++;
-            }
-            idx++;
-        }
+    // Side and top wall collision
+    if (ball.x < 0) {
+        ball.x = 0;
+        ball.vx = abs(ball.vx);
+    } else if (ball.x > Fix_FromInt(SCREEN_WIDTH - BALL_SIZE)) {
+        ball.x = Fix_FromInt(SCREEN_WIDTH - BALL_SIZE);
+        ball.vx = -abs(ball.vx);
     }
-
-    // Side wall collision
-    if (ballX > SCREEN_WIDTH - 2) {
-        if (ballX > 240) // Original overflow check
-            ball.x = 0;
-        else
-            ball.x = SCREEN_WIDTH - 2;
-        ball.velX = -ball.velX;
+    if (ball.y < Fix_FromInt(BREAKOUT_HUD_H)) {
+        ball.y = Fix_FromInt(BREAKOUT_HUD_H);
+        ball.vy = abs(ball.vy);
     }
-    if (ballX < 0) {
-        ball.x = 0;
-        ball.velX = -ball.velX;
+
+    // Block collision: one block per step
+    GameRect ballRect = GameEntity_Rect(&ball);
+    for (uint8_t i = 0; i < blocks.capacity; i++) {
+        GameEntity* block = &blocks.items[i];
+        if (!block->active) continue;
+        GameRect blockRect = GameEntity_Rect(block);
+        if (!Game_Overlap(ballRect, blockRect)) continue;
+
+        block->active = false;
+        Game_MarkDirty(blockRect);
+        score++;
+        tone(BUZZER_PIN, 2000, 50);
+
+        // Came in from the side if it did not overlap horizontally a step ago
+        int16_t prevX = Fix_Floor(ball.prev_x);
+        if (prevX + BALL_SIZE <= blockRect.x || prevX >= blockRect.x + blockRect.w) ball.vx = -ball.vx;
+        else ball.vy = -ball.vy;
+        break;
     }
 
-    // Platform collision
-    bool platformCollision = false;
-    if (!gameEnded && ballY >= SCREEN_HEIGHT - PLATFORM_HEIGHT && ballY < 240 && ballX >= platformX && ballX <= platformX + PLATFORM_WIDTH) {
-        platformCollision = true;
-        tone(BUZZER_PIN, 5000, 200); // Equivalent to buzzer_buzz(200, TONE_5KHZ, ...)
-        ball.y = SCREEN_HEIGHT - PLATFORM_HEIGHT;
-        if (ball.velY > 0)
-            ball.velY = -ball.velY;
-        ball.velX = ((float)random(0, RAND_MAX) / (RAND_MAX / 2.0)) - 1.0; // -1.0 to 1.0
+    // Platform collision: the hit point sets the angle
+    GameRect platformRect = GameEntity_Rect(&platform);
+    if (ball.vy > 0 && Game_Overlap(ballRect, platformRect)) {
+        tone(BUZZER_PIN, 5000, 20);
+        ball.y = Fix_FromInt(PLATFORM_Y - BALL_SIZE);
+        ball.vy = -ball.vy;
+        int32_t offset = (ballRect.x + BALL_SIZE / 2) - (platformRect.x + PLATFORM_WIDTH / 2);
+        ball.vx = BALL_SPEED * offset / (PLATFORM_WIDTH / 2);
     }
 
-    // Top/bottom wall collision
-    if (!gameEnded && !platformCollision && (ballY > SCREEN_HEIGHT - 2 || blockCollide)) {
-        if (ballY > 240) { // Original overflow check
-            tone(BUZZER_PIN, 2500, 200); // Equivalent to buzzer_buzz(200, TONE_2_5KHZ, ...)
-            ball.y = 0;
-        } else if (!blockCollide) {
-            tone(BUZZER_PIN, 2000, 200); // Equivalent to buzzer_buzz(200, TONE_2KHZ, ...)
-            ball.y = SCREEN_HEIGHT - 1;
-            lives--;
-        }
-        ball.velY *= -1;
+    // Bottom: lose a life
+    if (ball.y >= Fix_FromInt(SCREEN_HEIGHT)) {
+        tone(BUZZER_PIN, 2000, 200);
+        lives--;
+        if (lives > 0) breakoutServe();
+        else Game_MarkAllDirty();
     }
+    if (score >= BLOCK_COUNT) Game_MarkAllDirty();
+}
 
-    // Draw ball
-    draw_game_bitmap(ball.x, ball.y, ball_bitmap, 2, 8); // Original was 2, 8. Assuming 2x8 pixels.
+static void breakoutRender(TFT_eSprite& sprite, fix16_t alpha, bool full) {
+    sprite.fillSprite(TFT_BLACK);
 
-    // Draw blocks
-    idx = 0;
-    for (uint8_t x = 0; x < BLOCK_COLS; x++) {
-        for (uint8_t y = 0; y < BLOCK_ROWS; y++) {
-            if (!blocks[idx])
-                draw_game_bitmap(x * 4, (y * 4) + 8, block_bitmap, 3, 8); // Original was 3, 8. Assuming 3x8 pixels.
-            idx++;
-        }
+    // Blocks
+    for (uint8_t i = 0; i < blocks.capacity; i++) {
+        const GameEntity* block = &blocks.items[i];
+        if (!block->active) continue;
+        sprite.fillRect(Fix_Floor(block->x), Fix_Floor(block->y), block->w - 1, block->h - 1, blockRowColors[block->value]);
     }
 
-    // Draw score
-    char buff[10]; // Increased buffer size
-    sprintf(buff, "%lu", score);
-    draw_game_string(buff, 0, 0);
-
-    // Draw lives
-    if (lives != 255) {
-        for (uint8_t i = 0; i < lives; i++)
-            draw_game_bitmap((SCREEN_WIDTH - (3 * 8)) + (8 * i), 1, bird_big, 7, 8); // Using bird_big as placeholder for livesImg
+    // Platform and ball
+    int16_t px = GameEntity_DrawX(&platform, alpha);
+    sprite.fillRect(px, PLATFORM_Y, PLATFORM_WIDTH, PLATFORM_HEIGHT, TFT_WHITE);
+    Game_MarkDirty(0, PLATFORM_Y, SCREEN_WIDTH, PLATFORM_HEIGHT);
+
+    int16_t bx = GameEntity_DrawX(&ball, alpha);
+    int16_t by = GameEntity_DrawY(&ball, alpha);
+    sprite.fillRect(bx, by, BALL_SIZE, BALL_SIZE, TFT_WHITE);
+    Game_MarkDirty(bx, by, BALL_SIZE, BALL_SIZE);
+
+    // Score and lives
+    char buff[12];
+    sprintf(buff, "%lu", (unsigned long)score);
+    sprite.setTextSize(1);
+    sprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    sprite.setTextDatum(TL_DATUM);
+    sprite.drawString(buff, 2, 2);
+    for (uint8_t i = 0; i < lives; i++) {
+        sprite.fillCircle(SCREEN_WIDTH - 8 - 10 * i, 5, 3, TFT_RED);
     }
+    Game_MarkDirty(0, 0, SCREEN_WIDTH, BREAKOUT_HUD_H);
 
     // Game over / Win messages
-    if (score >= BLOCK_COUNT)
-        draw_game_string("WIN", 50, 32);
-    if (lives == 255) // 255 because of overflow
-        draw_game_string("GAME OVER", 34, 32);
-
-    menuSprite.pushSprite(0, 0); // Push to screen
+    if (score >= BLOCK_COUNT || lives == 0) {
+        sprite.setTextDatum(MC_DATUM);
+        sprite.setTextSize(2);
+        sprite.drawString(lives == 0 ? "GAME OVER" : "WIN", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+        sprite.setTextSize(1);
+        sprite.drawString("Click to restart", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 20);
+        sprite.setTextDatum(TL_DATUM);
+    }
 }
 
 void breakoutGame() {
-    tft.fillScreen(TFT_BLACK); // Clear screen
-
-    // Initialize game variables
-    ball.x = SCREEN_WIDTH / 2;
-    ball.y = SCREEN_HEIGHT - 10;
-    ball.velX = -0.5;
-    ball.velY = -0.6;
-
-    // Allocate memory for blocks
-    blocks = (bool*)calloc(BLOCK_COUNT, sizeof(bool));
-    if (blocks == NULL) {
-        // Handle memory allocation error
-        return;
-    }
-
-    lives = 3;
-    score = 0;
-    platformX = (SCREEN_WIDTH / 2) - (PLATFORM_WIDTH / 2);
-
-    // Game loop
-    while (true) {
-        if (exitSubMenu || g_alarm_is_ringing) {
-            free(blocks); // Free allocated memory
-            return; // Exit game
-        }
+    static const GameDef breakout = {BREAKOUT_STEP_MS, BREAKOUT_STEP_MS, breakoutStart, breakoutUpdate, breakoutRender, NULL};
+    Game_Run(breakout);
+}
 
-        // Button handling
-        int direction = readEncoder();
-        if (direction == 1) { // Right
-            uptMove = UPT_MOVE_RIGHT;
-        } else if (direction == -1) { // Left
-            uptMove = UPT_MOVE_LEFT;
-        }
+// --- Conway's Game of Life Implementation ---
+// Bit-packed torus: cell x of a row is bit (x & 31) of word (x >> 5). Each
+// generation shifts every row one cell west and east (wrapping), then adds
+// the eight neighbour planes with bit-sliced adders, 32 cells per operation.
+// Only cells that flipped are drawn into the sprite, and only the rows that
+// changed are pushed to the display.
+#define LIFE_CELL_PX 2
+#define LIFE_COLS 119 // 238 px
+#define LIFE_ROWS 108 // 216 px, the hint line goes below
+#define LIFE_WORDS ((LIFE_COLS + 31) / 32)
+#define LIFE_LAST_BITS (LIFE_COLS - (LIFE_WORDS - 1) * 32) // Cells in a row's last word
+#define LIFE_LAST_MASK ((LIFE_LAST_BITS == 32) ? 0xFFFFFFFFu : ((1u << LIFE_LAST_BITS) - 1))
+#define LIFE_GENERATION_MS 30 // ~33 generations per second
+#define LIFE_COLOR TFT_GREEN
+
+static uint32_t lifeGrid[2][LIFE_ROWS][LIFE_WORDS];
+static uint32_t lifeWest[LIFE_ROWS][LIFE_WORDS]; // Bit x holds cell x - 1
+static uint32_t lifeEast[LIFE_ROWS][LIFE_WORDS]; // Bit x holds cell x + 1
+static uint8_t lifeCurrent = 0;
+
+static inline void lifeAdd3(uint32_t a, uint32_t b, uint32_t c, uint32_t& sum, uint32_t& carry) {
+    uint32_t t = a ^ b;
+    sum = t ^ c;
+    carry = (a & b) | (t & c);
+}
 
-        if (readButton()) {
-            if (gamesDetectDoubleClick()) {
-                free(blocks); // Free allocated memory
-                return; // Exit game on double click
-            }
+static void lifeShiftRows(uint32_t (*grid)[LIFE_WORDS]) {
+    for (int r = 0; r < LIFE_ROWS; r++) {
+        const uint32_t* row = grid[r];
+        uint32_t carry = (row[LIFE_WORDS - 1] >> (LIFE_LAST_BITS - 1)) & 1; // Last cell wraps to the front
+        for (int w = 0; w < LIFE_WORDS; w++) {
+            lifeWest[r][w] = (row[w] << 1) | carry;
+            carry = row[w] >> 31;
+            uint32_t next = (w + 1 < LIFE_WORDS) ? row[w + 1] : 0;
+            lifeEast[r][w] = (row[w] >> 1) | (next << 31);
         }
+        lifeWest[r][LIFE_WORDS - 1] &= LIFE_LAST_MASK;
+        lifeEast[r][LIFE_WORDS - 1] |= (row[0] & 1) << (LIFE_LAST_BITS - 1); // First cell wraps to the end
+    }
+}
 
-        breakout_draw(); // Draw current frame
-        vTaskDelay(pdMS_TO_TICKS(10)); // Small delay for frame rate
+static void lifeDrawCell(uint16_t* buf, int stride, int x, int y, uint16_t color) {
+    if (buf == NULL) {
+        menuSprite.fillRect(x * LIFE_CELL_PX, y * LIFE_CELL_PX, LIFE_CELL_PX, LIFE_CELL_PX, color);
+        return;
+    }
+    uint16_t swapped = (color >> 8) | (color << 8); // Sprites store RGB565 byte-swapped
+    uint16_t* p = buf + y * LIFE_CELL_PX * stride + x * LIFE_CELL_PX;
+    for (int dy = 0; dy < LIFE_CELL_PX; dy++, p += stride) {
+        for (int dx = 0; dx < LIFE_CELL_PX; dx++) p[dx] = swapped;
     }
 }
 
-// --- Conway's Game of Life Implementation ---
-#define GRID_SIZE 60
-#define CELL_SIZE 4 // Pixels per cell
-bool grid[GRID_SIZE][GRID_SIZE];
-bool nextGrid[GRID_SIZE][GRID_SIZE];
+static uint16_t* lifeSpriteBuffer() {
+    return (menuSprite.getColorDepth() == 16) ? (uint16_t*)menuSprite.getPointer() : NULL;
+}
 
-// Function to initialize grid with random state
+// Function to initialize grid with random state, drawn in full
 void initConwayGrid() {
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            grid[i][j] = (random(100) < 20); // 20% chance of being alive
+    lifeCurrent = 0;
+    menuSprite.fillSprite(TFT_BLACK);
+    uint16_t* buf = lifeSpriteBuffer();
+    int stride = menuSprite.width();
+    for (int r = 0; r < LIFE_ROWS; r++) {
+        for (int w = 0; w < LIFE_WORDS; w++) lifeGrid[0][r][w] = 0;
+        for (int x = 0; x < LIFE_COLS; x++) {
+            if (random(100) < 20) { // 20% chance of being alive
+                lifeGrid[0][r][x >> 5] |= 1u << (x & 31);
+                lifeDrawCell(buf, stride, x, r, LIFE_COLOR);
+            }
         }
     }
 }
 
-// Function to draw the grid
-void drawConwayGrid() {
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            if (grid[i][j]) {
-                tft.fillRect(j * CELL_SIZE, i * CELL_SIZE, CELL_SIZE, CELL_SIZE, TFT_GREEN);
-            } else {
-                tft.fillRect(j * CELL_SIZE, i * CELL_SIZE, CELL_SIZE, CELL_SIZE, TFT_BLACK);
+// Advances one generation and draws the flipped cells. Returns how many
+// flipped; the changed rows are returned in [*top, *bottom].
+uint32_t updateConwayGrid(int* top, int* bottom) {
+    uint32_t (*cur)[LIFE_WORDS] = lifeGrid[lifeCurrent];
+    uint32_t (*next)[LIFE_WORDS] = lifeGrid[lifeCurrent ^ 1];
+    uint16_t* buf = lifeSpriteBuffer();
+    int stride = menuSprite.width();
+    uint32_t flipped = 0;
+    *top = LIFE_ROWS;
+    *bottom = -1;
+
+    lifeShiftRows(cur);
+    for (int r = 0; r < LIFE_ROWS; r++) {
+        int up = (r == 0) ? LIFE_ROWS - 1 : r - 1;
+        int down = (r == LIFE_ROWS - 1) ? 0 : r + 1;
+        for (int w = 0; w < LIFE_WORDS; w++) {
+            // Neighbour count per bit as ones/twos/fours, mod 8; eight
+            // neighbours reads as zero, which is dead either way
+            uint32_t s_top, c_top, s_bot, c_bot, ones, c_ones, t_sum, t_carry;
+            lifeAdd3(lifeWest[up][w], cur[up][w], lifeEast[up][w], s_top, c_top);
+            lifeAdd3(lifeWest[down][w], cur[down][w], lifeEast[down][w], s_bot, c_bot);
+            uint32_t s_mid = lifeWest[r][w] ^ lifeEast[r][w];
+            uint32_t c_mid = lifeWest[r][w] & lifeEast[r][w];
+            lifeAdd3(s_top, s_mid, s_bot, ones, c_ones);
+            lifeAdd3(c_top, c_mid, c_bot, t_sum, t_carry);
+            uint32_t twos = t_sum ^ c_ones;
+            uint32_t fours = t_carry ^ (t_sum & c_ones);
+
+            uint32_t alive = cur[r][w];
+            // Three neighbours, or two and already alive
+            uint32_t born = ~fours & twos & (ones | alive);
+            if (w == LIFE_WORDS - 1) born &= LIFE_LAST_MASK;
+            next[r][w] = born;
+
+            uint32_t changed = born ^ alive;
+            if (changed == 0) continue;
+            if (r < *top) *top = r;
+            *bottom = r;
+            while (changed) {
+                int bit = __builtin_ctz(changed);
+                lifeDrawCell(buf, stride, w * 32 + bit, r, ((born >> bit) & 1) ? LIFE_COLOR : TFT_BLACK);
+                changed &= changed - 1;
+                flipped++;
             }
         }
     }
+    lifeCurrent ^= 1;
+    return flipped;
 }
 
-// Function to update the grid to the next generation
-void updateConwayGrid() {
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            int liveNeighbors = 0;
-            // Check 8 neighbors
-            for (int x = -1; x <= 1; x++) {
-                for (int y = -1; y <= 1; y++) {
-                    if (x == 0 && y == 0) continue; // Skip self
-                    int ni = (i + x + GRID_SIZE) % GRID_SIZE; // Wrap around
-                    int nj = (j + y + GRID_SIZE) % GRID_SIZE; // Wrap around
-                    if (grid[ni][nj]) {
-                        liveNeighbors++;
-                    }
-                }
-            }
+// Hint line under the board, drawn into the sprite only
+static void drawConwayHint() {
+    menuSprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    menuSprite.setTextSize(1);
+    menuSprite.setTextDatum(TL_DATUM);
+    menuSprite.setCursor(15, LIFE_ROWS * LIFE_CELL_PX + 8);
+    menuSprite.print("Auto-running, Double-click to exit");
+}
 
-            if (grid[i][j]) { // Live cell
-                if (liveNeighbors < 2 || liveNeighbors > 3) {
-                    nextGrid[i][j] = false; // Dies
-                } else {
-                    nextGrid[i][j] = true; // Lives
-                }
-            } else { // Dead cell
-                if (liveNeighbors == 3) {
-                    nextGrid[i][j] = true; // Becomes alive
-                } else {
-                    nextGrid[i][j] = false; // Stays dead
-                }
+// The whole board from the grid, for when the sprite was drawn over
+static void drawConwayBoard() {
+    menuSprite.fillSprite(TFT_BLACK);
+    uint16_t* buf = lifeSpriteBuffer();
+    int stride = menuSprite.width();
+    uint32_t (*cur)[LIFE_WORDS] = lifeGrid[lifeCurrent];
+    for (int r = 0; r < LIFE_ROWS; r++) {
+        for (int w = 0; w < LIFE_WORDS; w++) {
+            uint32_t alive = cur[r][w];
+            while (alive) {
+                int bit = __builtin_ctz(alive);
+                lifeDrawCell(buf, stride, w * 32 + bit, r, LIFE_COLOR);
+                alive &= alive - 1;
             }
         }
     }
-    // Copy nextGrid to grid
-    for (int i = 0; i < GRID_SIZE; i++) {
-        for (int j = 0; j < GRID_SIZE; j++) {
-            grid[i][j] = nextGrid[i][j];
-        }
-    }
+    drawConwayHint();
 }
 
-void ConwayGame() {
-    tft.fillScreen(TFT_BLACK);
-    initConwayGrid(); // Initialize with random state
-    drawConwayGrid(); // Initial draw
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-    tft.setTextSize(1);
-    tft.setCursor(35, 220);
-    tft.print("Auto-running, Double-click to exit"); // Update instruction
+// Rows changed since the last frame, pushed as one band
+static int lifeDirtyTop = LIFE_ROWS;
+static int lifeDirtyBottom = -1;
 
-    unsigned long lastUpdateTime = millis();
-    const unsigned long UPDATE_INTERVAL = 200; // Update every 200ms
+static void conwayStart() {
+    initConwayGrid(); // Initialize with random state
+    drawConwayHint();
+    lifeDirtyTop = LIFE_ROWS;
+    lifeDirtyBottom = -1;
+}
 
-    while (true) {
-        if (exitSubMenu) {
-            exitSubMenu = false; // Reset flag
-            return; // Exit game
-        }
-        if (g_alarm_is_ringing) { return; } // ADDED LINE
-        unsigned long currentTime = millis();
-
-        // Auto-run logic
-        if (currentTime - lastUpdateTime > UPDATE_INTERVAL) {
-            updateConwayGrid();
-            drawConwayGrid();
-            lastUpdateTime = currentTime;
-        }
+static void conwayUpdate() {
+    GameInput input;
+    while (Game_NextInput(&input)) {} // Auto-running, nothing to steer
 
-        // Button handling for exit
-        if (readButtonLongPress()) { return; }
-        // ADD THIS BLOCK
-        if (readButton()) {
-            if (gamesDetectDoubleClick()) {
-                //exitSubMenu = true; // Signal to exit
-                return; // Exit game
-            }
-        }
-        vTaskDelay(pdMS_TO_TICKS(10)); // Small delay for responsiveness
+    int top, bottom;
+    if (updateConwayGrid(&top, &bottom) == 0) {
+        // Still life: start over
+        conwayStart();
+        Game_MarkAllDirty();
+        return;
     }
+    if (top < lifeDirtyTop) lifeDirtyTop = top;
+    if (bottom > lifeDirtyBottom) lifeDirtyBottom = bottom;
 }
 
+// Generations draw their flipped cells as they run; only mark the band.
+static void conwayRender(TFT_eSprite& sprite, fix16_t alpha, bool full) {
+    if (full) {
+        drawConwayBoard(); // The runtime pushes it all
+        lifeDirtyTop = LIFE_ROWS;
+        lifeDirtyBottom = -1;
+        return;
+    }
+    if (lifeDirtyBottom < 0) return;
+    Game_MarkDirty(0, lifeDirtyTop * LIFE_CELL_PX, sprite.width(), (lifeDirtyBottom - lifeDirtyTop + 1) * LIFE_CELL_PX);
+    lifeDirtyTop = LIFE_ROWS;
+    lifeDirtyBottom = -1;
+}
 
+void ConwayGame() {
+    static const GameDef conway = {LIFE_GENERATION_MS, LIFE_GENERATION_MS, conwayStart, conwayUpdate, conwayRender, NULL};
+    Game_Run(conway);
+}
 
 // --- Buzzer Tap Game Implementation ---
+#define TAP_STEP_MS 10
 static int buzzerTapScore = 0;
 const int TAP_WINDOW_MS = 300; // Time window to tap after tone starts
 const int TONE_FREQ = 1000;
 const int TONE_DURATION = 100; // ms
 
-void BuzzerTapGame() {
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-    tft.setTextSize(2);
-    tft.setCursor(20, 50);
-    tft.print("Score: ");
-    tft.print(buzzerTapScore);
-    tft.setTextSize(1);
-    tft.setCursor(35, 140);
-    tft.print("Tap after tone, Double-click to exit");
+static uint32_t lastToneTime = 0;
+static uint32_t nextToneTime = 0;
+static bool tapScoreChanged = false;
 
+static void buzzerTapStart() {
     buzzerTapScore = 0;
+    lastToneTime = 0;
+    nextToneTime = millis() + random(1000, 3000); // Random interval between 1-3 seconds
+}
 
-    unsigned long lastToneTime = 0;
-    unsigned long nextToneInterval = random(1000, 3000); // Random interval between 1-3 seconds
+static void buzzerTapUpdate() {
+    uint32_t now = millis();
 
-    while (true) {
-        if (exitSubMenu) {
-            exitSubMenu = false; // Reset flag
-            noTone(BUZZER_PIN);
-            return; // Exit game
-        }
-        if (g_alarm_is_ringing) { return; } // ADDED LINE
-        unsigned long currentTime = millis();
-
-        // Play tone
-        if (currentTime - lastToneTime > nextToneInterval) {
-            tone(BUZZER_PIN, TONE_FREQ, TONE_DURATION);
-            lastToneTime = currentTime;
-            nextToneInterval = random(1000, 3000); // New random interval
-        }
+    // Play tone
+    if ((int32_t)(now - nextToneTime) >= 0) {
+        tone(BUZZER_PIN, TONE_FREQ, TONE_DURATION);
+        lastToneTime = now;
+        nextToneTime = now + random(1000, 3000); // New random interval
+    }
 
-        if (readButtonLongPress()) {
-            noTone(BUZZER_PIN); // Stop any ongoing tone
-            return; // Exit
-        } else if (readButton()) { // Handle short clicks for gameplay
-            if (gamesDetectDoubleClick()) { // Double click detected
-                //exitSubMenu = true; // Signal to exit
-                noTone(BUZZER_PIN); // Stop any ongoing tone
-                return; // Exit game
-            }
-            // Check if tap was within window
-            if (currentTime - lastToneTime > 0 && currentTime - lastToneTime < TAP_WINDOW_MS) {
-                buzzerTapScore++;
-                tft.fillRect(100, 50, 100, 20, TFT_BLACK); // Clear old score
-                tft.setCursor(100, 50);
-                tft.print(buzzerTapScore);
-                tone(BUZZER_PIN, TONE_FREQ * 2, 50); // Success sound
-            } else {
-                tone(BUZZER_PIN, TONE_FREQ / 2, 50); // Fail sound
-            }
+    // Taps are judged by when they were polled, not when this step runs
+    GameInput input;
+    while (Game_NextInput(&input)) {
+        if (input.type != GAME_INPUT_CLICK) continue;
+        if (lastToneTime != 0 && input.time_ms - lastToneTime < TAP_WINDOW_MS) {
+            buzzerTapScore++;
+            tapScoreChanged = true;
+            tone(BUZZER_PIN, TONE_FREQ * 2, 50); // Success sound
+        } else {
+            tone(BUZZER_PIN, TONE_FREQ / 2, 50); // Fail sound
         }
-        vTaskDelay(pdMS_TO_TICKS(10));
     }
 }
 
+static void buzzerTapRender(TFT_eSprite& sprite, fix16_t alpha, bool full) {
+    sprite.fillSprite(TFT_BLACK);
+    sprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    sprite.setTextDatum(TL_DATUM);
+    sprite.setTextSize(2);
+    sprite.setCursor(20, 50);
+    sprite.print("Score: ");
+    sprite.print(buzzerTapScore);
+    sprite.setTextSize(1);
+    sprite.setTextDatum(TC_DATUM);
+    sprite.drawString("Tap after tone, Double-click to exit", SCREEN_WIDTH / 2, 140);
+    sprite.setTextDatum(TL_DATUM);
+
+    if (tapScoreChanged) {
+        Game_MarkDirty(20, 50, SCREEN_WIDTH - 20, 16);
+        tapScoreChanged = false;
+    }
+}
+
+static void buzzerTapStop() {
+    noTone(BUZZER_PIN); // Stop any ongoing tone
+}
+
+void BuzzerTapGame() {
+    static const GameDef buzzerTap = {TAP_STEP_MS, 50, buzzerTapStart, buzzerTapUpdate, buzzerTapRender, buzzerTapStop};
+    Game_Run(buzzerTap);
+}
+
+// --- Time Challenge Game Implementation ---
+#define CHALLENGE_STEP_MS 10
+#define CHALLENGE_FRAME_MS 50 // The timer shows tenths
+
 // Constants for Time Challenge Game Progress Bar
 static const int PROGRESS_BAR_X = 20;
 static const int PROGRESS_BAR_Y = 180; // Below Timer and Diff
@@ -614,485 +634,427 @@ static const int PROGRESS_BAR_WIDTH = 200;
 static const int PROGRESS_BAR_HEIGHT = 10;
 static const uint16_t PROGRESS_BAR_COLOR = TFT_GREEN;
 static const uint16_t PROGRESS_BAR_BG_COLOR = TFT_DARKGREY;
+static const unsigned long BUZZER_INTERVAL_MS = 1000;
+
+static unsigned long targetTimeMs;
+static unsigned long challengeStartTime;
+static unsigned long lastBuzzerTime;
+static unsigned long elapsedMs;
+static bool challengeEnded;
+
+static void timeChallengeStart() {
+    targetTimeMs = random(8000, 12001); // 8 to 12 seconds
+    challengeStartTime = millis();
+    lastBuzzerTime = 0;
+    elapsedMs = 0;
+    challengeEnded = false;
+}
 
+static void timeChallengeUpdate() {
+    GameInput input;
+    while (Game_NextInput(&input)) {
+        if (input.type != GAME_INPUT_CLICK || challengeEnded) continue;
+        elapsedMs = input.time_ms - challengeStartTime; // The moment of the press
+        challengeEnded = true;
+        tone(BUZZER_PIN, 1500, 100); // Confirmation sound
+        Game_MarkAllDirty();
+    }
+    if (challengeEnded) return;
 
-void TimeChallengeGame() {
-    tft.fillScreen(TFT_BLACK);
-    menuSprite.fillSprite(TFT_BLACK); // Clear the sprite before drawing game elements
-    // Reusing global menuSprite for double buffering
-    menuSprite.setTextColor(TFT_WHITE, TFT_BLACK);
-    menuSprite.setTextSize(2); // Initial text size for Target and Timer labels
-
-    unsigned long lastBuzzerTime = 0;
-    const unsigned long BUZZER_INTERVAL_MS = 1000;
-
-    unsigned long targetTimeMs = random(8000, 12001); // 10 to 20 seconds
-    float targetTimeSec = targetTimeMs / 1000.0;
-
-    menuSprite.setCursor(20, 30);
-    menuSprite.printf("Target: %.1f s", targetTimeSec);
-
-    menuSprite.setCursor(20, 80);
-    menuSprite.print("Timer: 0.0 s"); // Timer label
-
-    // Draw progress bar background
-    menuSprite.drawRect(PROGRESS_BAR_X, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT, TFT_WHITE); // Border for the bar
-    menuSprite.fillRect(PROGRESS_BAR_X + 1, PROGRESS_BAR_Y + 1, PROGRESS_BAR_WIDTH - 2, PROGRESS_BAR_HEIGHT - 2, PROGRESS_BAR_BG_COLOR); // Background fill
-
-    unsigned long startTime = millis();
-    unsigned long pressTime = 0;
-    bool gameEnded = false;
+    unsigned long currentTime = millis();
+    elapsedMs = currentTime - challengeStartTime;
 
-    while (true) {
-        if (exitSubMenu) {
-            exitSubMenu = false; // Reset flag
-            return; // Exit game
-        }
-        if (g_alarm_is_ringing) { return; } // ADDED LINE
-        unsigned long currentTime = millis();
-
-        if (!gameEnded) {
-            float elapsedSec = (currentTime - startTime) / 1000.0;
-            menuSprite.fillRect(100, 80, 120, 20, TFT_BLACK); // Clear old timer
-            menuSprite.setTextSize(3); // Set larger size for timer number
-            menuSprite.setCursor(100, 80);
-            menuSprite.printf("%.1f s", elapsedSec); // <-- TIMER NUMBER
-            menuSprite.setTextSize(2); // Reset to default size for labels
-
-            // Update progress bar
-            float progressRatio = (float)(currentTime - startTime) / targetTimeMs;
-            int filledWidth = (int)(progressRatio * PROGRESS_BAR_WIDTH);
-            
-            // Ensure filledWidth does not exceed PROGRESS_BAR_WIDTH
-            if (filledWidth > PROGRESS_BAR_WIDTH) {
-                filledWidth = PROGRESS_BAR_WIDTH;
-            }
-            
-            // Clear previous progress and draw new progress
-            menuSprite.fillRect(PROGRESS_BAR_X + 1, PROGRESS_BAR_Y + 1, PROGRESS_BAR_WIDTH - 2, PROGRESS_BAR_HEIGHT - 2, PROGRESS_BAR_BG_COLOR); // Clear the filled part
-            menuSprite.fillRect(PROGRESS_BAR_X + 1, PROGRESS_BAR_Y + 1, filledWidth, PROGRESS_BAR_HEIGHT - 2, PROGRESS_BAR_COLOR); // Draw new filled part
+    // Buzzer sound every second
+    if (currentTime - lastBuzzerTime >= BUZZER_INTERVAL_MS) {
+        tone(BUZZER_PIN, 1000, 50);
+        lastBuzzerTime = currentTime;
+    }
+}
 
-            
-            // Ensure filledWidth does not exceed PROGRESS_BAR_WIDTH
-            if (filledWidth > PROGRESS_BAR_WIDTH) {
-                filledWidth = PROGRESS_BAR_WIDTH;
-            }
+static void timeChallengeRender(TFT_eSprite& sprite, fix16_t alpha, bool full) {
+    sprite.fillSprite(TFT_BLACK);
+    sprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    sprite.setTextDatum(TL_DATUM);
+    sprite.setTextSize(2);
+    sprite.setCursor(20, 30);
+    sprite.printf("Target: %.1f s", targetTimeMs / 1000.0);
+    sprite.setCursor(20, 80);
+    sprite.print("Timer:");
+
+    sprite.setTextSize(3);
+    sprite.setCursor(100, 80);
+    sprite.printf("%.1f s", elapsedMs / 1000.0);
+    sprite.setTextSize(2);
+
+    if (challengeEnded) {
+        float diffSec = ((long)elapsedMs - (long)targetTimeMs) / 1000.0;
+        sprite.setCursor(20, 130);
+        sprite.printf("Diff: %.2f s", diffSec);
+    }
 
-            // Buzzer sound every second
-            if (currentTime - lastBuzzerTime >= BUZZER_INTERVAL_MS) {
-                tone(BUZZER_PIN, 1000, 50); // Play a tone (e.g., 1000 Hz for 50 ms)
-                lastBuzzerTime = currentTime;
-            }
-            
-        }
-        menuSprite.pushSprite(0, 0); // Push the sprite to the screen
+    // Progress bar
+    int filledWidth = min<unsigned long>(elapsedMs * (PROGRESS_BAR_WIDTH - 2) / targetTimeMs, PROGRESS_BAR_WIDTH - 2);
+    sprite.drawRect(PROGRESS_BAR_X, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT, TFT_WHITE);
+    sprite.fillRect(PROGRESS_BAR_X + 1, PROGRESS_BAR_Y + 1, PROGRESS_BAR_WIDTH - 2, PROGRESS_BAR_HEIGHT - 2, PROGRESS_BAR_BG_COLOR);
+    sprite.fillRect(PROGRESS_BAR_X + 1, PROGRESS_BAR_Y + 1, filledWidth, PROGRESS_BAR_HEIGHT - 2, PROGRESS_BAR_COLOR);
 
-        if (readButtonLongPress()) { return; } // Exit game
-        else if (readButton()) { // Handle short clicks for gameplay
-            if (gamesDetectDoubleClick()) { // Double click detected
-                //exitSubMenu = true; // Signal to exit
-                return; // Exit game
-            }
-            if (!gameEnded) {
-                pressTime = currentTime;
-                gameEnded = true;
-                tone(BUZZER_PIN, 1500, 100); // Confirmation sound
-                
-                float diffSec = (float)((long)(pressTime - startTime) - (long)targetTimeMs) / 1000.0;
-                menuSprite.setTextSize(2);
-                menuSprite.setCursor(20, 130);
-                menuSprite.printf("Diff: %.2f s", diffSec);
-            }
-        }
-        vTaskDelay(pdMS_TO_TICKS(10));
+    if (!challengeEnded) {
+        Game_MarkDirty(100, 80, SCREEN_WIDTH - 100, 24);
+        Game_MarkDirty(PROGRESS_BAR_X, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT);
     }
 }
 
+void TimeChallengeGame() {
+    static const GameDef timeChallenge = {CHALLENGE_STEP_MS, CHALLENGE_FRAME_MS, timeChallengeStart, timeChallengeUpdate, timeChallengeRender, NULL};
+    Game_Run(timeChallenge);
+}
 
 // --- Car Dodger Game Implementation ---
-#define UPT_MOVE_NONE   0
-#define UPT_MOVE_UP     1
-#define UPT_MOVE_DOWN   2
-
+#define CAR_STEP_MS     20
 #define CAR_COUNT       3
-#define CAR_WIDTH       12
-#define CAR_LENGTH      15
-#define ROAD_SPEED      6
-
-typedef struct {
-    uint8_t x;
-    uint8_t y;
-    uint8_t speed;
-} s_otherCars;
-
-typedef struct {
-    bool hit;
-    uint8_t lane;
-    uint8_t y;
-} s_myCar;
-
-// Placeholder bitmaps (replace with actual ones if available in img.h or define new ones)
-const uint16_t carImg_bitmap[] = {
-    0x40,0xF8,0xEC,0x2C,0x2C,0x38,0xF0,0x10,0xD0,0x30,0xE8,0x4C,0x4C,0x9C,0xF0, // First 15 bytes
-    0x02,0x1F,0x37,0x34,0x34,0x1C,0x0F,0x08,0x0B,0x0C,0x17,0x32,0x32,0x39,0x0F  // Next 15 bytes
-}; // Assuming 15x16 pixels, 2 bytes per column for 16-bit color
-
-const uint16_t roadMarking_bitmap[] = {
-    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF
-}; // Example 8x8 white block
-
-static uint32_t highscore_carDodger; // Renamed to avoid conflict
-static uint32_t score_carDodger;     // Renamed to avoid conflict
-static uint8_t uptMove_carDodger;    // Renamed to avoid conflict
-static uint8_t lives_carDodger;      // Renamed to avoid conflict
-static s_otherCars cars[CAR_COUNT];
-
-// Game draw function
-void carDodger_draw() {
-    static s_myCar myCar;
-    static unsigned long hitTime;
-    static bool newHighscore;
+#define CAR_WIDTH       20 // Across the lane
+#define CAR_LENGTH      30
+#define LANE_COUNT      4
+#define LANE_HEIGHT     40
+#define ROAD_TOP        40
+#define ROAD_HEIGHT     (LANE_COUNT * LANE_HEIGHT)
+#define ROAD_SPEED      6  // Pixels per step
+#define DASH_SPACING    48
+#define MY_CAR_X        8
+#define MY_CAR_SPEED    4  // Pixels per step while changing lane
+#define CAR_HIT_STEPS   (1000 / CAR_STEP_MS) // Blinking, can't be hit again
+#define CAR_QUAKE_STEPS (350 / CAR_STEP_MS)
+#define CAR_HUD_H       20
+
+static uint32_t highscore_carDodger; // Kept between runs
+static uint32_t score_carDodger;
+static uint8_t lives_carDodger;
+static bool newHighscore;
+
+GAME_POOL(cars, CAR_COUNT);
+static GameEntity myCar;
+static uint8_t myLane;
+static uint16_t hitSteps;   // Steps left of the hit
+static int32_t roadScroll;  // Pixels the road has moved, for the markings
+
+static int16_t laneY(uint8_t lane) {
+    return ROAD_TOP + lane * LANE_HEIGHT + (LANE_HEIGHT - CAR_WIDTH) / 2;
+}
+
+static void respawnCar(GameEntity* car, int16_t x) {
+    car->value = random(0, LANE_COUNT);
+    GameEntity_Place(car, x, laneY(car->value));
+}
+
+static void carDodgerStart() {
+    GamePool_Clear(cars);
+    for (uint8_t i = 0; i < CAR_COUNT; i++) {
+        GameEntity* car = GamePool_Spawn(cars);
+        car->w = CAR_LENGTH;
+        car->h = CAR_WIDTH;
+        car->vx = -Fix_FromInt(i + 2);
+        respawnCar(car, SCREEN_WIDTH + i * 60);
+    }
+
+    myLane = 0;
+    myCar.w = CAR_LENGTH;
+    myCar.h = CAR_WIDTH;
+    GameEntity_Place(&myCar, MY_CAR_X, laneY(myLane));
+    hitSteps = 0;
+    roadScroll = 0;
+    score_carDodger = 0;
+    lives_carDodger = 3;
+}
 
+static void carDodgerUpdate() {
     // Change lane
-    if (uptMove_carDodger == UPT_MOVE_UP && myCar.lane < 3)
-        myCar.lane++;
-    else if (uptMove_carDodger == UPT_MOVE_DOWN && myCar.lane > 0)
-        myCar.lane--;
-    uptMove_carDodger = UPT_MOVE_NONE;
+    GameInput input;
+    while (Game_NextInput(&input)) {
+        if (input.type == GAME_INPUT_CLICK && lives_carDodger == 0) {
+            carDodgerStart();
+            Game_MarkAllDirty();
+            return;
+        }
+        if (input.type == GAME_INPUT_TURN) {
+            myLane = constrain(myLane + input.delta, 0, LANE_COUNT - 1);
+        }
+    }
+    if (lives_carDodger == 0) return;
 
     // Move to new lane
-    uint8_t y = myCar.lane * 16;
-    if (myCar.y > y)
-        myCar.y -= 2;
-    else if (myCar.y < y)
-        myCar.y += 2;
-
-    if (lives_carDodger != 255) {
-        // Move cars
-        for (uint8_t i = 0; i < CAR_COUNT; i++) {
-            // Move car
-            cars[i].x -= cars[i].speed;
-
-            // Gone off screen
-            if (cars[i].x > 200 && cars[i].x < 255 - 16) { // Original overflow check
-                cars[i].x = SCREEN_WIDTH;
-                cars[i].y = (random(0, 4)) * 16; // random(0,4) for 0,1,2,3
-                score_carDodger++;
-            }
+    myCar.prev_y = myCar.y;
+    int16_t y = Fix_Floor(myCar.y), target = laneY(myLane);
+    if (y != target) {
+        y += constrain(target - y, -MY_CAR_SPEED, MY_CAR_SPEED);
+        myCar.y = Fix_FromInt(y);
+    }
+    roadScroll += ROAD_SPEED;
+    if (hitSteps > 0) hitSteps--;
+
+    // Move cars
+    for (uint8_t i = 0; i < cars.capacity; i++) {
+        GameEntity* car = &cars.items[i];
+        GameEntity_Move(car);
+        if (car->x < -Fix_FromInt(CAR_LENGTH)) { // Gone off screen
+            respawnCar(car, SCREEN_WIDTH + random(0, 60));
+            score_carDodger++;
         }
+    }
 
-        // Stop cars from going through each other
-        // Its a little bit glitchy
-        for (uint8_t i = 0; i < CAR_COUNT; i++) {
-            for (uint8_t c = 0; c < CAR_COUNT; c++) {
-                if (i != c && cars[i].y == cars[c].y && cars[i].x > cars[c].x && cars[i].x < cars[c].x + CAR_LENGTH) {
-                    cars[i].x = cars[c].x + CAR_LENGTH + 1;
-                    //cars[i].speed = cars[c].speed;
-                }
+    // Stop cars from going through each other
+    for (uint8_t i = 0; i < cars.capacity; i++) {
+        GameEntity* car = &cars.items[i];
+        for (uint8_t c = 0; c < cars.capacity; c++) {
+            const GameEntity* other = &cars.items[c];
+            if (i == c || car->x <= other->x) continue;
+            if (Game_Overlap(GameEntity_Rect(car), GameEntity_Rect(other))) {
+                car->x = car->prev_x = other->x + Fix_FromInt(CAR_LENGTH + 4);
             }
         }
+    }
 
-        // Collision
-        if (!myCar.hit) {
-            for (uint8_t i = 0; i < CAR_COUNT; i++) {
-                if (cars[i].x < CAR_LENGTH) {
-                    uint8_t carY = cars[i].y + 2;
-                    uint8_t myCarY = myCar.y + 2;
-                    if ((carY >= myCarY && carY <= myCarY + CAR_WIDTH) || (carY + CAR_WIDTH >= myCarY && carY + CAR_WIDTH <= myCarY + CAR_WIDTH)) {
-                        myCar.hit = true;
-                        hitTime = millis();
-                        lives_carDodger--;
-                        if (lives_carDodger == 255) {
-                            // Check for new highscore
-                            if (score_carDodger > highscore_carDodger) {
-                                newHighscore = true;
-                                highscore_carDodger = score_carDodger;
-                                // eeprom_update_block(&highscore, (uint*)&eepHighscore, sizeof(uint)); // Removed
-                            } else {
-                                newHighscore = false;
-                            }
-                            // led_flash(LED_RED, 250, 255); // Replaced with direct LED toggle
-                            tone(BUZZER_PIN, 2000, 250); // Equivalent to buzzer_buzz(250, TONE_2KHZ, ...)
-                        } else {
-                            // led_flash(LED_RED, 30, 255); // Replaced with direct LED toggle
-                            tone(BUZZER_PIN, 2000, 100); // Equivalent to buzzer_buzz(100, TONE_2KHZ, ...)
-                        }
-                    }
-                }
-            }
+    // Collision
+    if (hitSteps > 0) return;
+    GameRect myRect = GameEntity_Rect(&myCar);
+    for (uint8_t i = 0; i < cars.capacity; i++) {
+        if (!Game_Overlap(myRect, GameEntity_Rect(&cars.items[i]))) continue;
+        hitSteps = CAR_HIT_STEPS;
+        lives_carDodger--;
+        if (lives_carDodger == 0) {
+            // Check for new highscore
+            newHighscore = score_carDodger > highscore_carDodger;
+            if (newHighscore) highscore_carDodger = score_carDodger;
+            tone(BUZZER_PIN, 2000, 250);
+            Game_MarkAllDirty();
+        } else {
+            tone(BUZZER_PIN, 2000, 100);
         }
+        break;
     }
+}
 
-    unsigned long now = millis();
+static void drawCar(TFT_eSprite& sprite, int16_t x, int16_t y, uint16_t color) {
+    sprite.fillRect(x + 4, y - 1, 6, CAR_WIDTH + 2, TFT_BLACK);                  // Rear wheels
+    sprite.fillRect(x + CAR_LENGTH - 10, y - 1, 6, CAR_WIDTH + 2, TFT_BLACK);    // Front wheels
+    sprite.fillRoundRect(x, y + 2, CAR_LENGTH, CAR_WIDTH - 4, 4, color);
+    sprite.fillRect(x + CAR_LENGTH - 12, y + 5, 5, CAR_WIDTH - 10, TFT_SKYBLUE); // Windscreen
+}
 
-    if (myCar.hit && now - hitTime >= 1000)
-        myCar.hit = false;
+static void carDodgerRender(TFT_eSprite& sprite, fix16_t alpha, bool full) {
+    sprite.fillSprite(TFT_BLACK);
+    sprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    sprite.setTextDatum(TL_DATUM);
+    char buff[12];
 
-    // Quake
-    static int8_t quakeY;
-    if (myCar.hit && now - hitTime < 350) {
-        if (quakeY == 2)
-            quakeY = -2;
-        else
-            quakeY = 2;
-    } else {
-        quakeY = 0;
+    if (lives_carDodger == 0) {
+        // Draw end game stuff
+        sprite.setTextSize(2);
+        sprite.drawString("GAME OVER", 20, 60);
+        sprite.drawString("SCORE:", 20, 90);
+        sprite.drawString("HIGHSCORE:", 20, 110);
+        if (newHighscore) sprite.drawString("NEW HIGHSCORE!", 20, 140);
+        sprintf(buff, "%lu", (unsigned long)score_carDodger);
+        sprite.drawString(buff, 150, 90);
+        sprintf(buff, "%lu", (unsigned long)highscore_carDodger);
+        sprite.drawString(buff, 150, 110);
+        sprite.setTextSize(1);
+        sprite.drawString("Click to restart", 20, 180);
+        return;
     }
 
-    // Draw my car
-    if (!myCar.hit || (myCar.hit && (now & 64)))
-        draw_game_bitmap(0, myCar.y + quakeY, carImg_bitmap, 15, 16);
-
-    char buff[10]; // Increased buffer size
-    if (lives_carDodger != 255) {
-        // Draw other cars
-        for (int8_t i = CAR_COUNT - 1; i >= 0; i--) // LOOPR
-            draw_game_bitmap(cars[i].x, cars[i].y + quakeY, carImg_bitmap, 15, 16);
-
-        // Draw road markings
-        static uint8_t dotX[3] = {0, 45, 90};
-        for (uint8_t i = 0; i < 3; i++) {
-            dotX[i] -= ROAD_SPEED;
-
-            if (dotX[i] >= SCREEN_WIDTH && dotX[i] < 255 - 8) // Original overflow check
-                dotX[i] = SCREEN_WIDTH;
-
-            for (uint8_t x = 0; x < 3; x++)
-                draw_game_bitmap(dotX[i], (x * 16) + quakeY + 16, roadMarking_bitmap, 8, 8);
+    // Quake just after a hit
+    int16_t quakeY = 0;
+    if (hitSteps > CAR_HIT_STEPS - CAR_QUAKE_STEPS) quakeY = (Game_Steps() & 1) ? 2 : -2;
+
+    // Road and markings
+    sprite.fillRect(0, ROAD_TOP + quakeY, SCREEN_WIDTH, ROAD_HEIGHT, 0x2104);
+    sprite.drawFastHLine(0, ROAD_TOP + quakeY, SCREEN_WIDTH, TFT_WHITE);
+    sprite.drawFastHLine(0, ROAD_TOP + ROAD_HEIGHT - 1 + quakeY, SCREEN_WIDTH, TFT_WHITE);
+    int32_t scroll = roadScroll - ROAD_SPEED + Fix_Floor(ROAD_SPEED * alpha);
+    for (int16_t x = -(scroll % DASH_SPACING); x < SCREEN_WIDTH; x += DASH_SPACING) {
+        for (uint8_t lane = 1; lane < LANE_COUNT; lane++) {
+            sprite.fillRect(x, ROAD_TOP + lane * LANE_HEIGHT - 1 + quakeY, 16, 2, TFT_WHITE);
         }
-
-        // Draw score
-        sprintf(buff, "%lu", score_carDodger);
-        menuSprite.setTextSize(1); // Set text size for score
-        menuSprite.setTextDatum(TR_DATUM); // Align to top right
-        menuSprite.drawString(buff, SCREEN_WIDTH - 5, 1); // Adjusted position
-        menuSprite.setTextDatum(TL_DATUM); // Reset to top left
-
-        // Draw lives
-        for (uint8_t i = 0; i < lives_carDodger; i++)
-            draw_game_bitmap(32 + (8 * i), 1, bird_big, 7, 8); // Using bird_big as placeholder for livesImg
-    } else {
-        // Draw end game stuff
-        menuSprite.setTextSize(2);
-        menuSprite.drawString("GAME OVER", 20, 0);
-        menuSprite.drawString("SCORE:", 20, 16);
-        menuSprite.drawString("HIGHSCORE:", 20, 32);
-
-        if (newHighscore)
-            menuSprite.drawString("NEW HIGHSCORE!", 20, 48);
-
-        sprintf(buff, "%lu", score_carDodger);
-        menuSprite.drawString(buff, 96, 16);
-
-        sprintf(buff, "%lu", highscore_carDodger);
-        menuSprite.drawString(buff, 96, 32);
     }
 
-    menuSprite.pushSprite(0, 0); // Push to screen
+    // Other cars, then mine (blinking while hit)
+    for (int8_t i = cars.capacity - 1; i >= 0; i--) {
+        const GameEntity* car = &cars.items[i];
+        drawCar(sprite, GameEntity_DrawX(car, alpha), GameEntity_DrawY(car, alpha) + quakeY, TFT_RED);
+    }
+    if (hitSteps == 0 || (millis() & 64)) {
+        drawCar(sprite, MY_CAR_X, GameEntity_DrawY(&myCar, alpha) + quakeY, TFT_YELLOW);
+    }
+    Game_MarkDirty(0, ROAD_TOP - 2, SCREEN_WIDTH, ROAD_HEIGHT + 4);
+
+    // Score and lives
+    sprintf(buff, "%lu", (unsigned long)score_carDodger);
+    sprite.setTextSize(2);
+    sprite.setTextDatum(TR_DATUM);
+    sprite.drawString(buff, SCREEN_WIDTH - 5, 2);
+    sprite.setTextDatum(TL_DATUM);
+    for (uint8_t i = 0; i < lives_carDodger; i++) {
+        sprite.fillRoundRect(5 + 16 * i, 4, 12, 8, 2, TFT_YELLOW);
+    }
+    Game_MarkDirty(0, 0, SCREEN_WIDTH, CAR_HUD_H);
 }
 
 void carDodgerGame() {
-    tft.fillScreen(TFT_BLACK); // Clear screen
-
-    // Initialize game variables
-    for (uint8_t i = 0; i < CAR_COUNT; i++) {
-        cars[i].y = i * 16;
-        cars[i].speed = i + 1;
-        cars[i].x = SCREEN_WIDTH;
-    }
-
-    score_carDodger = 0;
-    uptMove_carDodger = UPT_MOVE_NONE;
-    lives_carDodger = 3;
-    highscore_carDodger = 0; // Initialize highscore
-
-    // Game loop
-    while (true) {
-        if (exitSubMenu || g_alarm_is_ringing) {
-            return; // Exit game
-        }
-
-        // Button handling
-        if (readButton()) {
-            if (gamesDetectDoubleClick()) {
-                return; // Exit game on double click
-            }
-            // Single click for lane change
-            if (uptMove_carDodger == UPT_MOVE_NONE) { // Only allow move if not already moving
-                if (readEncoder() == 1) { // Right encoder turn for UP
-                    uptMove_carDodger = UPT_MOVE_UP;
-                } else if (readEncoder() == -1) { // Left encoder turn for DOWN
-                    uptMove_carDodger = UPT_MOVE_DOWN;
-                }
-            }
-        }
-
-        carDodger_draw(); // Draw current frame
-        vTaskDelay(pdMS_TO_TICKS(10)); // Small delay for frame rate
-    }
+    static const GameDef carDodger = {CAR_STEP_MS, CAR_STEP_MS, carDodgerStart, carDodgerUpdate, carDodgerRender, NULL};
+    Game_Run(carDodger);
 }
 // --- Flappy Bird Game Implementation ---
 // Based on game/main.c
 
 // Game constants
+#define FLAPPY_STEP_MS 30  // The physics below are per step
+#define FLAPPY_FRAME_MS 15 // Two frames per step, positions interpolated
 #define BIRD_X 40
 #define BIRD_RADIUS 5
-#define GRAVITY 0.3
-#define JUMP_FORCE -4.5
+#define GRAVITY FIX_FROM_FLOAT(0.3)
+#define JUMP_FORCE FIX_FROM_FLOAT(-4.5)
 #define PIPE_WIDTH 20
 #define PIPE_GAP 80
 #define PIPE_SPEED 2
 #define PIPE_INTERVAL 120 // pixels between pipes
 
-void flappy_bird_game() {
-    // Game variables
-    float bird_y = SCREEN_HEIGHT / 2;
-    float bird_vy = 0;
-    int pipes_x[2];
-    int pipes_y[2];
-    int score = 0;
-    bool game_over = false;
-    bool start_game = false;
-
-    // Initialize pipes
-    pipes_x[0] = SCREEN_WIDTH;
-    pipes_y[0] = random(40, SCREEN_HEIGHT - 40 - PIPE_GAP);
-    pipes_x[1] = SCREEN_WIDTH + PIPE_INTERVAL + (PIPE_WIDTH / 2);
-    pipes_y[1] = random(40, SCREEN_HEIGHT - 40 - PIPE_GAP);
-
-    unsigned long lastFrameTime = millis();
-    unsigned long lastClickTime = 0;
-
-    while (true) {
-        // --- Exit Condition ---
-        if (exitSubMenu) { // ADD THIS LINE
-            exitSubMenu = false; // Reset flag
-            return; // Exit game
-        }
-        if (g_alarm_is_ringing) { return; } // ADDED LINE
-        if (readButtonLongPress()) { return; }
-
-        // ADD THIS BLOCK
-        if (readButton()) {
-            if (gamesDetectDoubleClick()) { // Double click detected
-               // exitSubMenu = true; // Signal to exit
-                return; // Exit game
-            }
-            lastClickTime = millis(); // For single click game logic
-        }
-
-        // --- Logic ---
-        if (!start_game) {
-            if (millis() - lastClickTime < 500 && millis() - lastClickTime > 0) {
-                start_game = true;
-                lastClickTime = 0;
-            }
-        } else if (!game_over) {
-            // Frame Rate Control
-            unsigned long currentTime = millis();
-            if (currentTime - lastFrameTime < 30) { // ~33 FPS
-                vTaskDelay(pdMS_TO_TICKS(1));
-                continue;
-            }
-            lastFrameTime = currentTime;
+GAME_POOL(pipes, 2); // x is the left edge, value the top of the gap
+static GameEntity flappyBird; // Box around the bird, Q16.16 pixels
+static int flappyScore;
+static bool flappyStarted;
+static bool flappyOver;
 
-            // Input
-            if (millis() - lastClickTime < 500 && millis() - lastClickTime > 0) {
-                bird_vy = JUMP_FORCE;
-                tone(BUZZER_PIN, 1500, 20);
-                lastClickTime = 0;
-            }
+static void placePipe(GameEntity* pipe, int16_t x) {
+    GameEntity_Place(pipe, x, 0);
+    pipe->value = random(40, SCREEN_HEIGHT - 40 - PIPE_GAP);
+}
 
-            // Bird Physics
-            bird_vy += GRAVITY;
-            bird_y += bird_vy;
-
-            // Pipe Logic
-            for (int i = 0; i < 2; i++) {
-                pipes_x[i] -= PIPE_SPEED;
-                if (pipes_x[i] < -PIPE_WIDTH) {
-                    pipes_x[i] = SCREEN_WIDTH;
-                    pipes_y[i] = random(40, SCREEN_HEIGHT - 40 - PIPE_GAP);
-                }
-                if (pipes_x[i] + PIPE_WIDTH < BIRD_X && pipes_x[i] + PIPE_WIDTH + PIPE_SPEED >= BIRD_X) {
-                    score++;
-                    tone(BUZZER_PIN, 2500, 20);
-                }
-            }
+static void flappyStart() {
+    flappyBird.w = flappyBird.h = 2 * BIRD_RADIUS;
+    GameEntity_Place(&flappyBird, BIRD_X - BIRD_RADIUS, SCREEN_HEIGHT / 2 - BIRD_RADIUS);
+    flappyBird.vy = 0;
+
+    GamePool_Clear(pipes);
+    for (int i = 0; i < 2; i++) {
+        GameEntity* pipe = GamePool_Spawn(pipes);
+        pipe->w = PIPE_WIDTH;
+        pipe->vx = -Fix_FromInt(PIPE_SPEED);
+        placePipe(pipe, SCREEN_WIDTH + i * (PIPE_INTERVAL + PIPE_WIDTH / 2));
+    }
+    flappyScore = 0;
+    flappyStarted = false;
+    flappyOver = false;
+}
 
-            // Collision Detection
-            if (bird_y + BIRD_RADIUS > SCREEN_HEIGHT || bird_y - BIRD_RADIUS < 0) {
-                game_over = true;
-            }
-            for (int i = 0; i < 2; i++) {
-                if (BIRD_X + BIRD_RADIUS > pipes_x[i] && BIRD_X - BIRD_RADIUS < pipes_x[i] + PIPE_WIDTH) {
-                    if (bird_y - BIRD_RADIUS < pipes_y[i] || bird_y + BIRD_RADIUS > pipes_y[i] + PIPE_GAP) {
-                        game_over = true;
-                    }
-                }
-            }
-            if (game_over) {
-                tone(BUZZER_PIN, 500, 200);
-            }
-        } else { // Game is over
-            if (millis() - lastClickTime < 500 && millis() - lastClickTime > 0) {
-                // Reset game
-                bird_y = SCREEN_HEIGHT / 2;
-                bird_vy = 0;
-                score = 0;
-                pipes_x[0] = SCREEN_WIDTH;
-                pipes_y[0] = random(40, SCREEN_HEIGHT - 40 - PIPE_GAP);
-                pipes_x[1] = SCREEN_WIDTH + PIPE_INTERVAL + (PIPE_WIDTH / 2);
-                pipes_y[1] = random(40, SCREEN_HEIGHT - 40 - PIPE_GAP);
-                game_over = false;
-                start_game = false;
-                lastClickTime = 0;
-            }
+static void flappyUpdate() {
+    // --- Input ---
+    bool jump = false;
+    GameInput input;
+    while (Game_NextInput(&input)) {
+        if (input.type != GAME_INPUT_CLICK) continue;
+        if (flappyOver) {
+            flappyStart(); // Reset game
+            Game_MarkAllDirty();
+            return;
         }
-
-        // --- Drawing (using menuSprite) ---
-        menuSprite.fillSprite(TFT_BLACK); // Clear buffer
-
-        if (!start_game) {
-            menuSprite.setTextSize(2);
-            menuSprite.setCursor(50, SCREEN_HEIGHT / 2 + 10);
-            menuSprite.print("Click to start");
+        if (!flappyStarted) {
+            flappyStarted = true;
+            Game_MarkAllDirty();
         } else {
-            // Draw Bird
-            menuSprite.pushImage(BIRD_X - 5, (int)bird_y - 4, 11, 8, bird);
-
-            // Draw Pipes
-            for (int i = 0; i < 2; i++) {
-                menuSprite.fillRect(pipes_x[i], 0, PIPE_WIDTH, pipes_y[i], TFT_GREEN);
-                menuSprite.fillRect(pipes_x[i] - 2, pipes_y[i] - 10, PIPE_WIDTH + 4, 10, TFT_GREEN);
-                menuSprite.fillRect(pipes_x[i], pipes_y[i] + PIPE_GAP, PIPE_WIDTH, SCREEN_HEIGHT - (pipes_y[i] + PIPE_GAP), TFT_GREEN);
-                menuSprite.fillRect(pipes_x[i] - 2, pipes_y[i] + PIPE_GAP, PIPE_WIDTH + 4, 10, TFT_GREEN);
-            }
+            jump = true;
+        }
+    }
+    if (!flappyStarted || flappyOver) return;
 
-            // Draw Score
-            menuSprite.setTextSize(2);
-            menuSprite.setCursor(10, 10);
-            menuSprite.printf("Score: %d", score);
-
-            if (game_over) {
-                menuSprite.setTextSize(3);
-                menuSprite.setCursor(40, SCREEN_HEIGHT / 2 - 30);
-                menuSprite.print("Game Over");
-                menuSprite.setTextSize(2);
-                menuSprite.setCursor(50, SCREEN_HEIGHT / 2 + 10);
-                menuSprite.print("Click to restart");
-            }
+    // --- Bird Physics ---
+    if (jump) {
+        flappyBird.vy = JUMP_FORCE;
+        tone(BUZZER_PIN, 1500, 20);
+    }
+    flappyBird.vy += GRAVITY;
+    GameEntity_Move(&flappyBird);
+
+    // --- Pipe Logic ---
+    for (int i = 0; i < 2; i++) {
+        GameEntity* pipe = &pipes.items[i];
+        GameEntity_Move(pipe);
+        int16_t x = Fix_Floor(pipe->x);
+        if (x < -PIPE_WIDTH) {
+            placePipe(pipe, SCREEN_WIDTH);
+            x = SCREEN_WIDTH;
+        }
+        if (x + PIPE_WIDTH < BIRD_X && x + PIPE_WIDTH + PIPE_SPEED >= BIRD_X) {
+            flappyScore++;
+            tone(BUZZER_PIN, 2500, 20);
         }
+    }
 
-        // Common text
-        menuSprite.setTextSize(1);
-        menuSprite.setTextColor(TFT_WHITE, TFT_BLACK);
-        menuSprite.setCursor(20, 220);
-        menuSprite.print("Click to jump, Double-click to exit");
+    // --- Collision Detection ---
+    GameRect bird = GameEntity_Rect(&flappyBird);
+    if (bird.y < 0 || bird.y + bird.h > SCREEN_HEIGHT) flappyOver = true;
+    for (int i = 0; i < 2; i++) {
+        const GameEntity* pipe = &pipes.items[i];
+        int16_t x = Fix_Floor(pipe->x);
+        GameRect top = {x, 0, PIPE_WIDTH, pipe->value};
+        GameRect bottom = {x, (int16_t)(pipe->value + PIPE_GAP), PIPE_WIDTH, (int16_t)(SCREEN_HEIGHT - pipe->value - PIPE_GAP)};
+        if (Game_Overlap(bird, top) || Game_Overlap(bird, bottom)) flappyOver = true;
+    }
+    if (flappyOver) {
+        tone(BUZZER_PIN, 500, 200);
+        Game_MarkAllDirty();
+    }
+}
 
-        menuSprite.pushSprite(0, 0); // Push buffer to screen
+static void flappyRender(TFT_eSprite& sprite, fix16_t alpha, bool full) {
+    sprite.fillSprite(TFT_BLACK); // Clear buffer
+    sprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    sprite.setTextDatum(TL_DATUM);
 
-        vTaskDelay(pdMS_TO_TICKS(10));
+    if (!flappyStarted) {
+        sprite.setTextSize(2);
+        sprite.setCursor(50, SCREEN_HEIGHT / 2 + 10);
+        sprite.print("Click to start");
+    } else {
+        // Draw Pipes
+        for (int i = 0; i < 2; i++) {
+            const GameEntity* pipe = &pipes.items[i];
+            int16_t x = GameEntity_DrawX(pipe, alpha);
+            int16_t gap = pipe->value;
+            sprite.fillRect(x, 0, PIPE_WIDTH, gap, TFT_GREEN);
+            sprite.fillRect(x - 2, gap - 10, PIPE_WIDTH + 4, 10, TFT_GREEN);
+            sprite.fillRect(x, gap + PIPE_GAP, PIPE_WIDTH, SCREEN_HEIGHT - (gap + PIPE_GAP), TFT_GREEN);
+            sprite.fillRect(x - 2, gap + PIPE_GAP, PIPE_WIDTH + 4, 10, TFT_GREEN);
+            Game_MarkDirty(x - 2, 0, PIPE_WIDTH + 4, SCREEN_HEIGHT);
+        }
+
+        // Draw Bird
+        int16_t y = GameEntity_DrawY(&flappyBird, alpha) + BIRD_RADIUS - 4;
+        sprite.pushImage(BIRD_X - 5, y, 11, 8, bird);
+        Game_MarkDirty(BIRD_X - 5, y, 11, 8);
+
+        // Draw Score
+        sprite.setTextSize(2);
+        sprite.setCursor(10, 10);
+        sprite.printf("Score: %d", flappyScore);
+        Game_MarkDirty(10, 10, 12 * 10, 16);
+
+        if (flappyOver) {
+            sprite.setTextSize(3);
+            sprite.setCursor(40, SCREEN_HEIGHT / 2 - 30);
+            sprite.print("Game Over");
+            sprite.setTextSize(2);
+            sprite.setCursor(50, SCREEN_HEIGHT / 2 + 10);
+            sprite.print("Click to restart");
+        }
     }
+
+    // Common text
+    sprite.setTextSize(1);
+    sprite.setCursor(20, 220);
+    sprite.print("Click to jump, Double-click to exit");
 }
 
+void flappy_bird_game() {
+    static const GameDef flappy = {FLAPPY_STEP_MS, FLAPPY_FRAME_MS, flappyStart, flappyUpdate, flappyRender, NULL};
+    Game_Run(flappy);
+}
@@ -6,10 +6,20 @@
 #include "Menu.h"
 #include "MQTT.h" // For access to menuSprite
 #include <Adafruit_NeoPixel.h>
+#include "Settings.h"
+#include "LedEngine.h"
 
 // Initialize the NeoPixel strip
 Adafruit_NeoPixel strip = Adafruit_NeoPixel(NUM_LEDS, LED_PIN, NEO_GRB + NEO_KHZ800);
 
+// Persisted LED menu state
+#define LED_SETTINGS_VERSION 1
+
+struct LedSettings {
+    uint8_t brightness;
+    uint16_t hue;
+};
+
 // Enum for control modes
 enum ControlMode { BRIGHTNESS_MODE, COLOR_MODE };
 
@@ -69,16 +79,20 @@ void LEDMenu() {
     initRotaryEncoder();
 
     ControlMode currentMode = BRIGHTNESS_MODE;
-    uint8_t brightness = strip.getBrightness();
+    LedSettings saved;
+    if (!Settings_Load(SETTINGS_KEY_LED, LED_SETTINGS_VERSION, &saved, sizeof(saved))) {
+        saved.brightness = LedEngine_Brightness();
+        saved.hue = 0; // Start with red
+    }
+    uint8_t brightness = saved.brightness;
     if (brightness == 0) { // If LEDs were off, start at a visible brightness
         brightness = 128;
     }
-    uint16_t hue = 0; // Start with red
+    uint16_t hue = saved.hue;
 
     // Initial setup
-    strip.setBrightness(brightness);
-    strip.fill(strip.ColorHSV(hue));
-    strip.show();
+    LedEngine_SetBrightness(brightness);
+    LedEngine_Solid(strip.ColorHSV(hue));
 
     // Initial draw
     drawLedControl(brightness, hue, currentMode);
@@ -101,7 +115,7 @@ void LEDMenu() {
                 if (newBrightness < 0) newBrightness = 0;
                 if (newBrightness > 255) newBrightness = 255;
                 brightness = newBrightness;
-                strip.setBrightness(brightness);
+                LedEngine_SetBrightness(brightness);
             } else { // COLOR_MODE
                 // Increased sensitivity for color
                 int newHue = hue + (encoderChange * 2048); 
@@ -121,8 +135,7 @@ void LEDMenu() {
         }
 
         if (needsRedraw) {
-            strip.fill(strip.ColorHSV(hue));
-            strip.show();
+            LedEngine_Solid(strip.ColorHSV(hue));
             drawLedControl(brightness, hue, currentMode);
             menuSprite.pushSprite(0, 0); // Push the complete frame to the screen
             needsRedraw = false;
@@ -130,4 +143,9 @@ void LEDMenu() {
 
         vTaskDelay(pdMS_TO_TICKS(20));
     }
+
+    // Remember the last colour, written only if it changed
+    saved.brightness = brightness;
+    saved.hue = hue;
+    Settings_Save(SETTINGS_KEY_LED, LED_SETTINGS_VERSION, &saved, sizeof(saved));
 }
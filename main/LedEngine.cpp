@@ -0,0 +1,328 @@
+#include "LedEngine.h"
+#include "LED.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <driver/rmt_tx.h>
+
+#define LED_FRAME_BYTES     (NUM_LEDS * 3)
+#define LED_FRAME_MS        (1000 / LED_FRAME_RATE)
+#define LED_IDLE_WAIT_MS    1000    // Static strip: wake this often for layer timeouts
+#define LED_TX_TIMEOUT_MS   10      // A 10 LED frame takes 0.3 ms on the wire
+
+struct LedLayer {
+    LedEffect effect;
+    uint32_t color;
+    uint16_t period_ms;
+    uint32_t duration_ms;
+    uint32_t seq;           // Bumped on every change
+};
+
+// Engine-side state of a layer, engine task only.
+struct LayerState {
+    LedLayer config;
+    uint32_t seen_seq;
+    uint32_t start_ms;
+    uint32_t from;          // FADE start color
+    uint32_t last;          // Color of pixel 0 in the last frame
+};
+
+// --- Shared State (any task writes, engine copies under the lock) ---
+static LedLayer layers[LED_LAYER_COUNT];
+static portMUX_TYPE layers_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint8_t brightness = 255;
+static TaskHandle_t engineTaskHandle = NULL;
+
+// --- Engine State ---
+static LayerState state[LED_LAYER_COUNT];
+static uint8_t frames[2][LED_FRAME_BYTES];  // GRB, as the WS2812 wants it
+static uint8_t front = 0;                   // Frame last handed to RMT
+static bool tx_busy = false;
+static bool frame_valid = false;            // frames[front] has been sent once
+
+// --- RMT ---
+static rmt_channel_handle_t led_channel = NULL;
+static rmt_encoder_handle_t led_encoder = NULL;
+static SemaphoreHandle_t tx_done = NULL;
+
+// =====================================================================================
+//                                  FIXED-POINT HELPERS
+// =====================================================================================
+
+static inline uint8_t scale8(uint8_t v, uint8_t s) {
+    return ((uint16_t)v * (s + 1)) >> 8;
+}
+
+// t = 0 gives a, t = 255 gives b
+static inline uint8_t lerp8(uint8_t a, uint8_t b, uint8_t t) {
+    return ((uint16_t)a * (255 - t) + (uint16_t)b * t + 127) / 255;
+}
+
+static inline uint32_t packRgb(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+static inline uint32_t scaleRgb(uint32_t c, uint8_t s) {
+    return packRgb(scale8(c >> 16, s), scale8(c >> 8, s), scale8(c, s));
+}
+
+static inline uint32_t lerpRgb(uint32_t a, uint32_t b, uint8_t t) {
+    return packRgb(lerp8(a >> 16, b >> 16, t), lerp8(a >> 8, b >> 8, t), lerp8(a, b, t));
+}
+
+// Position inside the period as 0..65535.
+static inline uint16_t phase16(uint32_t elapsed_ms, uint16_t period_ms) {
+    if (period_ms == 0) return 0;
+    return ((elapsed_ms % period_ms) << 16) / period_ms;
+}
+
+// Triangle through cubic smoothstep, then squared as a rough gamma.
+static uint8_t breatheLevel(uint16_t phase) {
+    uint32_t tri = (phase < 32768) ? (phase >> 7) : ((65535 - phase) >> 7);
+    uint32_t smooth = (tri * tri * (765 - 2 * tri)) >> 16;
+    return (smooth * smooth) >> 8;
+}
+
+static uint8_t pulseLevel(uint16_t phase) {
+    uint32_t d = 255 - (phase >> 8);
+    return (d * d) >> 8;
+}
+
+// =====================================================================================
+//                                      RENDERING
+// =====================================================================================
+
+// Color and alpha of one pixel of one layer.
+static void renderPixel(const LayerState& s, uint16_t pixel, uint32_t elapsed, uint32_t* color, uint8_t* alpha) {
+    const LedLayer& c = s.config;
+    switch (c.effect) {
+    case LED_FX_SOLID:
+        *color = c.color;
+        *alpha = 255;
+        break;
+    case LED_FX_FADE: {
+        uint8_t t = (c.period_ms == 0 || elapsed >= c.period_ms) ? 255 : (elapsed * 255) / c.period_ms;
+        *color = lerpRgb(s.from, c.color, t);
+        *alpha = 255;
+        break;
+    }
+    case LED_FX_RAINBOW: {
+        uint16_t hue = phase16(elapsed, c.period_ms) + (uint32_t)pixel * 65536 / NUM_LEDS;
+        *color = Adafruit_NeoPixel::ColorHSV(hue);
+        *alpha = 255;
+        break;
+    }
+    case LED_FX_BREATHE:
+        *color = c.color;
+        *alpha = breatheLevel(phase16(elapsed, c.period_ms));
+        break;
+    case LED_FX_PULSE:
+        *color = c.color;
+        *alpha = pulseLevel(phase16(elapsed, c.period_ms));
+        break;
+    default:
+        *color = 0;
+        *alpha = 0;
+        break;
+    }
+}
+
+// Picks up layer changes and timeouts. Returns true if any layer moves.
+static bool updateLayers(uint32_t now) {
+    LedLayer snapshot[LED_LAYER_COUNT];
+    taskENTER_CRITICAL(&layers_mux);
+    memcpy(snapshot, layers, sizeof(snapshot));
+    taskEXIT_CRITICAL(&layers_mux);
+
+    bool animated = false;
+    for (int l = 0; l < LED_LAYER_COUNT; l++) {
+        LayerState& s = state[l];
+        if (snapshot[l].seq != s.seen_seq) {
+            s.seen_seq = snapshot[l].seq;
+            s.config = snapshot[l];
+            s.start_ms = now;
+            s.from = s.last; // A fade starts from whatever the layer showed
+        }
+        uint32_t elapsed = now - s.start_ms;
+        if (s.config.duration_ms > 0 && elapsed >= s.config.duration_ms) {
+            s.config.effect = LED_FX_OFF;
+        }
+        switch (s.config.effect) {
+        case LED_FX_FADE:
+            if (elapsed < s.config.period_ms) animated = true;
+            break;
+        case LED_FX_RAINBOW:
+        case LED_FX_BREATHE:
+        case LED_FX_PULSE:
+            animated = true;
+            break;
+        default:
+            break;
+        }
+        if (s.config.duration_ms > 0 && s.config.effect != LED_FX_OFF) animated = true;
+    }
+    return animated;
+}
+
+static void renderFrame(uint8_t* frame, uint32_t now) {
+    uint8_t level = brightness;
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        uint8_t r = 0, g = 0, b = 0;
+        for (int l = 0; l < LED_LAYER_COUNT; l++) {
+            LayerState& s = state[l];
+            if (s.config.effect == LED_FX_OFF) {
+                if (i == 0) s.last = 0;
+                continue;
+            }
+            uint32_t color;
+            uint8_t alpha;
+            renderPixel(s, i, now - s.start_ms, &color, &alpha);
+            if (i == 0) s.last = scaleRgb(color, alpha);
+            r = lerp8(r, color >> 16, alpha);
+            g = lerp8(g, color >> 8, alpha);
+            b = lerp8(b, color, alpha);
+        }
+        frame[i * 3 + 0] = scale8(g, level);
+        frame[i * 3 + 1] = scale8(r, level);
+        frame[i * 3 + 2] = scale8(b, level);
+    }
+}
+
+// =====================================================================================
+//                                     RMT OUTPUT
+// =====================================================================================
+
+static bool IRAM_ATTR onTxDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t* event, void* user_ctx) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(tx_done, &woken);
+    return woken == pdTRUE;
+}
+
+static bool setupRmt() {
+    rmt_tx_channel_config_t channel_config = {};
+    channel_config.gpio_num = (gpio_num_t)LED_PIN;
+    channel_config.clk_src = RMT_CLK_SRC_DEFAULT;
+    channel_config.resolution_hz = LED_RMT_RESOLUTION_HZ;
+    channel_config.mem_block_symbols = 48;  // One block on the C3, refilled from the ISR
+    channel_config.trans_queue_depth = 2;
+    if (rmt_new_tx_channel(&channel_config, &led_channel) != ESP_OK) return false;
+
+    // WS2812 bits at 10 MHz: 0.4/0.8 us for a 0, 0.8/0.4 us for a 1
+    rmt_bytes_encoder_config_t encoder_config = {};
+    encoder_config.bit0.level0 = 1;
+    encoder_config.bit0.duration0 = 4;
+    encoder_config.bit0.level1 = 0;
+    encoder_config.bit0.duration1 = 8;
+    encoder_config.bit1.level0 = 1;
+    encoder_config.bit1.duration0 = 8;
+    encoder_config.bit1.level1 = 0;
+    encoder_config.bit1.duration1 = 4;
+    encoder_config.flags.msb_first = 1;
+    if (rmt_new_bytes_encoder(&encoder_config, &led_encoder) != ESP_OK) return false;
+
+    rmt_tx_event_callbacks_t callbacks = {};
+    callbacks.on_trans_done = onTxDone;
+    rmt_tx_register_event_callbacks(led_channel, &callbacks, NULL);
+    return rmt_enable(led_channel) == ESP_OK;
+}
+
+// Returns at once; the done interrupt gives tx_done when the frame is out.
+static void transmit(const uint8_t* frame) {
+    rmt_transmit_config_t tx_config = {};
+    if (rmt_transmit(led_channel, led_encoder, frame, LED_FRAME_BYTES, &tx_config) == ESP_OK) {
+        tx_busy = true;
+    }
+}
+
+// =====================================================================================
+//                                     ENGINE TASK
+// =====================================================================================
+
+// Renders once per frame period, and right away when a layer changes, so an
+// effect started mid-frame (a note, a notification) shows without waiting.
+static void LedEngine_Task(void *pvParameters) {
+    const TickType_t frame_ticks = pdMS_TO_TICKS(LED_FRAME_MS);
+    for (;;) {
+        TickType_t frame_start = xTaskGetTickCount();
+        uint32_t now = millis();
+        bool animated = updateLayers(now);
+        uint8_t back = front ^ 1;
+        renderFrame(frames[back], now);
+
+        bool changed = !frame_valid || memcmp(frames[back], frames[front], LED_FRAME_BYTES) != 0;
+        if (changed) {
+            // A frame is 0.3 ms on the wire, so this rarely waits at all
+            if (tx_busy && xSemaphoreTake(tx_done, pdMS_TO_TICKS(LED_TX_TIMEOUT_MS)) == pdTRUE) {
+                tx_busy = false;
+            }
+            if (!tx_busy) {
+                front = back;
+                frame_valid = true;
+                transmit(frames[front]);
+            }
+        }
+
+        TickType_t wait = pdMS_TO_TICKS(LED_IDLE_WAIT_MS); // Nothing moves: sleep until a layer changes
+        if (animated || changed) {
+            TickType_t spent = xTaskGetTickCount() - frame_start;
+            wait = (spent < frame_ticks) ? frame_ticks - spent : 0;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void LedEngine_Init() {
+    if (engineTaskHandle != NULL) return;
+    tx_done = xSemaphoreCreateBinary();
+    if (!setupRmt()) {
+        Serial.println("LedEngine: RMT setup failed");
+        return;
+    }
+    xTaskCreatePinnedToCore(LedEngine_Task, "LedEngine", 3072, NULL, 2, &engineTaskHandle, 0);
+}
+
+void LedEngine_SetLayer(LedLayerId layer, LedEffect effect, uint32_t color, uint16_t period_ms, uint32_t duration_ms) {
+    if (layer >= LED_LAYER_COUNT) return;
+    taskENTER_CRITICAL(&layers_mux);
+    LedLayer& l = layers[layer];
+    l.effect = effect;
+    l.color = color;
+    l.period_ms = period_ms;
+    l.duration_ms = duration_ms;
+    l.seq++;
+    taskEXIT_CRITICAL(&layers_mux);
+    if (engineTaskHandle != NULL) xTaskNotifyGive(engineTaskHandle);
+}
+
+void LedEngine_SetBrightness(uint8_t level) {
+    brightness = level;
+    if (engineTaskHandle != NULL) xTaskNotifyGive(engineTaskHandle);
+}
+
+uint8_t LedEngine_Brightness() {
+    return brightness;
+}
+
+void LedEngine_Solid(uint32_t color) {
+    LedEngine_SetLayer(LED_LAYER_BASE, LED_FX_SOLID, color);
+}
+
+void LedEngine_Fade(uint32_t color, uint16_t ms) {
+    LedEngine_SetLayer(LED_LAYER_BASE, LED_FX_FADE, color, ms);
+}
+
+void LedEngine_Off() {
+    LedEngine_SetLayer(LED_LAYER_BASE, LED_FX_OFF);
+}
+
+void LedEngine_Notify(uint32_t color, uint16_t period_ms, uint32_t duration_ms) {
+    LedEngine_SetLayer(LED_LAYER_NOTIFY, LED_FX_PULSE, color, period_ms, duration_ms);
+}
+
+void LedEngine_ClearNotify() {
+    LedEngine_SetLayer(LED_LAYER_NOTIFY, LED_FX_OFF);
+}
@@ -0,0 +1,53 @@
+#ifndef LED_ENGINE_H
+#define LED_ENGINE_H
+
+#include <Arduino.h>
+
+// Owns the NeoPixel strip. Callers describe what the LEDs should do as an
+// effect on a layer; the engine task renders all layers at LED_FRAME_RATE in
+// 8-bit fixed point, composites them bottom-up and sends the frame through
+// RMT without waiting. Frames are double-buffered: one is on the wire while
+// the next is rendered, and the RMT done interrupt releases the buffer.
+// Unchanged frames are not sent and a static strip leaves the task asleep.
+// A layer change wakes the engine at once instead of at the next frame.
+#define LED_FRAME_RATE        50        // Hz
+#define LED_RMT_RESOLUTION_HZ 10000000  // 0.1 us per RMT tick
+
+// Bottom to top. Each layer is drawn "over" the ones below with the effect's
+// own level as alpha, so breathe/pulse on an upper layer blend into the base.
+enum LedLayerId : uint8_t {
+    LED_LAYER_BASE = 0,     // Menus, music, animations
+    LED_LAYER_ACCENT,       // Short-lived accents on top of the base
+    LED_LAYER_NOTIFY,       // Alarm and other notifications
+    LED_LAYER_COUNT
+};
+
+enum LedEffect : uint8_t {
+    LED_FX_OFF = 0,         // Transparent
+    LED_FX_SOLID,           // color
+    LED_FX_FADE,            // From what the layer showed to color over period_ms, then holds
+    LED_FX_RAINBOW,         // Hue wheel across the strip, one turn per period_ms
+    LED_FX_BREATHE,         // color, smooth rise and fall every period_ms
+    LED_FX_PULSE,           // color, sharp attack and quadratic decay every period_ms
+};
+
+// Colors are 0x00RRGGBB, the same packing as Adafruit_NeoPixel::Color().
+// duration_ms > 0 turns the layer off again after that long.
+void LedEngine_SetLayer(LedLayerId layer, LedEffect effect, uint32_t color = 0,
+                        uint16_t period_ms = 0, uint32_t duration_ms = 0);
+
+// Starts the RMT channel and the engine task. Call once at boot.
+void LedEngine_Init();
+
+// Applied to the composited frame.
+void LedEngine_SetBrightness(uint8_t brightness);
+uint8_t LedEngine_Brightness();
+
+// Shorthands for the base and notify layers.
+void LedEngine_Solid(uint32_t color);
+void LedEngine_Fade(uint32_t color, uint16_t ms);
+void LedEngine_Off();
+void LedEngine_Notify(uint32_t color, uint16_t period_ms, uint32_t duration_ms);
+void LedEngine_ClearNotify();
+
+#endif // LED_ENGINE_H
@@ -4,6 +4,8 @@
 #include "Menu.h" // Include Menu.h to access the menuItems array
 #include "Buzzer.h"
 #include "System.h" // For TFT logging functions
+#include "MqttSpool.h"
+#include "SensorHub.h"
 
 // --- Configuration ---
 // WiFi Configuration
@@ -15,11 +17,23 @@
 #define MQTT_PORT 9501
 #define CLIENT_ID "f5ff15f6f91348548bd2038e5d54442e" // Please use your own unique client ID
 #define SUB_TOPIC "Light00" // The topic to subscribe to for commands
+#define PUB_TOPIC "Temp004" // Sensor topic, bemfa expects "#value#" payloads
+
+// Telemetry and spool drain pacing
+#define TELEMETRY_INTERVAL_MS   60000
+#define SPOOL_DRAIN_INTERVAL_MS 250   // Drain at most SPOOL_DRAIN_BATCH messages per interval
+#define SPOOL_DRAIN_BATCH       4
+#define MQTT_LOOP_INTERVAL_MS   20
 
 // --- Global Variables ---
 WiFiClient espClient;
 PubSubClient client(espClient);
 long lastMqttReconnectAttempt = 0;
+unsigned long lastTelemetryTime = 0;
+unsigned long lastSpoolDrainTime = 0;
+static TaskHandle_t mqttTaskHandle = NULL;
+static volatile float telemetryTemp = 0.0f;   // Newest good reading, from the hub
+static volatile bool telemetryFresh = false;  // Set since the last telemetry publish
 
 // Definition of the volatile function pointer
 volatile void (*requestedMenuAction)() = nullptr;
@@ -29,28 +43,53 @@ volatile bool exitSubMenu = false; // Definition for the exit flag
 void callback(char* topic, byte* payload, unsigned int length);
 void reconnect();
 void connectMQTT(); // New function for visual MQTT connection
+static void drainSpool();
+static bool publishMQTT(const char* topic, const char* payload);
+static void publishTelemetry();
+static void onTemperature(SensorChannel channel, const SensorSample& sample);
 
 // --- Core Functions ---
 
+// The menus block loop() for as long as a screen is open, so the client
+// gets its own task. Only this task touches the client and the spool reader.
+static void MQTT_Task(void *pvParameters) {
+  while (true) {
+    loopMQTT();
+    vTaskDelay(pdMS_TO_TICKS(MQTT_LOOP_INTERVAL_MS));
+  }
+}
+
 void setupMQTT() {
   // Ensure Serial is initialized if not already
   if (!Serial) {
     Serial.begin(115200);
   }
 
+  MqttSpool_Init(); // Messages are spooled even while offline
+  SensorHub_Subscribe(onTemperature, SENSOR_MASK(SENSOR_DS18B20_TEMP));
+  client.setServer(MQTT_SERVER, MQTT_PORT);
+  client.setCallback(callback);
+
   if (WiFi.status() == WL_CONNECTED) {
     Serial.println("WiFi is connected. Setting up MQTT...");
     Serial.print("IP address: ");
     Serial.println(WiFi.localIP());
-    client.setServer(MQTT_SERVER, MQTT_PORT);
-    client.setCallback(callback);
     connectMQTT(); // Call the new visual connection function
   } else {
-    Serial.println("WiFi not connected, cannot setup MQTT.");
+    Serial.println("WiFi not connected, MQTT will connect once it is.");
+  }
+
+  if (mqttTaskHandle == NULL) {
+    xTaskCreate(MQTT_Task, "MQTT", 6144, NULL, 1, &mqttTaskHandle);
   }
 }
 
 void loopMQTT() {
+  publishTelemetry();
+
+  // No point hammering the broker while WiFi itself is down
+  if (WiFi.status() != WL_CONNECTED) return;
+
   if (!client.connected()) {
     long now = millis();
     // Try to reconnect every 5 seconds without blocking.
@@ -58,11 +97,109 @@ void loopMQTT() {
       lastMqttReconnectAttempt = now;
       reconnect();
     }
+    return;
   }
-} 
+  client.loop();
+  drainSpool();
+}
+
+// Publishes directly when the broker is reachable and nothing is queued,
+// otherwise appends to the LittleFS spool so ordering is preserved.
+// MQTT task only, as it uses the client.
+static bool publishMQTT(const char* topic, const char* payload) {
+  size_t length = strlen(payload);
+  if (client.connected() && MqttSpool_Count() == 0) {
+    if (client.publish(topic, (const uint8_t*)payload, length)) return true;
+  }
+  return MqttSpool_Push(topic, (const uint8_t*)payload, length);
+}
+
+// --- Remote Commands ---
+
+// Shared by every remote transport (MQTT, BLE). A command is "exit", a
+// main-menu name or a song name. Navigation leaves the current screen first;
+// main.ino picks up requestedMenuAction once the submenu has returned.
+bool handleRemoteCommand(const char* command) {
+  String cmd(command);
+  cmd.trim();
+  if (cmd.length() == 0) return false;
+
+  if (cmd.equalsIgnoreCase("exit")) {
+    exitSubMenu = true;
+    return true;
+  }
+
+  for (uint8_t i = 0; i < MENU_ITEM_COUNT; i++) {
+    if (cmd.equalsIgnoreCase(menuItems[i].name)) {
+      requestedMenuAction = (volatile void (*)())menuItems[i].action;
+      exitSubMenu = true;
+      return true;
+    }
+  }
+
+  int songIndex = findSongIndexByName(cmd);
+  if (songIndex >= 0) {
+    setSongToPlay(songIndex);
+    requestedMenuAction = (volatile void (*)())playSpecificSong;
+    exitSubMenu = true;
+    return true;
+  }
+
+  Serial.printf("Unknown command: %s\n", cmd.c_str());
+  return false;
+}
+
+void callback(char* topic, byte* payload, unsigned int length) {
+  char command[64];
+  if (length >= sizeof(command)) length = sizeof(command) - 1;
+  memcpy(command, payload, length);
+  command[length] = '\0';
+  Serial.printf("MQTT [%s]: %s\n", topic, command);
+  handleRemoteCommand(command);
+}
 
 // --- Helper Functions ---
 
+// Forwards spooled messages a few at a time so a long backlog
+// doesn't starve the UI or flood the broker after an outage.
+static void drainSpool() {
+  if (MqttSpool_Count() == 0) return;
+  unsigned long now = millis();
+  if (now - lastSpoolDrainTime < SPOOL_DRAIN_INTERVAL_MS) return;
+  lastSpoolDrainTime = now;
+
+  char topic[SPOOL_MAX_TOPIC + 1];
+  uint8_t payload[SPOOL_MAX_PAYLOAD];
+  size_t length;
+  for (int i = 0; i < SPOOL_DRAIN_BATCH; i++) {
+    if (!MqttSpool_Peek(topic, sizeof(topic), payload, sizeof(payload), &length)) break;
+    if (!client.publish(topic, payload, length)) break; // Keep it for the next round
+    MqttSpool_Pop();
+  }
+}
+
+// Runs on the DS18B20 task: just keeps the value for the next publish.
+static void onTemperature(SensorChannel channel, const SensorSample& sample) {
+  if (sample.value <= -127.0f) return; // Probe failed its read
+  telemetryTemp = sample.value;
+  telemetryFresh = true;
+}
+
+// Publishes only readings that arrived since the last one, so a dead probe
+// stops the telemetry instead of repeating its last value.
+static void publishTelemetry() {
+  unsigned long now = millis();
+  if (lastTelemetryTime != 0 && now - lastTelemetryTime < TELEMETRY_INTERVAL_MS) return;
+  if (!telemetryFresh) return;
+  lastTelemetryTime = now;
+  telemetryFresh = false;
+
+  float temp = telemetryTemp;
+  char payload[16];
+  snprintf(payload, sizeof(payload), "#%.1f#", temp);
+  publishMQTT(PUB_TOPIC, payload);
+}
+
 void reconnect() {
   Serial.print("Attempting MQTT connection...");
   if (client.connect(CLIENT_ID)) {
@@ -8,11 +8,22 @@
 extern volatile void (*requestedMenuAction)();
 extern volatile bool exitSubMenu; // Flag to exit a submenu
 
+// Opens the spool, connects to the broker and starts the MQTT task.
+// Call once WiFi is up.
+void setupMQTT();
+
 // Initializes WiFi and MQTT connection
 void reconnect();
 void connectMQTT(); // New function for visual MQTT connection
 
-// Keeps the MQTT client running, should be called in the main loop
+// Keeps the MQTT client running; the task started by setupMQTT calls it
 void loopMQTT();
 
+// Runs a remote command ("exit", a menu name or a song name).
+// Used by the MQTT subscription and the BLE command characteristic.
+bool handleRemoteCommand(const char* command);
+
+// Only the MQTT task touches the client. Other tasks queue outgoing messages
+// with MqttSpool_Push (MqttSpool.h); the task drains the spool to the broker.
+
 #endif
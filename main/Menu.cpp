@@ -12,12 +12,14 @@
 #include "animation.h"
 #include "Games.h"
 #include "ADC.h"
+#include "Spectrum.h"
 #include "Watchface.h" // <-- ADDED
 #include "MQTT.h"
 #include "MusicMenuLite.h"
 #include "space_menu.h" // <-- ADDED
 #include "Internet.h" // Include for the new Internet menu
 #include <TFT_eSPI.h>
+#include "FixedMath.h"
 // --- Layout Configuration ---
 // Change these values to adjust the menu layout
 static const int ICON_SIZE = 200;     // The size for the icons (e.g., 180x180)
@@ -73,6 +75,7 @@ const MenuItem menuItems[] = {
     {"Games", Games, &GamesMenu},
     {"LED", LED, &LEDMenu},
     {"ADC", ADC, &ADCMenu},
+    {"Spectrum", ADC, &SpectrumMenu},
 };
 // const MenuItem menuItems[] = {
 //     {"Clock", Weather, &weatherMenu},
@@ -104,19 +107,6 @@ enum MenuState {
 static MenuState current_state = MAIN_MENU;
 static const uint8_t ANIMATION_STEPS = 12;
 
-// Easing functions
-float easeOutQuad(float t) {
-    return 1.0f - (1.0f - t) * (1.0f - t);
-}
-
-// New easing function for the 'overshoot' effect
-float easeOutBack(float t) {
-    const float c1 = 1.70158f;
-    const float c3 = c1 + 1.0f;
-    float t_minus_1 = t - 1.0f;
-    return 1.0f + c3 * t_minus_1 * t_minus_1 * t_minus_1 + c1 * t_minus_1 * t_minus_1;
-}
-
 
 
 // Draw main menu
@@ -188,10 +178,10 @@ void showMenu() {
         int16_t target_display = INITIAL_X_OFFSET - (picture_flag * ICON_SPACING);
         
         for (uint8_t i = 0; i <= ANIMATION_STEPS; i++) { // Loop from 0 to ANIMATION_STEPS
-            float t = (float)i / ANIMATION_STEPS; // Progress from 0.0 to 1.0
-            float eased_t = easeOutBack(t); // Apply OVERSHOOT easing
+            fix16_t t = FIX_ONE * i / ANIMATION_STEPS; // Progress from 0 to 1
+            fix16_t eased_t = Fix_EaseOutBack(t); // Apply OVERSHOOT easing
 
-            display = start_display + (target_display - start_display) * eased_t; // Calculate interpolated position
+            display = Fix_Lerp(start_display, target_display, eased_t); // Calculate interpolated position
 
             drawMenuIcons(display);
             vTaskDelay(pdMS_TO_TICKS(20)); // Increased delay for smoother animation
@@ -27,7 +27,6 @@ void showMenu();
 void showMenuConfig();
 void animateMenuTransition(const char *title, bool entering);
 void ui_run_easing(int16_t *current, int16_t target, uint8_t steps);
-float easeOutQuad(float t);
 
 // Function prototypes for individual menu screens
 void CountdownMenu();
@@ -0,0 +1,181 @@
+#include "Mesh3D.h"
+
+// Unit vector towards the light in view space, Q8: up, left and in front
+#define LIGHT_X  (-97)
+#define LIGHT_Y  (-123)
+#define LIGHT_Z  (-202)
+
+// --- Vertex Cache (one mesh per frame) ---
+static const Mesh3D* cached_mesh = NULL;
+static int32_t view_x[MESH3D_MAX_VERTICES];
+static int32_t view_y[MESH3D_MAX_VERTICES];
+static int32_t view_z[MESH3D_MAX_VERTICES];
+static int16_t screen_x[MESH3D_MAX_VERTICES];
+static int16_t screen_y[MESH3D_MAX_VERTICES];
+static bool in_front[MESH3D_MAX_VERTICES];
+
+// --- Face Sort ---
+static uint16_t face_order[MESH3D_MAX_FACES];
+static int32_t face_depth[MESH3D_MAX_FACES];
+static uint16_t face_color[MESH3D_MAX_FACES];
+
+// =====================================================================================
+//                                      MATRICES
+// =====================================================================================
+
+Mat4 Mat4_Identity() {
+    Mat4 r = {};
+    r.m[0][0] = r.m[1][1] = r.m[2][2] = r.m[3][3] = FIX_ONE;
+    return r;
+}
+
+Mat4 Mat4_RotateX(fix_angle_t angle) {
+    Mat4 r = Mat4_Identity();
+    fix16_t s = Fix_Sin(angle), c = Fix_Cos(angle);
+    r.m[1][1] = c; r.m[1][2] = -s;
+    r.m[2][1] = s; r.m[2][2] = c;
+    return r;
+}
+
+Mat4 Mat4_RotateY(fix_angle_t angle) {
+    Mat4 r = Mat4_Identity();
+    fix16_t s = Fix_Sin(angle), c = Fix_Cos(angle);
+    r.m[0][0] = c; r.m[0][2] = s;
+    r.m[2][0] = -s; r.m[2][2] = c;
+    return r;
+}
+
+Mat4 Mat4_RotateZ(fix_angle_t angle) {
+    Mat4 r = Mat4_Identity();
+    fix16_t s = Fix_Sin(angle), c = Fix_Cos(angle);
+    r.m[0][0] = c; r.m[0][1] = -s;
+    r.m[1][0] = s; r.m[1][1] = c;
+    return r;
+}
+
+Mat4 Mat4_Scale(fix16_t s) {
+    Mat4 r = Mat4_Identity();
+    r.m[0][0] = r.m[1][1] = r.m[2][2] = s;
+    return r;
+}
+
+Mat4 Mat4_Translate(fix16_t x, fix16_t y, fix16_t z) {
+    Mat4 r = Mat4_Identity();
+    r.m[0][3] = x;
+    r.m[1][3] = y;
+    r.m[2][3] = z;
+    return r;
+}
+
+Mat4 Mat4_Multiply(const Mat4& a, const Mat4& b) {
+    Mat4 r;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            int64_t sum = 0;
+            for (int k = 0; k < 4; k++) sum += (int64_t)a.m[i][k] * b.m[k][j];
+            r.m[i][j] = (fix16_t)((sum + FIX_HALF) >> 16);
+        }
+    }
+    return r;
+}
+
+// =====================================================================================
+//                                      PIPELINE
+// =====================================================================================
+
+static uint16_t shadeColor(uint16_t color, uint32_t level) {
+    uint32_t r = ((color >> 11) * level) >> 8;
+    uint32_t g = (((color >> 5) & 0x3F) * level) >> 8;
+    uint32_t b = ((color & 0x1F) * level) >> 8;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+bool Mesh3D_Transform(const Mesh3D& mesh, const Mat4& model, const Camera3D& camera) {
+    cached_mesh = NULL;
+    if (mesh.vertex_count > MESH3D_MAX_VERTICES || mesh.face_count > MESH3D_MAX_FACES) return false;
+
+    const fix16_t (*m)[4] = model.m;
+    for (uint16_t i = 0; i < mesh.vertex_count; i++) {
+        int32_t x = mesh.vertices[i * 3];
+        int32_t y = mesh.vertices[i * 3 + 1];
+        int32_t z = mesh.vertices[i * 3 + 2];
+        int32_t vx = (m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3] + FIX_HALF) >> 16;
+        int32_t vy = (m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3] + FIX_HALF) >> 16;
+        int32_t vz = (m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3] + FIX_HALF) >> 16;
+        view_x[i] = vx;
+        view_y[i] = vy;
+        view_z[i] = vz;
+
+        int32_t depth = vz + camera.distance;
+        in_front[i] = depth > 0;
+        if (depth < 1) depth = 1;
+        screen_x[i] = camera.cx + vx * camera.focal / depth;
+        screen_y[i] = camera.cy + vy * camera.focal / depth;
+    }
+    cached_mesh = &mesh;
+    return true;
+}
+
+void Mesh3D_DrawEdges(TFT_eSprite& sprite, uint16_t color) {
+    const Mesh3D* mesh = cached_mesh;
+    if (mesh == NULL || mesh->edges == NULL) return;
+    for (uint16_t e = 0; e < mesh->edge_count; e++) {
+        uint8_t a = mesh->edges[e * 2], b = mesh->edges[e * 2 + 1];
+        if (!in_front[a] || !in_front[b]) continue;
+        sprite.drawLine(screen_x[a], screen_y[a], screen_x[b], screen_y[b], color);
+    }
+}
+
+void Mesh3D_DrawFaces(TFT_eSprite& sprite, uint16_t color, uint8_t ambient) {
+    const Mesh3D* mesh = cached_mesh;
+    if (mesh == NULL || mesh->faces == NULL) return;
+
+    // Cull and shade, collecting the faces that face the viewer
+    uint16_t visible = 0;
+    for (uint16_t f = 0; f < mesh->face_count; f++) {
+        uint8_t a = mesh->faces[f * 3], b = mesh->faces[f * 3 + 1], c = mesh->faces[f * 3 + 2];
+        if (!in_front[a] || !in_front[b] || !in_front[c]) continue;
+        int32_t area = (int32_t)(screen_x[b] - screen_x[a]) * (screen_y[c] - screen_y[a])
+                     - (int32_t)(screen_y[b] - screen_y[a]) * (screen_x[c] - screen_x[a]);
+        if (area >= 0) continue; // Facing away, or edge-on
+
+        int64_t ux = view_x[b] - view_x[a], uy = view_y[b] - view_y[a], uz = view_z[b] - view_z[a];
+        int64_t wx = view_x[c] - view_x[a], wy = view_y[c] - view_y[a], wz = view_z[c] - view_z[a];
+        int64_t nx = uy * wz - uz * wy;
+        int64_t ny = uz * wx - ux * wz;
+        int64_t nz = ux * wy - uy * wx;
+        int64_t dot = nx * LIGHT_X + ny * LIGHT_Y + nz * LIGHT_Z;
+        uint32_t length = Fix_Isqrt((uint64_t)(nx * nx + ny * ny + nz * nz));
+        uint32_t lambert = (dot > 0 && length > 0) ? (uint32_t)(dot / length) : 0; // Q8
+        if (lambert > 256) lambert = 256;
+
+        face_order[visible] = f;
+        face_depth[visible] = view_z[a] + view_z[b] + view_z[c];
+        face_color[visible] = shadeColor(color, ambient + (((256 - ambient) * lambert) >> 8));
+        visible++;
+    }
+
+    // Far to near. Insertion sort: a few dozen to a few hundred faces, and
+    // sorting the colour along keeps the arrays in step.
+    for (uint16_t i = 1; i < visible; i++) {
+        uint16_t order = face_order[i];
+        int32_t depth = face_depth[i];
+        uint16_t shade = face_color[i];
+        int32_t j = i - 1;
+        while (j >= 0 && face_depth[j] < depth) {
+            face_order[j + 1] = face_order[j];
+            face_depth[j + 1] = face_depth[j];
+            face_color[j + 1] = face_color[j];
+            j--;
+        }
+        face_order[j + 1] = order;
+        face_depth[j + 1] = depth;
+        face_color[j + 1] = shade;
+    }
+
+    for (uint16_t i = 0; i < visible; i++) {
+        const uint8_t* idx = &mesh->faces[face_order[i] * 3];
+        sprite.fillTriangle(screen_x[idx[0]], screen_y[idx[0]], screen_x[idx[1]], screen_y[idx[1]],
+                            screen_x[idx[2]], screen_y[idx[2]], face_color[i]);
+    }
+}
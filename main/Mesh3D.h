@@ -0,0 +1,59 @@
+#ifndef MESH3D_H
+#define MESH3D_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "FixedMath.h"
+
+// Small fixed-point 3D pipeline. Meshes are const tables in flash. A frame
+// transforms and projects every vertex once into a cache (Mesh3D_Transform);
+// the draw calls then index the cache instead of redoing the math per edge or
+// face. Solid drawing culls back faces, sorts the rest far to near and fills
+// them flat-shaded.
+//
+// View space is screen aligned: x right, y down, z away from the viewer.
+// Faces list their vertices so that (b - a) x (c - a) points out of the mesh.
+// Keep model coordinates within +-1024 and scales below 4 so the Q16.16
+// transform stays in 32 bits.
+#define MESH3D_MAX_VERTICES  256     // Face and edge indices are bytes
+#define MESH3D_MAX_FACES     512
+
+struct Mesh3D {
+    const int16_t* vertices;    // x, y, z per vertex, model units
+    uint16_t vertex_count;
+    const uint8_t* faces;       // a, b, c per triangle
+    uint16_t face_count;
+    const uint8_t* edges;       // a, b per line, may be NULL
+    uint16_t edge_count;
+};
+
+// Affine transform in Q16.16; the translation column is in model units.
+// Only the top three rows are used, the last is implied (0, 0, 0, 1).
+struct Mat4 {
+    fix16_t m[4][4];
+};
+
+// Perspective: screen = center + focal * view / (view.z + distance).
+struct Camera3D {
+    int16_t cx, cy;             // Screen position of the view axis
+    int16_t focal;              // Pixels per model unit at distance 1
+    int16_t distance;           // Added to view z, puts the mesh in front
+};
+
+Mat4 Mat4_Identity();
+Mat4 Mat4_RotateX(fix_angle_t angle);
+Mat4 Mat4_RotateY(fix_angle_t angle);
+Mat4 Mat4_RotateZ(fix_angle_t angle);
+Mat4 Mat4_Scale(fix16_t s);
+Mat4 Mat4_Translate(fix16_t x, fix16_t y, fix16_t z);
+Mat4 Mat4_Multiply(const Mat4& a, const Mat4& b);   // Applies b, then a
+
+// Fills the vertex cache for this frame. False if the mesh is too large.
+bool Mesh3D_Transform(const Mesh3D& mesh, const Mat4& model, const Camera3D& camera);
+// Draw the cached mesh.
+void Mesh3D_DrawEdges(TFT_eSprite& sprite, uint16_t color);
+// Light comes from the upper left, in front. `ambient` (0..255) is the
+// level a face turned away from the light keeps.
+void Mesh3D_DrawFaces(TFT_eSprite& sprite, uint16_t color, uint8_t ambient);
+
+#endif // MESH3D_H
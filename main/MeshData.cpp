@@ -0,0 +1,94 @@
+#include "MeshData.h"
+
+// Generated: outward winding checked against each face's centroid.
+
+// --- Cube ---
+static const int16_t cube_vertices[] = {
+    -25, -25, -25, 25, -25, -25, 25, 25, -25, -25, 25, -25, -25, -25, 25, 25, -25, 25,
+    25, 25, 25, -25, 25, 25,
+};
+static const uint8_t cube_faces[] = {
+    0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4, 1, 2, 6, 1, 6, 5,
+    2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7,
+};
+static const uint8_t cube_edges[] = {
+    0, 1, 1, 2, 2, 3, 3, 0, 4, 5, 5, 6, 6, 7, 7, 4, 0, 4, 1, 5,
+    2, 6, 3, 7,
+};
+
+// --- Icosahedron ---
+static const int16_t icosahedron_vertices[] = {
+    -32, 51, 0, 32, 51, 0, -32, -51, 0, 32, -51, 0, 0, -32, 51, 0, 32, 51,
+    0, -32, -51, 0, 32, -51, 51, 0, -32, 51, 0, 32, -51, 0, -32, -51, 0, 32,
+};
+static const uint8_t icosahedron_faces[] = {
+    0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2,
+    10, 7, 6, 7, 1, 8, 3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5,
+    2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1,
+};
+static const uint8_t icosahedron_edges[] = {
+    0, 1, 0, 5, 0, 7, 0, 10, 0, 11, 1, 5, 1, 7, 1, 8, 1, 9, 2, 3,
+    2, 4, 2, 6, 2, 10, 2, 11, 3, 4, 3, 6, 3, 8, 3, 9, 4, 5, 4, 9,
+    4, 11, 5, 9, 5, 11, 6, 7, 6, 8, 6, 10, 7, 8, 7, 10, 8, 9, 10, 11,
+};
+
+// --- Globe ---
+static const int16_t globe_vertices[] = {
+    0, -60, 0, 23, -55, 0, 21, -55, 9, 16, -55, 16, 9, -55, 21, 0, -55, 23,
+    -9, -55, 21, -16, -55, 16, -21, -55, 9, -23, -55, 0, -21, -55, -9, -16, -55, -16,
+    -9, -55, -21, 0, -55, -23, 9, -55, -21, 16, -55, -16, 21, -55, -9, 42, -42, 0,
+    39, -42, 16, 30, -42, 30, 16, -42, 39, 0, -42, 42, -16, -42, 39, -30, -42, 30,
+    -39, -42, 16, -42, -42, 0, -39, -42, -16, -30, -42, -30, -16, -42, -39, 0, -42, -42,
+    16, -42, -39, 30, -42, -30, 39, -42, -16, 55, -23, 0, 51, -23, 21, 39, -23, 39,
+    21, -23, 51, 0, -23, 55, -21, -23, 51, -39, -23, 39, -51, -23, 21, -55, -23, 0,
+    -51, -23, -21, -39, -23, -39, -21, -23, -51, 0, -23, -55, 21, -23, -51, 39, -23, -39,
+    51, -23, -21, 60, 0, 0, 55, 0, 23, 42, 0, 42, 23, 0, 55, 0, 0, 60,
+    -23, 0, 55, -42, 0, 42, -55, 0, 23, -60, 0, 0, -55, 0, -23, -42, 0, -42,
+    -23, 0, -55, 0, 0, -60, 23, 0, -55, 42, 0, -42, 55, 0, -23, 55, 23, 0,
+    51, 23, 21, 39, 23, 39, 21, 23, 51, 0, 23, 55, -21, 23, 51, -39, 23, 39,
+    -51, 23, 21, -55, 23, 0, -51, 23, -21, -39, 23, -39, -21, 23, -51, 0, 23, -55,
+    21, 23, -51, 39, 23, -39, 51, 23, -21, 42, 42, 0, 39, 42, 16, 30, 42, 30,
+    16, 42, 39, 0, 42, 42, -16, 42, 39, -30, 42, 30, -39, 42, 16, -42, 42, 0,
+    -39, 42, -16, -30, 42, -30, -16, 42, -39, 0, 42, -42, 16, 42, -39, 30, 42, -30,
+    39, 42, -16, 23, 55, 0, 21, 55, 9, 16, 55, 16, 9, 55, 21, 0, 55, 23,
+    -9, 55, 21, -16, 55, 16, -21, 55, 9, -23, 55, 0, -21, 55, -9, -16, 55, -16,
+    -9, 55, -21, 0, 55, -23, 9, 55, -21, 16, 55, -16, 21, 55, -9, 0, 60, 0,
+};
+static const uint8_t globe_faces[] = {
+    0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5, 0, 5, 6, 0, 6, 7, 0, 7, 8, 0, 8, 9,
+    0, 9, 10, 0, 10, 11, 0, 11, 12, 0, 12, 13, 0, 13, 14, 0, 14, 15, 0, 15, 16, 0, 16, 1,
+    1, 18, 2, 1, 17, 18, 2, 19, 3, 2, 18, 19, 3, 20, 4, 3, 19, 20, 4, 21, 5, 4, 20, 21,
+    5, 22, 6, 5, 21, 22, 6, 23, 7, 6, 22, 23, 7, 24, 8, 7, 23, 24, 8, 25, 9, 8, 24, 25,
+    9, 26, 10, 9, 25, 26, 10, 27, 11, 10, 26, 27, 11, 28, 12, 11, 27, 28, 12, 29, 13, 12, 28, 29,
+    13, 30, 14, 13, 29, 30, 14, 31, 15, 14, 30, 31, 15, 32, 16, 15, 31, 32, 16, 17, 1, 16, 32, 17,
+    17, 34, 18, 17, 33, 34, 18, 35, 19, 18, 34, 35, 19, 36, 20, 19, 35, 36, 20, 37, 21, 20, 36, 37,
+    21, 38, 22, 21, 37, 38, 22, 39, 23, 22, 38, 39, 23, 40, 24, 23, 39, 40, 24, 41, 25, 24, 40, 41,
+    25, 42, 26, 25, 41, 42, 26, 43, 27, 26, 42, 43, 27, 44, 28, 27, 43, 44, 28, 45, 29, 28, 44, 45,
+    29, 46, 30, 29, 45, 46, 30, 47, 31, 30, 46, 47, 31, 48, 32, 31, 47, 48, 32, 33, 17, 32, 48, 33,
+    33, 50, 34, 33, 49, 50, 34, 51, 35, 34, 50, 51, 35, 52, 36, 35, 51, 52, 36, 53, 37, 36, 52, 53,
+    37, 54, 38, 37, 53, 54, 38, 55, 39, 38, 54, 55, 39, 56, 40, 39, 55, 56, 40, 57, 41, 40, 56, 57,
+    41, 58, 42, 41, 57, 58, 42, 59, 43, 42, 58, 59, 43, 60, 44, 43, 59, 60, 44, 61, 45, 44, 60, 61,
+    45, 62, 46, 45, 61, 62, 46, 63, 47, 46, 62, 63, 47, 64, 48, 47, 63, 64, 48, 49, 33, 48, 64, 49,
+    49, 66, 50, 49, 65, 66, 50, 67, 51, 50, 66, 67, 51, 68, 52, 51, 67, 68, 52, 69, 53, 52, 68, 69,
+    53, 70, 54, 53, 69, 70, 54, 71, 55, 54, 70, 71, 55, 72, 56, 55, 71, 72, 56, 73, 57, 56, 72, 73,
+    57, 74, 58, 57, 73, 74, 58, 75, 59, 58, 74, 75, 59, 76, 60, 59, 75, 76, 60, 77, 61, 60, 76, 77,
+    61, 78, 62, 61, 77, 78, 62, 79, 63, 62, 78, 79, 63, 80, 64, 63, 79, 80, 64, 65, 49, 64, 80, 65,
+    65, 82, 66, 65, 81, 82, 66, 83, 67, 66, 82, 83, 67, 84, 68, 67, 83, 84, 68, 85, 69, 68, 84, 85,
+    69, 86, 70, 69, 85, 86, 70, 87, 71, 70, 86, 87, 71, 88, 72, 71, 87, 88, 72, 89, 73, 72, 88, 89,
+    73, 90, 74, 73, 89, 90, 74, 91, 75, 74, 90, 91, 75, 92, 76, 75, 91, 92, 76, 93, 77, 76, 92, 93,
+    77, 94, 78, 77, 93, 94, 78, 95, 79, 78, 94, 95, 79, 96, 80, 79, 95, 96, 80, 81, 65, 80, 96, 81,
+    81, 98, 82, 81, 97, 98, 82, 99, 83, 82, 98, 99, 83, 100, 84, 83, 99, 100, 84, 101, 85, 84, 100, 101,
+    85, 102, 86, 85, 101, 102, 86, 103, 87, 86, 102, 103, 87, 104, 88, 87, 103, 104, 88, 105, 89, 88, 104, 105,
+    89, 106, 90, 89, 105, 106, 90, 107, 91, 90, 106, 107, 91, 108, 92, 91, 107, 108, 92, 109, 93, 92, 108, 109,
+    93, 110, 94, 93, 109, 110, 94, 111, 95, 94, 110, 111, 95, 112, 96, 95, 111, 112, 96, 97, 81, 96, 112, 97,
+    113, 98, 97, 113, 99, 98, 113, 100, 99, 113, 101, 100, 113, 102, 101, 113, 103, 102, 113, 104, 103, 113, 105, 104,
+    113, 106, 105, 113, 107, 106, 113, 108, 107, 113, 109, 108, 113, 110, 109, 113, 111, 110, 113, 112, 111, 113, 97, 112,
+};
+
+#define MESH_ENTRY(name, edges, edge_count) { \
+    name##_vertices, sizeof(name##_vertices) / (3 * sizeof(int16_t)), \
+    name##_faces, sizeof(name##_faces) / 3, edges, edge_count }
+
+const Mesh3D MESH_CUBE = MESH_ENTRY(cube, cube_edges, sizeof(cube_edges) / 2);
+const Mesh3D MESH_ICOSAHEDRON = MESH_ENTRY(icosahedron, icosahedron_edges, sizeof(icosahedron_edges) / 2);
+const Mesh3D MESH_GLOBE = MESH_ENTRY(globe, NULL, 0);
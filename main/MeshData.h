@@ -0,0 +1,12 @@
+#ifndef MESH_DATA_H
+#define MESH_DATA_H
+
+#include "Mesh3D.h"
+
+// Built-in meshes, const so they stay in flash. Model units are pixels at
+// the camera focal distance.
+extern const Mesh3D MESH_CUBE;          // 8 vertices, 12 faces, 12 edges, +-25
+extern const Mesh3D MESH_ICOSAHEDRON;   // 12 vertices, 20 faces, 30 edges, radius 60
+extern const Mesh3D MESH_GLOBE;         // 16 x 8 UV sphere, radius 60, poles on y
+
+#endif // MESH_DATA_H
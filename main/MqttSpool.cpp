@@ -0,0 +1,326 @@
+#include "MqttSpool.h"
+#include <LittleFS.h>
+#include <rom/crc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#define SPOOL_CURSOR_PATH    SPOOL_DIR "/cursor"
+#define SPOOL_RECORD_MAGIC   0x5A
+#define SPOOL_CURSOR_EVERY   16     // Persist the read cursor every N pops
+
+// --- On-flash record layout ---
+// [header][topic bytes][payload bytes], crc covers topic + payload.
+struct SpoolRecordHeader {
+    uint8_t  magic;
+    uint8_t  topic_len;
+    uint16_t payload_len;
+    uint32_t crc;
+};
+
+struct SpoolCursor {
+    uint32_t segment_id;
+    uint32_t offset;
+};
+
+// --- Module-internal State ---
+static SemaphoreHandle_t spool_mutex = NULL;
+static uint32_t tail_id = 0;        // Oldest segment, being drained
+static uint32_t head_id = 0;        // Newest segment, being appended
+static uint32_t head_size = 0;
+static uint32_t read_offset = 0;    // Read position inside the tail segment
+static uint32_t pending_count = 0;
+static uint32_t peeked_size = 0;    // Size of the record returned by the last peek
+static uint8_t pops_since_save = 0;
+
+// =====================================================================================
+//                                     FILE HELPERS
+// =====================================================================================
+
+static void segmentPath(uint32_t id, char* path, size_t size) {
+    snprintf(path, size, "%s/seg_%08u.bin", SPOOL_DIR, (unsigned)id);
+}
+
+static uint32_t recordCrc(const uint8_t* data, size_t length) {
+    return crc32_le(0, data, length);
+}
+
+// Walks a segment from `offset`, counting CRC-valid records.
+// `valid_end` receives the offset just past the last valid record.
+static uint32_t scanSegment(uint32_t id, uint32_t offset, uint32_t* valid_end) {
+    char path[32];
+    segmentPath(id, path, sizeof(path));
+    uint32_t count = 0;
+    if (valid_end) *valid_end = offset;
+
+    File f = LittleFS.open(path, "r");
+    if (!f) return 0;
+    if (!f.seek(offset)) { f.close(); return 0; }
+
+    uint8_t body[SPOOL_MAX_TOPIC + SPOOL_MAX_PAYLOAD];
+    SpoolRecordHeader hdr;
+    while (f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr)) {
+        size_t body_len = hdr.topic_len + hdr.payload_len;
+        if (hdr.magic != SPOOL_RECORD_MAGIC || hdr.topic_len > SPOOL_MAX_TOPIC || hdr.payload_len > SPOOL_MAX_PAYLOAD) break;
+        if (f.read(body, body_len) != body_len) break;
+        if (recordCrc(body, body_len) != hdr.crc) break;
+        offset += sizeof(hdr) + body_len;
+        count++;
+        if (valid_end) *valid_end = offset;
+    }
+    f.close();
+    return count;
+}
+
+static void saveCursor() {
+    SpoolCursor cursor = {tail_id, read_offset};
+    File f = LittleFS.open(SPOOL_CURSOR_PATH, "w");
+    if (f) {
+        f.write((const uint8_t*)&cursor, sizeof(cursor));
+        f.close();
+    }
+    pops_since_save = 0;
+}
+
+// Deletes the tail segment and moves on to the next one.
+static void dropTailSegment() {
+    char path[32];
+    segmentPath(tail_id, path, sizeof(path));
+    LittleFS.remove(path);
+    tail_id++;
+    read_offset = 0;
+    saveCursor();
+}
+
+// Once everything has been published, start over with a fresh segment.
+static void resetIfDrained() {
+    if (tail_id == head_id && read_offset >= head_size && head_size > 0) {
+        dropTailSegment();
+        head_id = tail_id;
+        head_size = 0;
+        pending_count = 0;
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+bool MqttSpool_Init() {
+    if (spool_mutex != NULL) return true;
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("Spool: LittleFS mount failed");
+        return false;
+    }
+    if (!LittleFS.exists(SPOOL_DIR)) {
+        LittleFS.mkdir(SPOOL_DIR);
+    }
+
+    // Find the range of segment ids present on flash
+    bool found = false;
+    uint32_t min_id = 0, max_id = 0;
+    File dir = LittleFS.open(SPOOL_DIR);
+    File entry = dir.openNextFile();
+    while (entry) {
+        const char* name = entry.name();
+        const char* base = strrchr(name, '/');
+        base = base ? base + 1 : name;
+        unsigned id;
+        if (sscanf(base, "seg_%u.bin", &id) == 1) {
+            if (!found || id < min_id) min_id = id;
+            if (!found || id > max_id) max_id = id;
+            found = true;
+        }
+        entry.close();
+        entry = dir.openNextFile();
+    }
+    dir.close();
+
+    // The cursor names the segment being drained before the reboot
+    SpoolCursor cursor;
+    bool have_cursor = false;
+    File cf = LittleFS.open(SPOOL_CURSOR_PATH, "r");
+    if (cf) {
+        have_cursor = cf.read((uint8_t*)&cursor, sizeof(cursor)) == sizeof(cursor);
+        cf.close();
+    }
+
+    // An empty spool carries on after the cursor, so segments written from
+    // now on are never mistaken for ones drained before the reboot
+    uint32_t first_id = have_cursor ? cursor.segment_id : 0;
+    tail_id = found ? min_id : first_id;
+    head_id = found ? max_id : first_id;
+    head_size = 0;
+    read_offset = 0;
+
+    // Restore the read cursor if it still points into the spool. A cursor
+    // past the newest segment is stale (ids were reused), so keep them all.
+    if (found && have_cursor && cursor.segment_id <= head_id) {
+        // Segments older than the cursor were drained before a reboot
+        while (tail_id < cursor.segment_id) {
+            char path[32];
+            segmentPath(tail_id, path, sizeof(path));
+            LittleFS.remove(path);
+            tail_id++;
+        }
+        if (cursor.segment_id == tail_id) read_offset = cursor.offset;
+    }
+    if (!found || !have_cursor || cursor.segment_id != tail_id) saveCursor();
+
+    // Count what is still pending and find where the head really ends
+    pending_count = 0;
+    for (uint32_t id = tail_id; found && id <= head_id; id++) {
+        uint32_t valid_end = 0;
+        pending_count += scanSegment(id, (id == tail_id) ? read_offset : 0, &valid_end);
+        if (id == head_id) head_size = valid_end;
+    }
+
+    // A torn write at the end of the head segment: never append after it
+    if (found) {
+        char path[32];
+        segmentPath(head_id, path, sizeof(path));
+        File hf = LittleFS.open(path, "r");
+        if (hf) {
+            if (hf.size() != head_size) {
+                head_id++;
+                head_size = 0;
+            }
+            hf.close();
+        }
+    }
+
+    spool_mutex = xSemaphoreCreateMutex();
+    Serial.printf("Spool: %u pending, segments %u..%u\n", (unsigned)pending_count, (unsigned)tail_id, (unsigned)head_id);
+    return true;
+}
+
+bool MqttSpool_Push(const char* topic, const uint8_t* payload, size_t length) {
+    if (spool_mutex == NULL) return false;
+    size_t topic_len = strlen(topic);
+    if (topic_len == 0 || topic_len > SPOOL_MAX_TOPIC || length > SPOOL_MAX_PAYLOAD) return false;
+
+    uint8_t record[sizeof(SpoolRecordHeader) + SPOOL_MAX_TOPIC + SPOOL_MAX_PAYLOAD];
+    SpoolRecordHeader hdr;
+    hdr.magic = SPOOL_RECORD_MAGIC;
+    hdr.topic_len = topic_len;
+    hdr.payload_len = length;
+    memcpy(record + sizeof(hdr), topic, topic_len);
+    memcpy(record + sizeof(hdr) + topic_len, payload, length);
+    hdr.crc = recordCrc(record + sizeof(hdr), topic_len + length);
+    memcpy(record, &hdr, sizeof(hdr));
+    size_t record_len = sizeof(hdr) + topic_len + length;
+
+    if (xSemaphoreTake(spool_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+    // Roll over to a new segment when the head is full
+    if (head_size + record_len > SPOOL_SEGMENT_SIZE) {
+        head_id++;
+        head_size = 0;
+    }
+
+    // Oldest-first eviction keeps the spool within its flash budget
+    while (head_id - tail_id + 1 > SPOOL_MAX_SEGMENTS) {
+        uint32_t lost = scanSegment(tail_id, read_offset, NULL);
+        pending_count = (lost < pending_count) ? pending_count - lost : 0;
+        Serial.printf("Spool: full, evicted %u messages\n", (unsigned)lost);
+        dropTailSegment();
+    }
+
+    char path[32];
+    segmentPath(head_id, path, sizeof(path));
+    bool ok = false;
+    File f = LittleFS.open(path, "a");
+    if (f) {
+        ok = (f.write(record, record_len) == record_len);
+        f.close();
+    }
+    if (ok) {
+        head_size += record_len;
+        pending_count++;
+    }
+
+    xSemaphoreGive(spool_mutex);
+    return ok;
+}
+
+bool MqttSpool_Peek(char* topic, size_t topic_size, uint8_t* payload, size_t payload_size, size_t* length) {
+    if (spool_mutex == NULL) return false;
+    if (xSemaphoreTake(spool_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+    bool ok = false;
+    peeked_size = 0;
+    while (!ok) {
+        uint32_t segment_end = head_size;
+        char path[32];
+        segmentPath(tail_id, path, sizeof(path));
+        File f = LittleFS.open(path, "r");
+        if (tail_id != head_id) segment_end = f ? f.size() : 0;
+
+        if (read_offset >= segment_end) {
+            if (f) f.close();
+            if (tail_id == head_id) break; // Nothing left
+            dropTailSegment();
+            continue;
+        }
+
+        SpoolRecordHeader hdr;
+        uint8_t body[SPOOL_MAX_TOPIC + SPOOL_MAX_PAYLOAD];
+        bool valid = f && f.seek(read_offset) && f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr)
+                     && hdr.magic == SPOOL_RECORD_MAGIC
+                     && hdr.topic_len <= SPOOL_MAX_TOPIC && hdr.payload_len <= SPOOL_MAX_PAYLOAD
+                     && f.read(body, hdr.topic_len + hdr.payload_len) == (size_t)(hdr.topic_len + hdr.payload_len)
+                     && recordCrc(body, hdr.topic_len + hdr.payload_len) == hdr.crc;
+        if (f) f.close();
+
+        if (!valid) {
+            // Corrupt record: the rest of this segment cannot be trusted
+            Serial.println("Spool: CRC error, skipping rest of segment");
+            if (tail_id == head_id) {
+                read_offset = head_size;
+                pending_count = 0;
+                break;
+            }
+            dropTailSegment();
+            pending_count = 0;
+            for (uint32_t id = tail_id; id <= head_id; id++) pending_count += scanSegment(id, 0, NULL);
+            continue;
+        }
+
+        if (hdr.topic_len >= topic_size || hdr.payload_len > payload_size) {
+            // Caller buffers too small: drop the message rather than stall the queue
+            read_offset += sizeof(hdr) + hdr.topic_len + hdr.payload_len;
+            if (pending_count > 0) pending_count--;
+            continue;
+        }
+
+        memcpy(topic, body, hdr.topic_len);
+        topic[hdr.topic_len] = '\0';
+        memcpy(payload, body + hdr.topic_len, hdr.payload_len);
+        *length = hdr.payload_len;
+        peeked_size = sizeof(hdr) + hdr.topic_len + hdr.payload_len;
+        ok = true;
+    }
+
+    xSemaphoreGive(spool_mutex);
+    return ok;
+}
+
+void MqttSpool_Pop() {
+    if (spool_mutex == NULL) return;
+    if (xSemaphoreTake(spool_mutex, portMAX_DELAY) != pdTRUE) return;
+
+    if (peeked_size > 0) {
+        read_offset += peeked_size;
+        peeked_size = 0;
+        if (pending_count > 0) pending_count--;
+
+        if (++pops_since_save >= SPOOL_CURSOR_EVERY) saveCursor();
+        resetIfDrained();
+    }
+
+    xSemaphoreGive(spool_mutex);
+}
+
+uint32_t MqttSpool_Count() {
+    return pending_count;
+}
@@ -0,0 +1,32 @@
+#ifndef MQTT_SPOOL_H
+#define MQTT_SPOOL_H
+
+#include <Arduino.h>
+
+// Store-and-forward spool for outgoing MQTT messages.
+// Messages are appended to segment files on LittleFS (/spool/seg_<id>.bin).
+// The oldest segment is deleted when the spool is full, so total flash use is
+// bounded by SPOOL_MAX_SEGMENTS * SPOOL_SEGMENT_SIZE.
+#define SPOOL_DIR            "/spool"
+#define SPOOL_SEGMENT_SIZE   4096   // Bytes per segment file
+#define SPOOL_MAX_SEGMENTS   8      // 32 KB in total
+#define SPOOL_MAX_TOPIC      64
+#define SPOOL_MAX_PAYLOAD    200    // Must fit in PubSubClient's 256-byte packet
+
+// Mounts LittleFS if needed and recovers the spool state from flash.
+bool MqttSpool_Init();
+
+// Appends one message. Evicts the oldest segment when the spool is full.
+bool MqttSpool_Push(const char* topic, const uint8_t* payload, size_t length);
+
+// Reads the oldest pending message without removing it.
+// Returns false if the spool is empty.
+bool MqttSpool_Peek(char* topic, size_t topic_size, uint8_t* payload, size_t payload_size, size_t* length);
+
+// Removes the message returned by the last successful MqttSpool_Peek().
+void MqttSpool_Pop();
+
+// Number of messages waiting to be published.
+uint32_t MqttSpool_Count();
+
+#endif // MQTT_SPOOL_H
@@ -0,0 +1,232 @@
+#include "MusicBank.h"
+#include <LittleFS.h>
+#include <math.h>
+
+// --- On-flash header ---
+struct __attribute__((packed)) MusicBankHeader {
+    char     magic[4];      // "MBNK"
+    uint8_t  version;
+    uint8_t  song_count;
+    uint16_t header_size;
+    uint32_t index_offset;
+    uint32_t data_offset;
+};
+
+// --- Module-internal State ---
+static MusicBankEntry* entries = NULL;
+static int song_count = 0;
+static uint16_t note_freq[128];
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+bool MusicBank_Init() {
+    if (entries != NULL) return true;
+
+    // Same rounding as midi_to_c_array.py: int(440 * 2^((n - 69) / 12))
+    note_freq[0] = 0;
+    for (int n = 1; n < 128; n++) note_freq[n] = (uint16_t)(440.0f * powf(2.0f, (n - 69) / 12.0f));
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("MusicBank: LittleFS mount failed");
+        return false;
+    }
+    File f = LittleFS.open(MUSIC_BANK_PATH, "r");
+    if (!f) {
+        Serial.println("MusicBank: " MUSIC_BANK_PATH " not found, upload the data folder");
+        return false;
+    }
+
+    MusicBankHeader hdr;
+    bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr)
+              && memcmp(hdr.magic, "MBNK", 4) == 0 && hdr.version == MUSIC_BANK_VERSION
+              && f.seek(hdr.index_offset);
+    if (ok) {
+        entries = (MusicBankEntry*)malloc(sizeof(MusicBankEntry) * hdr.song_count);
+        size_t bytes = sizeof(MusicBankEntry) * hdr.song_count;
+        ok = entries != NULL && f.read((uint8_t*)entries, bytes) == bytes;
+    }
+    f.close();
+
+    if (!ok) {
+        Serial.println("MusicBank: invalid bank file");
+        free(entries);
+        entries = NULL;
+        return false;
+    }
+    song_count = hdr.song_count;
+    for (int i = 0; i < song_count; i++) entries[i].name[MUSIC_NAME_LEN - 1] = '\0';
+    Serial.printf("MusicBank: %d songs\n", song_count);
+    return true;
+}
+
+int MusicBank_Count() {
+    return song_count;
+}
+
+const MusicBankEntry* MusicBank_Song(int song) {
+    return (song >= 0 && song < song_count) ? &entries[song] : NULL;
+}
+
+const char* MusicBank_Name(int song) {
+    return (song >= 0 && song < song_count) ? entries[song].name : "";
+}
+
+int MusicBank_FindByName(const char* name) {
+    for (int i = 0; i < song_count; i++) {
+        if (strcasecmp(entries[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+uint16_t MusicBank_NoteFrequency(uint8_t note) {
+    return note_freq[note & 0x7F];
+}
+
+bool MusicBank_Envelope(int song, uint8_t* envelope) {
+    const MusicBankEntry* e = MusicBank_Song(song);
+    memset(envelope, 0, MUSIC_ENVELOPE_LEN);
+    if (e == NULL) return false;
+    File f = LittleFS.open(MUSIC_BANK_PATH, "r");
+    bool ok = f && f.seek(e->envelope_offset) && f.read(envelope, MUSIC_ENVELOPE_LEN) == MUSIC_ENVELOPE_LEN;
+    if (f) f.close();
+    return ok;
+}
+
+// Opens one delta-coded section (notes or events) at the seek point of the
+// step before position_ms. `point` receives the entry used, `step` its index.
+static bool openSection(MusicStream* stream, uint32_t data_offset, uint16_t data_length, uint16_t count,
+                        uint32_t seek_offset, uint16_t seek_count, uint32_t quantum_us,
+                        uint32_t position_ms, MusicSeekPoint* point, uint32_t* step) {
+    stream->file = LittleFS.open(MUSIC_BANK_PATH, "r");
+    if (!stream->file) return false;
+
+    // One table read replaces decoding everything before the position
+    memset(point, 0, sizeof(*point));
+    *step = position_ms / MUSIC_SEEK_STEP_MS;
+    if (*step > 0 && seek_count > 0) {
+        if (*step >= seek_count) *step = seek_count - 1;
+        if (!stream->file.seek(seek_offset + *step * sizeof(MusicSeekPoint))
+            || stream->file.read((uint8_t*)point, sizeof(*point)) != sizeof(*point)
+            || point->data_pos >= data_length || point->note_index >= count) {
+            memset(point, 0, sizeof(*point));
+            *step = 0;
+        }
+    } else {
+        *step = 0;
+    }
+
+    if (!stream->file.seek(data_offset + point->data_pos)) {
+        stream->file.close();
+        return false;
+    }
+    stream->buffer_len = 0;
+    stream->buffer_pos = 0;
+    stream->remaining = data_length - point->data_pos;
+    stream->notes_left = count - point->note_index;
+    stream->prev_units = point->prev_units;
+    stream->quantum_us = quantum_us;
+    return true;
+}
+
+bool MusicBank_Open(MusicStream* stream, int song) {
+    uint32_t start_ms;
+    uint16_t note_index;
+    return MusicBank_OpenAt(stream, song, 0, &start_ms, &note_index);
+}
+
+bool MusicBank_OpenAt(MusicStream* stream, int song, uint32_t position_ms,
+                      uint32_t* note_start_ms, uint16_t* note_index) {
+    const MusicBankEntry* e = MusicBank_Song(song);
+    if (e == NULL) return false;
+    MusicSeekPoint point;
+    uint32_t step;
+    if (!openSection(stream, e->data_offset, e->data_length, e->note_count, e->seek_offset, e->seek_count,
+                     e->quantum_us, position_ms, &point, &step)) {
+        return false;
+    }
+    *note_start_ms = step * MUSIC_SEEK_STEP_MS - point.lead_ms;
+    *note_index = point.note_index;
+    return true;
+}
+
+bool MusicBank_OpenEvents(MusicStream* stream, int song, uint32_t position_ms, uint16_t* note_index) {
+    const MusicBankEntry* e = MusicBank_Song(song);
+    if (e == NULL || e->poly_events == 0) return false;
+    MusicSeekPoint point;
+    uint32_t step;
+    if (!openSection(stream, e->poly_offset, e->poly_length, e->poly_events, e->poly_seek_offset,
+                     e->poly_seek_count, 0, position_ms, &point, &step)) {
+        return false;
+    }
+    stream->prev_units = step * MUSIC_SEEK_STEP_MS - point.lead_ms; // Time of the event before
+    *note_index = point.note_index;
+    return true;
+}
+
+// Next byte of song data, refilling the read-ahead buffer as needed.
+static bool nextByte(MusicStream* s, uint8_t* out) {
+    if (s->buffer_pos >= s->buffer_len) {
+        if (s->remaining == 0) return false;
+        size_t want = (s->remaining < MUSIC_READ_AHEAD) ? s->remaining : MUSIC_READ_AHEAD;
+        size_t got = s->file.read(s->buffer, want);
+        if (got == 0) return false;
+        s->buffer_len = got;
+        s->buffer_pos = 0;
+        s->remaining -= got;
+    }
+    *out = s->buffer[s->buffer_pos++];
+    return true;
+}
+
+// Unsigned LEB128
+static bool readVarint(MusicStream* s, uint32_t* value) {
+    uint8_t b;
+    *value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (!nextByte(s, &b)) return false;
+        *value |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return true;
+}
+
+bool MusicBank_Read(MusicStream* s, MusicNote* note) {
+    if (s->notes_left == 0) return false;
+
+    uint8_t midi;
+    uint32_t zigzag;
+    if (!nextByte(s, &midi) || !readVarint(s, &zigzag)) return false;
+    // Zigzag delta of the duration in quanta
+    int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+    s->prev_units += delta;
+    s->notes_left--;
+
+    note->midi = midi & 0x7F;
+    note->frequency = MusicBank_NoteFrequency(midi);
+    uint32_t ms = (uint64_t)s->prev_units * s->quantum_us / 1000;
+    note->duration_ms = (ms > 0xFFFF) ? 0xFFFF : ms;
+    return true;
+}
+
+bool MusicBank_ReadEvent(MusicStream* s, MusicEvent* event) {
+    uint32_t delta_ms;
+    uint8_t kind;
+    // The track simply ends when its bytes run out
+    if (!readVarint(s, &delta_ms) || !nextByte(s, &kind)) return false;
+    s->prev_units += delta_ms;
+
+    event->time_ms = s->prev_units;
+    event->voice = kind & (MUSIC_MAX_VOICES - 1);
+    event->on = (kind & 0x80) != 0;
+    event->midi = 0;
+    if (event->on && !nextByte(s, &event->midi)) return false;
+    event->midi &= 0x7F;
+    event->frequency = MusicBank_NoteFrequency(event->midi);
+    return true;
+}
+
+void MusicBank_Close(MusicStream* stream) {
+    if (stream->file) stream->file.close();
+}
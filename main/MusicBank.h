@@ -0,0 +1,121 @@
+#ifndef MUSIC_BANK_H
+#define MUSIC_BANK_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+// Songs packed by Music_processed/build_music_bank.py into one LittleFS file.
+// The index (names, lengths, colours) is kept in RAM; notes are streamed from
+// flash through a small read-ahead buffer while a song plays. Each song also
+// carries a seek table and a visualization envelope, both read on demand, and
+// a polyphonic event track for the synth.
+#define MUSIC_BANK_PATH      "/music.bank"
+#define MUSIC_BANK_VERSION   3
+#define MUSIC_NAME_LEN       28
+#define MUSIC_READ_AHEAD     64     // Bytes buffered per open stream
+#define MUSIC_SEEK_STEP_MS   2000   // Seek table resolution, must match SEEK_STEP_MS
+#define MUSIC_ENVELOPE_LEN   110    // Envelope columns, must match ENVELOPE_LEN
+#define MUSIC_MAX_VOICES     4      // Voices in the poly track, must match MAX_VOICES
+
+// On-flash index entry, must match INDEX_FORMAT in build_music_bank.py
+struct __attribute__((packed)) MusicBankEntry {
+    char     name[MUSIC_NAME_LEN];
+    uint32_t data_offset;
+    uint32_t data_length;
+    uint32_t total_ms;
+    uint32_t quantum_us;    // Length of one duration unit
+    uint32_t seek_offset;   // MusicSeekPoint table, one per MUSIC_SEEK_STEP_MS
+    uint32_t envelope_offset;
+    uint32_t poly_offset;   // Event track, see MusicBank_OpenEvents()
+    uint32_t poly_seek_offset;
+    uint32_t poly_total_ms;
+    uint16_t note_count;
+    uint16_t seek_count;
+    uint16_t poly_length;
+    uint16_t poly_events;
+    uint16_t poly_seek_count;
+    uint8_t  color_scheme;
+    uint8_t  min_note;      // Lowest/highest audible MIDI note
+    uint8_t  max_note;
+    uint8_t  voices;        // Voices used by the poly track
+    uint8_t  reserved[2];
+};
+static_assert(sizeof(MusicBankEntry) == 80, "MusicBankEntry must match INDEX_FORMAT");
+
+// Decoder state at the note sounding at a multiple of MUSIC_SEEK_STEP_MS,
+// must match SEEK_FORMAT in build_music_bank.py
+struct __attribute__((packed)) MusicSeekPoint {
+    uint16_t note_index;
+    uint16_t data_pos;      // Offset into the song's note data
+    uint16_t prev_units;    // Duration of the note before, for the delta decoder
+    uint16_t lead_ms;       // How far into that note the step time falls
+};
+static_assert(sizeof(MusicSeekPoint) == 8, "MusicSeekPoint must match SEEK_FORMAT");
+
+struct MusicNote {
+    uint16_t frequency;     // Hz, 0 = rest
+    uint16_t duration_ms;
+    uint8_t  midi;          // MIDI note number, 0 = rest
+};
+
+// One note-on or note-off of the poly track
+struct MusicEvent {
+    uint32_t time_ms;       // From the start of the song
+    uint16_t frequency;     // Note on only
+    uint8_t  midi;
+    uint8_t  voice;
+    bool     on;
+};
+
+// Sequential reader for one song's notes or events. Both are delta-coded, so
+// a stream can only move forward; reopen it to start over.
+struct MusicStream {
+    File     file;
+    uint8_t  buffer[MUSIC_READ_AHEAD];
+    uint8_t  buffer_len;
+    uint8_t  buffer_pos;
+    uint32_t remaining;     // Bytes of song data not yet buffered
+    uint16_t notes_left;    // Notes or events
+    uint32_t prev_units;    // Previous duration, or previous event time in ms
+    uint32_t quantum_us;
+};
+
+// Mounts LittleFS if needed and loads the bank index.
+bool MusicBank_Init();
+
+// Number of songs, 0 if the bank is missing.
+int MusicBank_Count();
+
+// Index entry of a song, or NULL if out of range.
+const MusicBankEntry* MusicBank_Song(int song);
+
+// Song name, "" if out of range.
+const char* MusicBank_Name(int song);
+
+// Case-insensitive lookup by name, -1 if not found.
+int MusicBank_FindByName(const char* name);
+
+// Frequency in Hz of a MIDI note number (0 = rest).
+uint16_t MusicBank_NoteFrequency(uint8_t note);
+
+// Highest MIDI note in each of MUSIC_ENVELOPE_LEN equal slices of the song.
+bool MusicBank_Envelope(int song, uint8_t* envelope);
+
+bool MusicBank_Open(MusicStream* stream, int song);
+// Opens a song at the note sounding at position_ms or a little before it:
+// at most MUSIC_SEEK_STEP_MS of notes have to be read to reach the position.
+// note_start_ms/note_index receive where the next MusicBank_Read() starts.
+bool MusicBank_OpenAt(MusicStream* stream, int song, uint32_t position_ms,
+                      uint32_t* note_start_ms, uint16_t* note_index);
+
+// Opens the poly track at the first event at or after the seek step before
+// position_ms. note_index receives the number of note-ons skipped. Notes
+// still held across that point are not replayed.
+bool MusicBank_OpenEvents(MusicStream* stream, int song, uint32_t position_ms, uint16_t* note_index);
+// Reads the next event. Returns false at the end of the track.
+bool MusicBank_ReadEvent(MusicStream* stream, MusicEvent* event);
+// Reads the next note. Returns false at the end of the song.
+bool MusicBank_Read(MusicStream* stream, MusicNote* note);
+void MusicBank_Close(MusicStream* stream);
+
+#endif // MUSIC_BANK_H
@@ -1,6 +1,8 @@
 #include "MusicMenuLite.h"
 #include "Alarm.h"
-#include "Buzzer.h" // For song definitions, numSongs, PlayMode enum
+#include "Buzzer.h" // For PlayMode enum and BUZZER_PIN
+#include "MusicBank.h"
+#include "NoteSequencer.h"
 #include "RotaryEncoder.h"
 #include "Menu.h"
 #include "weather.h" // for getLocalTime
@@ -15,17 +17,12 @@ static const int num_song_colors = sizeof(song_colors) / sizeof(song_colors[0]);
 
 // --- Task and State Management ---
 static TaskHandle_t musicLiteTaskHandle = NULL;
-static volatile bool stopMusicLiteTask = false;
 static volatile bool isPaused = false;
 
 // --- Shared state between UI and Playback Task ---
+// Position and the current note come from the sequencer (NoteSequencer.h)
 static volatile int shared_song_index = 0;
-static volatile int shared_note_index = 0;
-static volatile int shared_total_notes = 0;
 static volatile PlayMode shared_play_mode = LIST_LOOP;
-static volatile TickType_t current_note_start_tick = 0; // Time when the current note started playing
-static volatile int shared_current_note_duration = 0;
-static volatile int shared_current_note_frequency = 0;
 
 // --- Forward Declarations ---
 static void MusicLite_Playback_Task(void *pvParameters);
@@ -33,33 +30,11 @@ static void displaySongList_Lite(int selectedIndex, int displayOffset);
 static void displayPlayingScreen_Lite(uint16_t progress_bar_color);
 static void stop_lite_playback();
 static uint32_t calculateSongDuration_ms(int songIndex);
-static uint32_t calculateElapsedTime_ms();
 
 // --- Helper Functions ---
 static uint32_t calculateSongDuration_ms(int songIndex) {
-    if (songIndex < 0 || songIndex >= numSongs) return 0;
-    Song song;
-    memcpy_P(&song, &songs[songIndex], sizeof(Song));
-    uint32_t total_ms = 0;
-    for (int i = 0; i < song.length; i++) {
-        total_ms += pgm_read_word(song.durations + i);
-    }
-    return total_ms;
-}
-
-static uint32_t calculateElapsedTime_ms() {
-    if (shared_song_index < 0 || shared_song_index >= numSongs) return 0;
-    Song song;
-    memcpy_P(&song, &songs[shared_song_index], sizeof(Song));
-    uint32_t elapsed_ms = 0;
-    // Sum of durations of already played notes
-    for (int i = 0; i < shared_note_index; i++) {
-        elapsed_ms += pgm_read_word(song.durations + i);
-    }
-    // Add time elapsed in the current note
-    TickType_t current_note_elapsed_ticks = xTaskGetTickCount() - current_note_start_tick;
-    elapsed_ms += (current_note_elapsed_ticks * 1000) / configTICK_RATE_HZ;
-    return elapsed_ms;
+    const MusicBankEntry* song = MusicBank_Song(songIndex);
+    return song ? song->total_ms : 0;
 }
 
 
@@ -69,51 +44,17 @@ void MusicLite_Playback_Task(void *pvParameters) {
 
     for (;;) { // Infinite loop to handle song changes
         shared_song_index = songIndex;
-        Song song;
-        memcpy_P(&song, &songs[songIndex], sizeof(Song));
-        shared_total_notes = song.length;
-        shared_note_index = 0;
-
-        for (int i = 0; i < song.length; i++) {
-            if (stopMusicLiteTask) {
-                noTone(BUZZER_PIN);
-                vTaskDelete(NULL);
-            }
-
-            while (isPaused) {
-                if (stopMusicLiteTask) {
-                    noTone(BUZZER_PIN);
-                    vTaskDelete(NULL);
-                }
-                noTone(BUZZER_PIN);
-                shared_current_note_duration = 0;
-                shared_current_note_frequency = 0;
-                current_note_start_tick = xTaskGetTickCount(); // Reset start tick while paused
-                vTaskDelay(pdMS_TO_TICKS(50));
-            }
-
-            shared_note_index = i;
-            current_note_start_tick = xTaskGetTickCount();
-            int note = pgm_read_word(song.melody + i);
-            int duration = pgm_read_word(song.durations + i);
-
-            shared_current_note_duration = duration;
-            shared_current_note_frequency = note;
-
-            if (note > 0) {
-                tone(BUZZER_PIN, note, duration);
-            }
-            
-            vTaskDelay(pdMS_TO_TICKS(duration));
+        if (Sequencer_Play(songIndex)) {
+            // Stopped or replaced: stay parked until stop_lite_playback() deletes us
+            while (Sequencer_WaitEnd() != SEQ_END_FINISHED) {}
         }
-        
-        shared_current_note_duration = 0;
-        shared_current_note_frequency = 0;
 
         // Pause for 2 seconds before playing the next song
         vTaskDelay(pdMS_TO_TICKS(2000));
 
         // Song finished, select next one based on play mode
+        int numSongs = MusicBank_Count();
+        if (numSongs == 0) continue;
         if (shared_play_mode == SINGLE_LOOP) {
             // Just repeat the same song index
         } else if (shared_play_mode == LIST_LOOP) {
@@ -130,13 +71,13 @@ void MusicLite_Playback_Task(void *pvParameters) {
 }
 
 void stop_lite_playback() {
+    Sequencer_Stop(); // Before deleting the task that waits on it
     if (musicLiteTaskHandle != NULL) {
         vTaskDelete(musicLiteTaskHandle);
         musicLiteTaskHandle = NULL;
     }
     noTone(BUZZER_PIN);
     isPaused = false;
-    stopMusicLiteTask = false; // Reset flag for cleanliness
 }
 
 // --- UI Drawing Functions ---
@@ -150,7 +91,7 @@ void displaySongList_Lite(int selectedIndex, int displayOffset) {
   const int visibleSongs = 3;
   for (int i = 0; i < visibleSongs; i++) {
     int songIdx = displayOffset + i;
-    if (songIdx >= numSongs) break;
+    if (songIdx >= MusicBank_Count()) break;
    
     int yPos = 60 + i * 50;
     
@@ -159,13 +100,13 @@ void displaySongList_Lite(int selectedIndex, int displayOffset) {
       menuSprite.setTextSize(2);
       menuSprite.setTextColor(TFT_WHITE, 0x001F);
       menuSprite.setTextDatum(MC_DATUM);
-      menuSprite.drawString(songs[songIdx].name, 120, yPos);
+      menuSprite.drawString(MusicBank_Name(songIdx), 120, yPos);
     } else {
       menuSprite.fillRoundRect(10, yPos - 18, 220, 36, 5, TFT_BLACK);
       menuSprite.setTextSize(1);
       menuSprite.setTextColor(TFT_WHITE, TFT_BLACK);
       menuSprite.setTextDatum(MC_DATUM);
-      menuSprite.drawString(songs[songIdx].name, 120, yPos);
+      menuSprite.drawString(MusicBank_Name(songIdx), 120, yPos);
     }
   }
   
@@ -174,7 +115,7 @@ void displaySongList_Lite(int selectedIndex, int displayOffset) {
 }
 
 void displayPlayingScreen_Lite(uint16_t progress_bar_color) {
-    uint32_t elapsed_ms = calculateElapsedTime_ms();
+    uint32_t elapsed_ms = Sequencer_PositionMs();
     uint32_t total_ms = calculateSongDuration_ms(shared_song_index);
 
     menuSprite.fillScreen(TFT_BLACK);
@@ -183,11 +124,12 @@ void displayPlayingScreen_Lite(uint16_t progress_bar_color) {
 
     // Song Name
     menuSprite.setTextSize(2);
-    menuSprite.drawString(songs[shared_song_index].name, 120, 20);
+    menuSprite.drawString(MusicBank_Name(shared_song_index), 120, 20);
 
     // Note Info
     char noteInfoStr[30];
-    snprintf(noteInfoStr, sizeof(noteInfoStr), "%d Hz  %d ms", shared_current_note_frequency, shared_current_note_duration);
+    int note_freq = Sequencer_NoteFrequency();
+    snprintf(noteInfoStr, sizeof(noteInfoStr), "%d Hz  %d ms", note_freq, note_freq > 0 ? Sequencer_NoteDuration() : 0);
     menuSprite.setTextSize(2);
     menuSprite.drawString(noteInfoStr, 120, 50);
 
@@ -234,9 +176,10 @@ void displayPlayingScreen_Lite(uint16_t progress_bar_color) {
     menuSprite.drawString(time_buf, 120, 190);
 
     // Note Count Display
+    const MusicBankEntry* song = MusicBank_Song(shared_song_index);
     char note_count_buf[20];
     snprintf(note_count_buf, sizeof(note_count_buf), "%d / %d",
-             shared_note_index + 1, shared_total_notes); // +1 because shared_note_index is 0-based
+             Sequencer_NoteIndex() + 1, song ? song->note_count : 0); // +1 because the note index is 0-based
     menuSprite.setTextSize(2);
     menuSprite.drawString(note_count_buf, 120, 210);
 
@@ -248,6 +191,8 @@ void MusicMenuLite() {
     int selectedSongIndex = 0;
     int displayOffset = 0;
     const int visibleSongs = 3;
+    const int numSongs = MusicBank_Count();
+    if (numSongs == 0) return; // No music bank on flash
 
     // --- Song Selection Loop ---
     displaySongList_Lite(selectedSongIndex, displayOffset);
@@ -278,7 +223,6 @@ void MusicMenuLite() {
     }
 
     // --- Playback UI Loop ---
-    stopMusicLiteTask = false;
     isPaused = false;
     shared_play_mode = LIST_LOOP; // Default to list loop
     xTaskCreatePinnedToCore(MusicLite_Playback_Task, "MusicLite_Playback_Task", 4096, &selectedSongIndex, 2, &musicLiteTaskHandle, 0);
@@ -299,6 +243,7 @@ void MusicMenuLite() {
 
         if (readButton()) {
             isPaused = !isPaused;
+            Sequencer_SetPaused(isPaused);
             tone(BUZZER_PIN, 1000, 50);
             lastScreenUpdateTime = 0; // Force screen update
         }
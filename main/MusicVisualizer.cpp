@@ -0,0 +1,217 @@
+#include "MusicVisualizer.h"
+#include "NoteSequencer.h"
+#include "LedEngine.h"
+#include "LED.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+
+#define VIZ_MAX_VOICES       8
+#define VIZ_NO_CLASS         0xFF
+#define VIZ_BASE_LEVEL       90     // Base colour brightness, beats pulse above it
+#define VIZ_COLOR_FADE_MS    60
+#define VIZ_FADE_OUT_MS      300
+#define VIZ_PULSE_MAX_MS     400
+
+// Upper edge of each pitch class, in Hz * 16, one octave up from C4 and
+// halfway between semitones. Frequencies are folded into this octave first.
+static const uint16_t classEdges[VIZ_PITCH_CLASSES] = {
+    4309, 4565, 4836, 5124, 5429, 5751, 6093, 6456, 6840, 7246, 7677, 8134
+};
+
+// --- Listener ---
+static QueueHandle_t eventQueue = NULL;     // Kept for the life of the program
+static TaskHandle_t vizTaskHandle = NULL;
+
+// --- Note State (listener writes, UI reads single bytes and words) ---
+static volatile uint8_t held[VIZ_PITCH_CLASSES];
+static volatile uint32_t released_ms[VIZ_PITCH_CLASSES];
+static uint8_t voice_class[VIZ_MAX_VOICES];
+static uint16_t voice_frequency[VIZ_MAX_VOICES];
+
+// --- Beat Detector (listener only, except the results) ---
+static uint32_t onset_ms = 0;               // Start of the current onset group
+static uint8_t onset_strength = 0;
+static bool onset_was_beat = false;
+static uint16_t avg_strength_q4 = 16;       // Running mean of onset strengths
+static uint32_t last_beat_ms = 0;
+static volatile uint16_t beat_period_ms = 0;
+static volatile uint32_t beat_count = 0;
+static uint32_t melody_color = 0;
+
+// =====================================================================================
+//                                      ANALYSIS
+// =====================================================================================
+
+static uint8_t pitchClass(uint16_t frequency) {
+    if (frequency == 0) return VIZ_NO_CLASS;
+    uint32_t x = (uint32_t)frequency << 4;
+    while (x >= classEdges[VIZ_PITCH_CLASSES - 1]) x >>= 1;
+    while (x < classEdges[VIZ_PITCH_CLASSES - 1] / 2) x <<= 1;
+    uint8_t pc = 0;
+    while (pc < VIZ_PITCH_CLASSES - 1 && x >= classEdges[pc]) pc++;
+    return pc;
+}
+
+static uint32_t dimColor(uint32_t color, uint8_t level) {
+    uint32_t r = ((color >> 16) & 0xFF) * level / 255;
+    uint32_t g = ((color >> 8) & 0xFF) * level / 255;
+    uint32_t b = (color & 0xFF) * level / 255;
+    return (r << 16) | (g << 8) | b;
+}
+
+static void releaseClass(uint8_t pc, uint32_t now) {
+    if (pc == VIZ_NO_CLASS) return;
+    if (held[pc] > 0) held[pc] = held[pc] - 1;
+    released_ms[pc] = now;
+}
+
+static void onBeat(uint32_t color) {
+    uint16_t pulse_ms = beat_period_ms ? beat_period_ms : VIZ_PULSE_MAX_MS;
+    if (pulse_ms > VIZ_PULSE_MAX_MS) pulse_ms = VIZ_PULSE_MAX_MS;
+    LedEngine_SetLayer(LED_LAYER_ACCENT, LED_FX_PULSE, color, pulse_ms, pulse_ms);
+}
+
+// Onsets are note-ons, chords counted as one with a strength of one per note.
+// Buzzer songs are single notes, so longer notes count as stronger. An onset
+// is a beat if it is at least as strong as usual and far enough from the last
+// beat, or if a beat is overdue.
+static void onNoteOn(const SeqNoteEvent& e, uint32_t now) {
+    uint8_t weight = 1 + ((e.duration_ms > 0) ? e.duration_ms / 250 : 0);
+    if (weight > 4) weight = 4;
+    if (now - onset_ms <= VIZ_CHORD_MS) {
+        onset_strength += weight;
+    } else {
+        avg_strength_q4 += (((int)onset_strength << 4) - (int)avg_strength_q4) / 8;
+        onset_ms = now;
+        onset_strength = weight;
+        onset_was_beat = false;
+    }
+    if (onset_was_beat) return;
+
+    uint32_t since = now - last_beat_ms;
+    uint32_t period = beat_period_ms;
+    uint32_t min_gap = period ? period * 7 / 10 : VIZ_MIN_BEAT_MS;
+    if (beat_count > 0 && since < min_gap) return;
+    bool overdue = period && since > period * 13 / 10;
+    if (((uint16_t)onset_strength << 4) < avg_strength_q4 && !overdue) return;
+
+    if (beat_count > 0 && since >= VIZ_MIN_BEAT_MS && since <= VIZ_MAX_BEAT_MS) {
+        beat_period_ms = period ? (period * 3 + since) / 4 : since;
+    }
+    last_beat_ms = now;
+    beat_count = beat_count + 1;
+    onset_was_beat = true;
+    onBeat(melody_color ? melody_color : Adafruit_NeoPixel::ColorHSV(0));
+}
+
+// Timed from when the note sounded, not when it was dequeued, so queueing
+// delay doesn't jitter the beat period. Kept on the millis() clock, which
+// MusicViz_PitchLevels compares released_ms against.
+static void handleEvent(const SeqNoteEvent& e) {
+    uint32_t age_us = (uint32_t)esp_timer_get_time() - e.time_us;
+    uint32_t now = millis() - age_us / 1000;
+    if (e.voice == SEQ_VOICE_ALL) {
+        for (int v = 0; v < VIZ_MAX_VOICES; v++) {
+            voice_class[v] = VIZ_NO_CLASS;
+            voice_frequency[v] = 0;
+        }
+        for (int pc = 0; pc < VIZ_PITCH_CLASSES; pc++) {
+            if (held[pc] > 0) released_ms[pc] = now;
+            held[pc] = 0;
+        }
+        LedEngine_Fade(0, VIZ_FADE_OUT_MS);
+        return;
+    }
+
+    uint8_t voice = (e.voice < VIZ_MAX_VOICES) ? e.voice : VIZ_MAX_VOICES - 1;
+    // A new note on a voice, or a rest, ends the voice's previous note
+    releaseClass(voice_class[voice], now);
+    voice_class[voice] = VIZ_NO_CLASS;
+    voice_frequency[voice] = 0;
+    if (!e.on) return;
+
+    uint8_t pc = pitchClass(e.frequency);
+    voice_class[voice] = pc;
+    voice_frequency[voice] = e.frequency;
+    held[pc] = held[pc] + 1;
+
+    // Voices are allocated by the bank builder, not by part, so the melody is
+    // taken to be the highest note sounding
+    bool highest = true;
+    for (int v = 0; v < VIZ_MAX_VOICES; v++) {
+        if (voice_frequency[v] > e.frequency) highest = false;
+    }
+    if (highest) {
+        melody_color = Adafruit_NeoPixel::ColorHSV((uint32_t)pc * 65536 / VIZ_PITCH_CLASSES);
+        LedEngine_Fade(dimColor(melody_color, VIZ_BASE_LEVEL), VIZ_COLOR_FADE_MS);
+    }
+    onNoteOn(e, now);
+}
+
+static void MusicViz_Task(void *pvParameters) {
+    SeqNoteEvent event;
+    for (;;) {
+        if (xQueueReceive(eventQueue, &event, portMAX_DELAY) == pdTRUE) {
+            handleEvent(event);
+        }
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void MusicViz_Start() {
+    if (eventQueue == NULL) {
+        eventQueue = xQueueCreate(VIZ_QUEUE_LEN, sizeof(SeqNoteEvent));
+        // Above the UI so events are handled as they arrive
+        xTaskCreatePinnedToCore(MusicViz_Task, "MusicViz", 2048, NULL, 2, &vizTaskHandle, 0);
+    }
+    xQueueReset(eventQueue);
+    for (int v = 0; v < VIZ_MAX_VOICES; v++) {
+        voice_class[v] = VIZ_NO_CLASS;
+        voice_frequency[v] = 0;
+    }
+    for (int pc = 0; pc < VIZ_PITCH_CLASSES; pc++) {
+        held[pc] = 0;
+        released_ms[pc] = 0;
+    }
+    onset_ms = 0;
+    onset_strength = 0;
+    avg_strength_q4 = 16;
+    last_beat_ms = 0;
+    beat_period_ms = 0;
+    beat_count = 0;
+    melody_color = 0;
+    Sequencer_AddListener(eventQueue);
+}
+
+void MusicViz_Stop() {
+    if (eventQueue == NULL) return;
+    Sequencer_RemoveListener(eventQueue);
+    LedEngine_SetLayer(LED_LAYER_ACCENT, LED_FX_OFF);
+    LedEngine_Fade(0, VIZ_FADE_OUT_MS);
+}
+
+void MusicViz_PitchLevels(uint8_t levels[VIZ_PITCH_CLASSES]) {
+    uint32_t now = millis();
+    for (int pc = 0; pc < VIZ_PITCH_CLASSES; pc++) {
+        if (held[pc] > 0) {
+            levels[pc] = 255;
+            continue;
+        }
+        uint32_t since = now - released_ms[pc];
+        levels[pc] = (released_ms[pc] == 0 || since >= VIZ_RELEASE_MS) ? 0 : 255 - since * 255 / VIZ_RELEASE_MS;
+    }
+}
+
+uint16_t MusicViz_Bpm() {
+    uint16_t period = beat_period_ms;
+    return period ? 60000 / period : 0;
+}
+
+uint32_t MusicViz_Beats() {
+    return beat_count;
+}
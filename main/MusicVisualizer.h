@@ -0,0 +1,29 @@
+#ifndef MUSIC_VISUALIZER_H
+#define MUSIC_VISUALIZER_H
+
+#include <Arduino.h>
+
+// Follows the sequencer's note events instead of polling its state.
+// A listener task blocks on the event queue and, per event, updates the
+// pitch-class levels for the on-screen bars, runs an onset-based beat
+// detector and steers the LED engine: the top note sets the base colour and
+// every beat pulses the accent layer. An event reaches the LEDs within one
+// wake of the listener and the LED engine, well inside a 20 ms frame.
+#define VIZ_QUEUE_LEN        32
+#define VIZ_PITCH_CLASSES    12     // C = 0 .. B = 11
+#define VIZ_RELEASE_MS       400    // A released note's bar falls to zero in this time
+#define VIZ_CHORD_MS         30     // Note-ons this close together are one onset
+#define VIZ_MIN_BEAT_MS      300    // 200 BPM
+#define VIZ_MAX_BEAT_MS      1500   // 40 BPM
+
+// Starts listening to the sequencer. The listener task is created on first use.
+void MusicViz_Start();
+// Stops listening and fades the LEDs out.
+void MusicViz_Stop();
+
+// 0..255 per pitch class: full while held, then falling over VIZ_RELEASE_MS.
+void MusicViz_PitchLevels(uint8_t levels[VIZ_PITCH_CLASSES]);
+uint16_t MusicViz_Bpm();        // 0 until two beats were seen
+uint32_t MusicViz_Beats();      // Since MusicViz_Start()
+
+#endif // MUSIC_VISUALIZER_H
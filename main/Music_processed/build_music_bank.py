@@ -0,0 +1,322 @@
+# 音乐库打包工具
+# Packs the songs in this folder into one compact music bank for LittleFS.
+# Run from this folder, then upload main/data with the LittleFS uploader:
+#   python build_music_bank.py            -> ../data/music.bank
+#
+# Notes are read from each song's .mid file (same note extraction as
+# midi_to_c_array.py). Songs without a .mid, or when mido is missing, fall
+# back to the melody_/durations_ arrays in the matching .h file.
+#
+# Bank layout (little-endian, must match MusicBank.h):
+#   header  16 B  "MBNK", version, song count, index offset, data offset
+#   index   80 B per song, see INDEX_FORMAT
+#   data    per note: uint8 MIDI note (0 = rest),
+#           zigzag varint of (duration units - previous duration units)
+#   seek    per song, one SEEK_FORMAT entry every SEEK_STEP_MS of playback:
+#           decoder state at the note playing at that time
+#   envelope per song, ENVELOPE_LEN bytes: highest MIDI note in each slice of
+#           the song's length, drawn by the player as its visualization
+#   poly    per song, the notes at their real start times on up to MAX_VOICES
+#           voices for the synth, as time-ordered events:
+#           varint ms since the previous event, then
+#           0x80 | voice, MIDI note   (note on)   or   voice   (note off)
+#   poly seek  SEEK_FORMAT entries for the poly track (previous units unused,
+#           lead = ms since the event before the step)
+#   One duration unit is the song's quantum_us (1/48 beat for MIDI sources).
+import math
+import os
+import re
+import struct
+import sys
+
+try:
+    import mido
+except ImportError:
+    mido = None
+
+BANK_MAGIC = b'MBNK'
+BANK_VERSION = 3
+HEADER_FORMAT = '<4sBBHII'
+INDEX_FORMAT = '<28sIIIIIIIIIHHHHHBBBB2x'
+SEEK_FORMAT = '<HHHH'       # note index, data offset, previous units, ms since note start
+SEEK_STEP_MS = 2000
+ENVELOPE_LEN = 110
+MAX_VOICES = 4
+QUANTA_PER_BEAT = 48
+
+# Display name, file base name, colour scheme. Order is the song index used by
+# the firmware (boot sound is the last entry, hourly chimes use the first 12).
+SONGS = [
+    ("Bao Wei Huang He", "bao_wei_huang_he", 0),
+    ("Bu Zai You Yu", "bu_zai_you_yu", 0),
+    ("Cai Bu Tou", "cai_bu_tou", 0),
+    ("Casablanca", "Casablanca", 2),
+    ("Cheng Du", "cheng_du", 2),
+    ("Chun Jiao Yu Zhi Ming", "chun_jiao_yu_zhi_ming", 1),
+    ("Da Hai", "da_hai", 2),
+    ("Dong Fang Zhi Zhu", "dong_fang_zhi_zhu", 2),
+    ("Dream Wedding", "Dream_Wedding", 2),
+    ("Fan Fang Xiang De Zhong", "fan_fang_xiang_de_zhong", 2),
+    ("For Elise", "For_Elise", 2),
+    ("Ge Chang Zu Guo", "ge_chang_zu_guo", 2),
+    ("Guo Ji Ge", "guo_ji_ge", 2),
+    ("Hai Kuo Tian Kong", "hai_kuo_tian_kong", 3),
+    ("Hong Dou", "hong_dou", 4),
+    ("Hong Se Gao Gen Xie", "hong_se_gao_gen_xie", 0),
+    ("Hou Lai", "hou_lai", 0),
+    ("Kai Shi Dong Le", "kai_shi_dong_le", 1),
+    ("Lan Ting Xu", "lan_ting_xu", 2),
+    ("Liang Zhu", "liang_zhu", 2),
+    ("Lv Se", "lv_se", 2),
+    ("Mi Ren De Wei Xian", "mi_ren_de_wei_xian", 3),
+    ("Qi Feng Le", "qi_feng_le", 3),
+    ("Qing Hua Ci", "qing_hua_ci", 3),
+    ("Tong Nian", "tong_nian", 2),
+    ("Turkish March", "Turkish_March", 2),
+    ("Xiao Xiao Niao", "wo_shi_yi_zhi_xiao_xiao_niao", 4),
+    ("Xi Huan Ni", "xi_huan_ni", 4),
+    ("Xin Qiang", "xin_qiang", 4),
+    ("Ye Feng Fei Wu", "ye_feng_fei_wu", 0),
+    ("Yi Sheng You Ni", "yi_sheng_you_ni", 0),
+    ("You Dian Tian", "you_dian_tian", 0),
+    ("Yu Jian", "yujian", 0),
+    ("Zhen De Ai Ni", "zhen_de_ai_ni", 3),
+    ("Windows XP", "Windows", 3),
+]
+
+
+def freq_to_note(freq: int) -> int:
+    if freq <= 0:
+        return 0
+    return max(1, min(127, round(69 + 12 * math.log2(freq / 440.0))))
+
+
+def read_midi(path):
+    """Returns ([(note, duration_us, start_us)], quantum_us). The order and
+    durations are those of midi_to_c_array.py, the start times are new."""
+    mid = mido.MidiFile(path)
+    ticks_per_beat = mid.ticks_per_beat or 480
+    tempo = 500000  # 默认 120 BPM
+    for track in mid.tracks:
+        for msg in track:
+            if msg.type == 'set_tempo' and msg.is_meta:
+                tempo = msg.tempo
+                break
+        if tempo != 500000:
+            break
+
+    notes = []
+    active = {}
+    for track in mid.tracks:
+        tick = 0
+        for msg in track:
+            tick += msg.time
+            if msg.type == 'note_on' and msg.velocity > 0:
+                active[(msg.note, msg.channel)] = tick
+            elif msg.type == 'note_off' or (msg.type == 'note_on' and msg.velocity == 0):
+                start = active.pop((msg.note, msg.channel), None)
+                if start is not None:
+                    duration_us = mido.tick2second(tick - start, ticks_per_beat, tempo) * 1e6
+                    start_us = mido.tick2second(start, ticks_per_beat, tempo) * 1e6
+                    notes.append((msg.note, duration_us, start_us))
+    return notes, max(1, tempo // QUANTA_PER_BEAT)
+
+
+def read_header(path):
+    """Returns ([(note, duration_us, start_us)], quantum_us) from a melody_/durations_ header."""
+    text = open(path, encoding='utf-8', errors='ignore').read()
+    arrays = {}
+    for kind, body in re.findall(r'(melody|durations)_\w+\s*\[\]\s*PROGMEM\s*=\s*\{([^}]*)\}', text):
+        arrays[kind] = [int(v) for v in re.findall(r'-?\d+', body)]
+    melody, durations = arrays.get('melody', []), arrays.get('durations', [])
+    notes = []
+    start_us = 0.0
+    for f, d in zip(melody, durations):
+        notes.append((freq_to_note(f), d * 1000.0, start_us))
+        start_us += d * 1000.0
+    return notes, 1000
+
+
+def encode_song(notes, quantum_us):
+    """Returns (data, total_ms, timeline) where timeline holds, per note,
+    (start_ms, length_ms, data offset, units before the note, note)."""
+    data = bytearray()
+    timeline = []
+    prev = 0
+    total_ms = 0
+    for note, duration_us, _ in notes:
+        units = max(0, round(duration_us / quantum_us))
+        length_ms = units * quantum_us // 1000  # Same truncation as the firmware
+        timeline.append((total_ms, length_ms, len(data), prev, note))
+        delta = units - prev
+        zigzag = (delta << 1) ^ (delta >> 31)
+        data.append(note)
+        while True:  # unsigned LEB128
+            byte = zigzag & 0x7F
+            zigzag >>= 7
+            data.append(byte | (0x80 if zigzag else 0))
+            if not zigzag:
+                break
+        prev = units
+        total_ms += length_ms
+    return bytes(data), total_ms, timeline
+
+
+def build_seek_table(timeline, total_ms):
+    """One entry per SEEK_STEP_MS: the note sounding at that time and the
+    decoder state needed to resume there."""
+    table = bytearray()
+    i = 0
+    for t in range(0, max(total_ms, 1), SEEK_STEP_MS):
+        while i + 1 < len(timeline) and timeline[i + 1][0] <= t:
+            i += 1
+        start_ms, _, offset, prev_units, _ = timeline[i]
+        if max(i, offset, prev_units, t - start_ms) > 0xFFFF:
+            sys.exit('Song too long for the seek table format')
+        table += struct.pack(SEEK_FORMAT, i, offset, prev_units, t - start_ms)
+    return bytes(table)
+
+
+def encode_varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        out.append(byte | (0x80 if value else 0))
+        if not value:
+            return out
+
+
+def allocate_voices(notes):
+    """Spreads the notes over MAX_VOICES voices. When all are busy the lowest
+    sounding note is cut short for a higher one, so the melody survives."""
+    spans = sorted((round(start / 1000), round((start + dur) / 1000), note)
+                   for note, dur, start in notes if note > 0 and dur >= 1000)
+    voices = [None] * MAX_VOICES    # [end_ms, note, index into placed]
+    placed = []
+    for start, end, note in spans:
+        free = [v for v in range(MAX_VOICES) if voices[v] is None or voices[v][0] <= start]
+        if free:
+            v = free[0]
+        else:
+            v = min(range(MAX_VOICES), key=lambda i: voices[i][1])
+            if voices[v][1] >= note:
+                continue
+            placed[voices[v][2]][1] = start
+        voices[v] = [end, note, len(placed)]
+        placed.append([start, end, note, v])
+    return [p for p in placed if p[1] > p[0]]
+
+
+def encode_poly(notes):
+    """Returns (data, total_ms, on_count, voices_used, events) where events
+    holds (time_ms, data offset, note ons before it) per event."""
+    placed = allocate_voices(notes)
+    # Offs sort before ons at the same time, so a voice can be reused at once
+    timed = sorted([(start, 1, v, note) for start, _, note, v in placed] +
+                   [(end, 0, v, 0) for _, end, _, v in placed])
+    data = bytearray()
+    events = []
+    prev = 0
+    ons = 0
+    for time_ms, on, voice, note in timed:
+        events.append((time_ms, len(data), ons))
+        data += encode_varint(time_ms - prev)
+        data += bytes([0x80 | voice, note]) if on else bytes([voice])
+        prev = time_ms
+        ons += on
+    voices_used = max((v for *_, v in placed), default=-1) + 1
+    return bytes(data), prev, ons, voices_used, events
+
+
+def build_poly_seek_table(events, total_ms):
+    """One entry per SEEK_STEP_MS: the first event at or after that time and
+    the time of the event before it."""
+    table = bytearray()
+    i = 0
+    for t in range(0, max(total_ms, 1), SEEK_STEP_MS):
+        while i < len(events) and events[i][0] < t:
+            i += 1
+        _, offset, ons = events[min(i, len(events) - 1)]
+        prev_time = events[i - 1][0] if i > 0 else 0
+        if max(ons, offset, t - prev_time) > 0xFFFF:
+            sys.exit('Song too long for the seek table format')
+        table += struct.pack(SEEK_FORMAT, ons, offset, 0, t - prev_time)
+    return bytes(table)
+
+
+def build_envelope(timeline, total_ms):
+    envelope = bytearray(ENVELOPE_LEN)
+    for start_ms, _, _, _, note in timeline:
+        column = start_ms * ENVELOPE_LEN // max(total_ms, 1)
+        column = min(column, ENVELOPE_LEN - 1)
+        envelope[column] = max(envelope[column], note)
+    return bytes(envelope)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    out_path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, '..', 'data', 'music.bank')
+
+    songs = []
+    for name, base, color in SONGS:
+        mid_path = os.path.join(here, base + '.mid')
+        if mido is not None and os.path.exists(mid_path):
+            notes, quantum_us = read_midi(mid_path)
+            source = 'mid'
+        else:
+            notes, quantum_us = read_header(os.path.join(here, base + '.h'))
+            source = 'h'
+        if not notes:
+            sys.exit(f'No notes found for {name}')
+        blob, total_ms, timeline = encode_song(notes, quantum_us)
+        songs.append((name, color, notes, quantum_us, blob, total_ms, timeline))
+        print(f'{name:<26} {source:>3} {len(notes):5d} notes {len(blob):6d} B  {total_ms // 1000:4d} s')
+
+    # Note data first, then the per-song tables
+    offset = struct.calcsize(HEADER_FORMAT) + struct.calcsize(INDEX_FORMAT) * len(SONGS)
+    data_offset = offset
+    data_pos = []
+    for song in songs:
+        data_pos.append(offset)
+        offset += len(song[4])
+
+    index = []
+    tables = []
+    for (name, color, notes, quantum_us, blob, total_ms, timeline), pos in zip(songs, data_pos):
+        seek = build_seek_table(timeline, total_ms)
+        envelope = build_envelope(timeline, total_ms)
+        poly, poly_ms, poly_ons, voices, events = encode_poly(notes)
+        poly_seek = build_poly_seek_table(events, poly_ms)
+        if len(poly) > 0xFFFF or len(events) > 0xFFFF:
+            sys.exit(f'Poly track too long for {name}')
+        seek_pos = offset
+        envelope_pos = seek_pos + len(seek)
+        poly_pos = envelope_pos + len(envelope)
+        poly_seek_pos = poly_pos + len(poly)
+        offset = poly_seek_pos + len(poly_seek)
+        tables.append(seek + envelope + poly + poly_seek)
+
+        audible = [n for n, *_ in notes if n > 0] or [0]
+        index.append(struct.pack(INDEX_FORMAT, name.encode('utf-8')[:27], pos, len(blob), total_ms,
+                                 quantum_us, seek_pos, envelope_pos, poly_pos, poly_seek_pos, poly_ms,
+                                 len(notes), len(seek) // struct.calcsize(SEEK_FORMAT),
+                                 len(poly), len(events), len(poly_seek) // struct.calcsize(SEEK_FORMAT),
+                                 color, min(audible), max(audible), voices))
+        print(f'{"":<26} poly {poly_ons:5d} notes {len(poly):6d} B  {poly_ms // 1000:4d} s  {voices} voices')
+
+    os.makedirs(os.path.dirname(os.path.abspath(out_path)), exist_ok=True)
+    with open(out_path, 'wb') as f:
+        f.write(struct.pack(HEADER_FORMAT, BANK_MAGIC, BANK_VERSION, len(SONGS),
+                            struct.calcsize(HEADER_FORMAT), struct.calcsize(HEADER_FORMAT), data_offset))
+        for entry in index:
+            f.write(entry)
+        for song in songs:
+            f.write(song[4])
+        for table in tables:
+            f.write(table)
+    print(f'Wrote {out_path}: {len(SONGS)} songs, {offset} bytes')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,688 @@
+#include "NoteSequencer.h"
+#include "Buzzer.h"
+#include "MusicBank.h"
+#include "Synth.h"
+#include <freertos/task.h>
+#include <esp_timer.h>
+#include <driver/ledc.h>
+#include <driver/gpio.h>
+#include <esp_rom_gpio.h>
+#include <soc/ledc_periph.h>
+
+#define SEQ_RESOLUTION       LEDC_TIMER_12_BIT  // 19 Hz .. 19 kHz from the 80 MHz APB clock
+#define SEQ_DUTY_HALF        (1 << 11)
+#define SEQ_LATE_SLACK_US    100     // Events this close to their deadline are played right away
+#define SEQ_SONG_NONE        0xFF
+#define SEQ_QUEUE_MASK       (SEQ_QUEUE_LEN - 1)
+
+// Orders plain memory accesses around the volatile indices. The ESP32-C3 is
+// single-core, so a compiler barrier is all the queue and the mapping need.
+#define SEQ_BARRIER()        __asm__ __volatile__("" ::: "memory")
+
+enum SeqEventType : uint8_t {
+    SEQ_EV_NOTE_ON,
+    SEQ_EV_NOTE_OFF,
+    SEQ_EV_END
+};
+
+struct SeqEvent {
+    uint32_t at_us;         // Song time of the event
+    uint16_t frequency;     // NOTE_ON only, 0 = rest
+    uint16_t duration_ms;
+    uint16_t note_index;
+    uint8_t  type;
+    uint8_t  voice;         // Synth voice, poly track only
+};
+
+// --- Command registers ---
+// Written by any task with plain word stores, read by the engine task. Each
+// register only holds the latest request, so there is nothing to lock.
+static volatile uint32_t cmd_play = 0;          // [generation:15][synth:1][gate:8][song:8]
+static volatile TaskHandle_t cmd_owner = NULL;
+static volatile uint32_t cmd_seek = 0;          // [generation:8][position_ms:24]
+static volatile uint32_t cmd_paused = 0;
+static volatile uint32_t cmd_tempo = 100;
+static uint32_t cmd_generation = 0;
+
+// --- Engine State ---
+// The engine task runs above every task that issues commands, so a command
+// has been applied by the time the call that issued it returns.
+static TaskHandle_t engineTaskHandle = NULL;
+static esp_timer_handle_t seqTimer = NULL;
+static volatile TaskHandle_t seq_owner = NULL;  // Task waiting for the current song
+static MusicStream stream;
+static bool stream_open = false;
+static bool end_queued = false;
+static uint32_t feed_cursor_us = 0;             // Song time of the next note to queue
+static uint16_t feed_note_index = 0;
+static uint8_t gate = 100;
+static bool use_synth = false;                  // Playing the poly track on the synth
+
+// --- Event Queue (engine produces, timer callback consumes) ---
+static SeqEvent queue[SEQ_QUEUE_LEN];
+static volatile uint32_t q_head = 0;
+static volatile uint32_t q_tail = 0;
+static volatile bool timer_armed = false;
+static volatile bool song_finished = false;
+static SeqEvent last_on;                        // Last note started, resounded on resume
+static volatile QueueHandle_t listeners[SEQ_MAX_LISTENERS];
+static portMUX_TYPE listeners_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t voice_frequency[SYNTH_VOICES];  // Held synth notes, resounded on resume
+
+// --- Song Time <-> Wall Clock ---
+// wall = base_wall + (song - base_song) * 100 / tempo. Updated only by the
+// engine with the timer stopped; map_seq is odd while an update is underway
+// so UI readers can retry instead of seeing half of one.
+static volatile uint32_t map_seq = 0;
+static volatile int64_t base_wall_us = 0;
+static volatile uint32_t base_song_us = 0;
+static volatile uint16_t tempo = 100;
+static volatile bool paused = false;
+
+// --- State for the UI ---
+static volatile int playing_song = -1;
+static volatile uint32_t song_length_us = 0;
+static volatile uint16_t ui_note_index = 0;
+static volatile uint16_t ui_frequency = 0;
+static volatile uint16_t ui_duration = 0;
+
+// =====================================================================================
+//                                    OUTPUT STAGE
+// =====================================================================================
+
+// Hands one note event to every listener. Never blocks.
+static void emitNote(bool on, uint16_t frequency, uint16_t duration_ms, uint8_t voice, uint32_t song_us) {
+    SeqNoteEvent event;
+    event.time_us = (uint32_t)esp_timer_get_time();
+    event.song_ms = song_us / 1000;
+    event.frequency = on ? frequency : 0;
+    event.duration_ms = duration_ms;
+    event.velocity = (on && frequency > 0) ? 127 : 0;
+    event.voice = voice;
+    event.on = on && frequency > 0; // A rest ends the previous note
+    for (int i = 0; i < SEQ_MAX_LISTENERS; i++) {
+        QueueHandle_t queue = listeners[i];
+        if (queue != NULL) xQueueSend(queue, &event, 0);
+    }
+}
+
+static void outputSilence() {
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)SEQ_LEDC_CHANNEL, 0);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)SEQ_LEDC_CHANNEL);
+}
+
+static void outputTone(uint16_t frequency) {
+    if (frequency == 0 || ledc_set_freq(LEDC_LOW_SPEED_MODE, (ledc_timer_t)SEQ_LEDC_TIMER, frequency) != ESP_OK) {
+        outputSilence();
+        return;
+    }
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)SEQ_LEDC_CHANNEL, SEQ_DUTY_HALF);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)SEQ_LEDC_CHANNEL);
+}
+
+// tone() between songs, or the synth, may have taken the pin since the last
+// song; while one plays nothing else drives it.
+static void routeBuzzerPin() {
+    gpio_set_direction((gpio_num_t)BUZZER_PIN, GPIO_MODE_OUTPUT);
+    esp_rom_gpio_connect_out_signal(BUZZER_PIN, ledc_periph_signal[LEDC_LOW_SPEED_MODE].sig_out0_idx + SEQ_LEDC_CHANNEL, false, false);
+}
+
+static void silenceAll() {
+    outputSilence();
+    if (use_synth) Synth_AllOff();
+}
+
+// Resounds whatever was held when the output was silenced at `position_us`.
+static void resumeHeldNotes(uint32_t position_us) {
+    if (use_synth) {
+        for (int v = 0; v < SYNTH_VOICES; v++) {
+            if (voice_frequency[v] > 0) {
+                Synth_NoteOn(v, voice_frequency[v]);
+                emitNote(true, voice_frequency[v], 0, v, position_us);
+            }
+        }
+        return;
+    }
+    uint32_t note_end_us = last_on.at_us + (uint32_t)last_on.duration_ms * 1000 * gate / 100;
+    if (last_on.frequency > 0 && position_us < note_end_us) {
+        outputTone(last_on.frequency);
+        ui_frequency = last_on.frequency;
+        emitNote(true, last_on.frequency, last_on.duration_ms, 0, position_us);
+    }
+}
+
+// =====================================================================================
+//                                   TIME MAPPING
+// =====================================================================================
+
+static inline int64_t songToWall(uint32_t song_us) {
+    return base_wall_us + ((int64_t)song_us - (int64_t)base_song_us) * 100 / tempo;
+}
+
+// Current song position. Engine only, or inside a map_seq read section.
+static uint32_t songPosition(int64_t now) {
+    if (paused) return base_song_us;
+    int64_t position = base_song_us + (now - base_wall_us) * tempo / 100;
+    if (position < 0) return 0;
+    if (position > song_length_us) return song_length_us;
+    return (uint32_t)position;
+}
+
+static inline void beginMapUpdate() { map_seq = map_seq + 1; SEQ_BARRIER(); }
+static inline void endMapUpdate() { SEQ_BARRIER(); map_seq = map_seq + 1; }
+
+// =====================================================================================
+//                                  TIMER CALLBACK
+// =====================================================================================
+
+// Runs on the esp_timer task at each event deadline. Plays every event that
+// is due, then re-arms the one-shot timer for the next one. The deadlines are
+// absolute, so lateness on one note never shifts the rest of the song.
+static void sequencerTimerCallback(void* arg) {
+    int64_t now = esp_timer_get_time();
+    while (q_tail != q_head) {
+        SEQ_BARRIER();
+        const SeqEvent& e = queue[q_tail & SEQ_QUEUE_MASK];
+        int64_t due = songToWall(e.at_us);
+        if (due > now + SEQ_LATE_SLACK_US) {
+            esp_timer_start_once(seqTimer, due - now);
+            if (q_head - q_tail <= SEQ_QUEUE_LEN / 2) xTaskNotifyGive(engineTaskHandle); // Time to refill
+            return;
+        }
+
+        switch (e.type) {
+            case SEQ_EV_NOTE_ON:
+                if (use_synth) {
+                    Synth_NoteOn(e.voice, e.frequency);
+                    voice_frequency[e.voice] = e.frequency;
+                } else {
+                    outputTone(e.frequency);
+                }
+                last_on = e;
+                ui_note_index = e.note_index;
+                ui_frequency = e.frequency;
+                ui_duration = e.duration_ms;
+                emitNote(true, e.frequency, e.duration_ms, e.voice, e.at_us);
+                break;
+            case SEQ_EV_NOTE_OFF:
+                emitNote(false, 0, 0, e.voice, e.at_us);
+                if (use_synth) {
+                    Synth_NoteOff(e.voice);
+                    voice_frequency[e.voice] = 0;
+                    if (e.voice != last_on.voice) break; // The shown note is still sounding
+                } else {
+                    outputSilence();
+                }
+                ui_frequency = 0;
+                break;
+            case SEQ_EV_END:
+                silenceAll();
+                emitNote(false, 0, 0, SEQ_VOICE_ALL, e.at_us);
+                ui_frequency = 0;
+                song_finished = true;
+                break;
+        }
+        SEQ_BARRIER();
+        q_tail = q_tail + 1;
+    }
+    timer_armed = false;
+    xTaskNotifyGive(engineTaskHandle);
+}
+
+static void armTimer() {
+    if (timer_armed || paused || q_tail == q_head) return;
+    SEQ_BARRIER();
+    int64_t delay = songToWall(queue[q_tail & SEQ_QUEUE_MASK].at_us) - esp_timer_get_time();
+    timer_armed = true;
+    esp_timer_start_once(seqTimer, delay > 0 ? delay : 0);
+}
+
+static void disarmTimer() {
+    esp_timer_stop(seqTimer);
+    timer_armed = false;
+}
+
+// =====================================================================================
+//                                   ENGINE HELPERS
+// =====================================================================================
+
+static void pushEvent(uint8_t type, uint32_t at_us, uint16_t frequency, uint16_t duration_ms,
+                      uint16_t note_index, uint8_t voice = 0) {
+    SeqEvent& e = queue[q_head & SEQ_QUEUE_MASK];
+    e.type = type;
+    e.voice = voice;
+    e.at_us = at_us;
+    e.frequency = frequency;
+    e.duration_ms = duration_ms;
+    e.note_index = note_index;
+    SEQ_BARRIER();
+    q_head = q_head + 1;
+}
+
+static void closeStream() {
+    if (stream_open) {
+        MusicBank_Close(&stream);
+        stream_open = false;
+    }
+}
+
+// Poly track: events are already in time order, one slot each.
+static void feedEvents() {
+    MusicEvent event;
+    while (stream_open && !end_queued && q_head - q_tail < SEQ_QUEUE_LEN) {
+        if (!MusicBank_ReadEvent(&stream, &event)) {
+            pushEvent(SEQ_EV_END, feed_cursor_us, 0, 0, feed_note_index);
+            end_queued = true;
+            closeStream();
+            break;
+        }
+        feed_cursor_us = event.time_ms * 1000;
+        if (event.on) {
+            pushEvent(SEQ_EV_NOTE_ON, feed_cursor_us, event.frequency, 0, feed_note_index++, event.voice);
+        } else {
+            pushEvent(SEQ_EV_NOTE_OFF, feed_cursor_us, 0, 0, feed_note_index, event.voice);
+        }
+    }
+}
+
+// Queues notes until the ring is full. Each note needs at most two slots.
+static void feedQueue() {
+    if (use_synth) {
+        feedEvents();
+        return;
+    }
+    MusicNote note;
+    while (stream_open && !end_queued && SEQ_QUEUE_LEN - (q_head - q_tail) >= 2) {
+        if (!MusicBank_Read(&stream, &note)) {
+            pushEvent(SEQ_EV_END, feed_cursor_us, 0, 0, feed_note_index);
+            end_queued = true;
+            closeStream();
+            break;
+        }
+        uint32_t length_us = (uint32_t)note.duration_ms * 1000;
+        pushEvent(SEQ_EV_NOTE_ON, feed_cursor_us, note.frequency, note.duration_ms, feed_note_index);
+        if (note.frequency > 0 && gate < 100) {
+            pushEvent(SEQ_EV_NOTE_OFF, feed_cursor_us + length_us * gate / 100, 0, 0, feed_note_index);
+        }
+        feed_cursor_us += length_us;
+        feed_note_index++;
+    }
+}
+
+// Drops everything queued. The timer must be stopped.
+static void resetQueue() {
+    q_head = 0;
+    q_tail = 0;
+    end_queued = false;
+    song_finished = false;
+    memset(&last_on, 0, sizeof(last_on));
+    memset(voice_frequency, 0, sizeof(voice_frequency));
+}
+
+// Leaves the synth running, the next song may want it too.
+static void stopSong() {
+    disarmTimer();
+    silenceAll();
+    if (playing_song >= 0) emitNote(false, 0, 0, SEQ_VOICE_ALL, songPosition(esp_timer_get_time()));
+    closeStream();
+    resetQueue();
+    playing_song = -1;
+    ui_frequency = 0;
+    ui_duration = 0;
+}
+
+static void notifyOwner(TaskHandle_t task, SeqEndReason reason) {
+    if (task != NULL) xTaskNotify(task, reason, eSetValueWithOverwrite);
+}
+
+static void startSong(int song, uint8_t new_gate, bool synth) {
+    const MusicBankEntry* entry = MusicBank_Song(song);
+    // Songs without a poly track fall back to the buzzer
+    use_synth = synth && entry != NULL && entry->poly_events > 0 && Synth_Start();
+    if (!use_synth) {
+        Synth_Stop();
+        routeBuzzerPin();
+    }
+
+    uint16_t first_note = 0;
+    if (use_synth) {
+        stream_open = MusicBank_OpenEvents(&stream, song, 0, &first_note);
+    } else {
+        stream_open = (entry != NULL) && MusicBank_Open(&stream, song);
+    }
+    if (!stream_open) {
+        Serial.printf("Sequencer: cannot open song %d\n", song);
+        TaskHandle_t owner = seq_owner;
+        seq_owner = NULL;
+        notifyOwner(owner, SEQ_END_STOPPED);
+        return;
+    }
+
+    gate = new_gate;
+    feed_cursor_us = 0;
+    feed_note_index = first_note;
+    song_length_us = (use_synth ? entry->poly_total_ms : entry->total_ms) * 1000;
+    ui_note_index = 0;
+    playing_song = song;
+    feedQueue(); // Fill the queue before taking the start time, so the first note is on time
+
+    beginMapUpdate();
+    base_song_us = 0;
+    base_wall_us = esp_timer_get_time();
+    paused = false;
+    endMapUpdate();
+    armTimer();
+}
+
+static void applyPause(bool pause) {
+    if (pause == paused) return;
+    int64_t now = esp_timer_get_time();
+    if (pause) {
+        disarmTimer();
+        silenceAll();
+        uint32_t position = songPosition(now);
+        emitNote(false, 0, 0, SEQ_VOICE_ALL, position);
+        beginMapUpdate();
+        base_song_us = position;
+        base_wall_us = now;
+        paused = true;
+        endMapUpdate();
+        ui_frequency = 0;
+        return;
+    }
+
+    beginMapUpdate();
+    base_wall_us = now;
+    paused = false;
+    endMapUpdate();
+    // Resound the notes the pause cut off, the queue only holds the ones after them
+    resumeHeldNotes(base_song_us);
+    armTimer();
+}
+
+// Poly track: walks the events before the target to learn which voices are
+// held there, and restarts those at the target.
+static void seekEvents(uint32_t target_us) {
+    uint16_t held[SYNTH_VOICES] = {};
+    stream_open = MusicBank_OpenEvents(&stream, playing_song, target_us / 1000, &feed_note_index);
+    feed_cursor_us = stream.prev_units * 1000;
+
+    MusicEvent event;
+    bool have_event = false;
+    while (stream_open) {
+        if (!MusicBank_ReadEvent(&stream, &event)) break;
+        if (event.time_ms * 1000 >= target_us) {
+            have_event = true;
+            break;
+        }
+        feed_cursor_us = event.time_ms * 1000;
+        if (event.on) feed_note_index++;
+        if (event.voice < SYNTH_VOICES) held[event.voice] = event.on ? event.frequency : 0;
+    }
+    for (int v = 0; v < SYNTH_VOICES; v++) {
+        if (held[v] > 0) pushEvent(SEQ_EV_NOTE_ON, target_us, held[v], 0, feed_note_index, v);
+    }
+    if (have_event) {
+        feed_cursor_us = event.time_ms * 1000;
+        if (event.on) {
+            pushEvent(SEQ_EV_NOTE_ON, feed_cursor_us, event.frequency, 0, feed_note_index++, event.voice);
+        } else {
+            pushEvent(SEQ_EV_NOTE_OFF, feed_cursor_us, 0, 0, feed_note_index, event.voice);
+        }
+    } else if (stream_open) {
+        pushEvent(SEQ_EV_END, feed_cursor_us, 0, 0, feed_note_index);
+        end_queued = true;
+        closeStream();
+    }
+}
+
+// Reopens the stream at the nearest seek point and enters the note that
+// contains the target part-way.
+static void applySeek(uint32_t position_ms) {
+    uint32_t target_us = position_ms * 1000;
+    if (target_us > song_length_us) target_us = song_length_us;
+
+    disarmTimer();
+    silenceAll();
+    emitNote(false, 0, 0, SEQ_VOICE_ALL, target_us);
+    closeStream();
+    resetQueue();
+    ui_frequency = 0;
+    if (use_synth) {
+        seekEvents(target_us);
+        feedQueue();
+        beginMapUpdate();
+        base_song_us = target_us;
+        base_wall_us = esp_timer_get_time();
+        endMapUpdate();
+        armTimer();
+        return;
+    }
+    uint32_t note_start_ms = 0;
+    stream_open = MusicBank_OpenAt(&stream, playing_song, target_us / 1000, &note_start_ms, &feed_note_index);
+    feed_cursor_us = note_start_ms * 1000;
+
+    // At most one seek step of notes to walk through
+    MusicNote note;
+    while (stream_open) {
+        if (!MusicBank_Read(&stream, &note)) {
+            pushEvent(SEQ_EV_END, feed_cursor_us, 0, 0, feed_note_index);
+            end_queued = true;
+            closeStream();
+            break;
+        }
+        uint32_t length_us = (uint32_t)note.duration_ms * 1000;
+        if (feed_cursor_us + length_us > target_us) {
+            uint32_t off_us = feed_cursor_us + length_us * gate / 100;
+            bool sounding = note.frequency > 0 && target_us < off_us;
+            pushEvent(SEQ_EV_NOTE_ON, target_us, sounding ? note.frequency : 0, note.duration_ms, feed_note_index);
+            if (sounding && gate < 100) pushEvent(SEQ_EV_NOTE_OFF, off_us, 0, 0, feed_note_index);
+            feed_cursor_us += length_us;
+            feed_note_index++;
+            break;
+        }
+        feed_cursor_us += length_us;
+        feed_note_index++;
+    }
+    feedQueue();
+
+    beginMapUpdate();
+    base_song_us = target_us;
+    base_wall_us = esp_timer_get_time();
+    endMapUpdate();
+    armTimer();
+}
+
+static void applyTempo(uint16_t percent) {
+    if (percent < SEQ_TEMPO_MIN) percent = SEQ_TEMPO_MIN;
+    if (percent > SEQ_TEMPO_MAX) percent = SEQ_TEMPO_MAX;
+    if (percent == tempo) return;
+
+    // Rebase at the current position so the change takes effect from here on
+    disarmTimer();
+    int64_t now = esp_timer_get_time();
+    uint32_t position = songPosition(now);
+    beginMapUpdate();
+    base_song_us = position;
+    base_wall_us = now;
+    tempo = percent;
+    endMapUpdate();
+    armTimer();
+}
+
+// =====================================================================================
+//                                    ENGINE TASK
+// =====================================================================================
+
+static void Sequencer_Task(void *pvParameters) {
+    uint32_t seen_play = cmd_play;
+    uint32_t seen_seek = cmd_seek;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint32_t play = cmd_play;
+        if (play != seen_play) {
+            seen_play = play;
+            TaskHandle_t previous = seq_owner;
+            TaskHandle_t next = cmd_owner;
+            stopSong();
+            if (previous != NULL && previous != next) notifyOwner(previous, SEQ_END_STOPPED);
+            seq_owner = NULL;
+            if ((play & 0xFF) != SEQ_SONG_NONE) {
+                seq_owner = next;
+                startSong(play & 0xFF, (play >> 8) & 0xFF, (play >> 16) & 1);
+            }
+        }
+
+        applyTempo(cmd_tempo);
+        uint32_t seek = cmd_seek;
+        if (playing_song < 0) {
+            seen_seek = seek;
+            Synth_Stop(); // Hand the pin back to tone() between songs
+            continue;
+        }
+        if (seek != seen_seek) {
+            seen_seek = seek;
+            applySeek(seek & 0xFFFFFF);
+        }
+        applyPause(cmd_paused != 0);
+
+        if (song_finished) {
+            stopSong();
+            Synth_Stop();
+            TaskHandle_t owner = seq_owner;
+            seq_owner = NULL;
+            notifyOwner(owner, SEQ_END_FINISHED);
+            continue;
+        }
+        feedQueue();
+        armTimer();
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void Sequencer_Init() {
+    if (engineTaskHandle != NULL) return;
+
+    ledc_timer_config_t timer_cfg = {};
+    timer_cfg.speed_mode = LEDC_LOW_SPEED_MODE;
+    timer_cfg.duty_resolution = SEQ_RESOLUTION;
+    timer_cfg.timer_num = (ledc_timer_t)SEQ_LEDC_TIMER;
+    timer_cfg.freq_hz = 1000;
+    timer_cfg.clk_cfg = LEDC_AUTO_CLK;
+    ledc_timer_config(&timer_cfg);
+
+    ledc_channel_config_t channel_cfg = {};
+    channel_cfg.gpio_num = BUZZER_PIN;
+    channel_cfg.speed_mode = LEDC_LOW_SPEED_MODE;
+    channel_cfg.channel = (ledc_channel_t)SEQ_LEDC_CHANNEL;
+    channel_cfg.intr_type = LEDC_INTR_DISABLE;
+    channel_cfg.timer_sel = (ledc_timer_t)SEQ_LEDC_TIMER;
+    channel_cfg.duty = 0;
+    channel_cfg.hpoint = 0;
+    ledc_channel_config(&channel_cfg);
+
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = sequencerTimerCallback;
+    timer_args.dispatch_method = ESP_TIMER_TASK;
+    timer_args.name = "sequencer";
+    esp_timer_create(&timer_args, &seqTimer);
+
+    xTaskCreatePinnedToCore(Sequencer_Task, "Sequencer", 4096, NULL, 3, &engineTaskHandle, 0);
+}
+
+bool Sequencer_Play(int song, uint8_t gate_percent, SeqOutput output) {
+    if (engineTaskHandle == NULL || song < 0 || song >= SEQ_SONG_NONE || MusicBank_Song(song) == NULL) return false;
+    if (gate_percent == 0 || gate_percent > 100) gate_percent = 100;
+
+    xTaskNotifyStateClear(NULL); // Drop a stale end notification from an earlier song
+    cmd_owner = xTaskGetCurrentTaskHandle();
+    cmd_paused = 0;
+    cmd_generation++;
+    cmd_play = (cmd_generation << 17) | ((output == SEQ_OUTPUT_SYNTH) ? (1u << 16) : 0)
+             | ((uint32_t)gate_percent << 8) | (uint32_t)song;
+    xTaskNotifyGive(engineTaskHandle);
+    return true;
+}
+
+// The owner is not notified, so a controller can stop the song and then
+// delete the task that was waiting on it.
+void Sequencer_Stop() {
+    if (engineTaskHandle == NULL) return;
+    seq_owner = NULL;
+    cmd_generation++;
+    cmd_play = (cmd_generation << 17) | SEQ_SONG_NONE;
+    xTaskNotifyGive(engineTaskHandle);
+}
+
+void Sequencer_SetPaused(bool pause) {
+    if (engineTaskHandle == NULL) return;
+    cmd_paused = pause ? 1 : 0;
+    xTaskNotifyGive(engineTaskHandle);
+}
+
+void Sequencer_Seek(uint32_t position_ms) {
+    if (engineTaskHandle == NULL) return;
+    if (position_ms > 0xFFFFFF) position_ms = 0xFFFFFF;
+    cmd_generation++;
+    cmd_seek = ((cmd_generation & 0xFF) << 24) | position_ms;
+    xTaskNotifyGive(engineTaskHandle);
+}
+
+void Sequencer_SetTempo(uint16_t percent) {
+    if (engineTaskHandle == NULL) return;
+    cmd_tempo = percent;
+    xTaskNotifyGive(engineTaskHandle);
+}
+
+SeqEndReason Sequencer_WaitEnd(TickType_t timeout) {
+    uint32_t value = SEQ_END_NONE;
+    if (xTaskNotifyWait(0, 0xFFFFFFFF, &value, timeout) != pdTRUE) return SEQ_END_NONE;
+    return (SeqEndReason)value;
+}
+
+bool Sequencer_IsPlaying() { return playing_song >= 0; }
+bool Sequencer_IsPaused() { return playing_song >= 0 && paused; }
+int Sequencer_Song() { return playing_song; }
+bool Sequencer_IsSynth() { return playing_song >= 0 && use_synth; }
+uint32_t Sequencer_LengthMs() { return song_length_us / 1000; }
+uint16_t Sequencer_NoteIndex() { return ui_note_index; }
+uint16_t Sequencer_NoteFrequency() { return ui_frequency; }
+uint16_t Sequencer_NoteDuration() { return ui_duration; }
+
+bool Sequencer_AddListener(QueueHandle_t queue) {
+    if (queue == NULL) return false;
+    bool added = false;
+    taskENTER_CRITICAL(&listeners_mux);
+    for (int i = 0; i < SEQ_MAX_LISTENERS && !added; i++) {
+        if (listeners[i] == queue) added = true;
+    }
+    for (int i = 0; i < SEQ_MAX_LISTENERS && !added; i++) {
+        if (listeners[i] == NULL) { listeners[i] = queue; added = true; }
+    }
+    taskEXIT_CRITICAL(&listeners_mux);
+    return added;
+}
+
+void Sequencer_RemoveListener(QueueHandle_t queue) {
+    taskENTER_CRITICAL(&listeners_mux);
+    for (int i = 0; i < SEQ_MAX_LISTENERS; i++) {
+        if (listeners[i] == queue) listeners[i] = NULL;
+    }
+    taskEXIT_CRITICAL(&listeners_mux);
+}
+
+uint32_t Sequencer_PositionMs() {
+    if (playing_song < 0) return 0;
+    uint32_t seq, position;
+    do {
+        seq = map_seq;
+        SEQ_BARRIER();
+        position = songPosition(esp_timer_get_time());
+        SEQ_BARRIER();
+    } while ((seq & 1) || seq != map_seq);
+    return position / 1000;
+}
@@ -0,0 +1,86 @@
+#ifndef NOTE_SEQUENCER_H
+#define NOTE_SEQUENCER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+// Timer-driven note sequencer for the buzzer.
+// An engine task streams the song from the music bank and queues note-on /
+// note-off events stamped with their absolute song time. A one-shot esp_timer
+// fires at each deadline and switches the LEDC channel, so timing never drifts
+// with task scheduling and the playing task just sleeps until the song ends.
+//
+// Commands (play/stop, pause, seek, tempo) are single-word registers any task
+// can write without locking; the engine picks up the latest value of each.
+//
+// Every note-on and note-off is also copied, as it sounds, to the queues of
+// registered listeners (visualizers). A full queue drops the event, so a slow
+// listener never holds up the music.
+#define SEQ_LEDC_CHANNEL     5      // Kept clear of the channels tone() uses
+#define SEQ_LEDC_TIMER       3
+#define SEQ_QUEUE_LEN        32     // Queued events, must be a power of two
+#define SEQ_TEMPO_MIN        25     // Percent of the original tempo
+#define SEQ_TEMPO_MAX        400
+#define SEQ_MAX_LISTENERS    4
+#define SEQ_VOICE_ALL        0xFF   // Note-off for every voice: stop, pause, seek, end
+
+// Why Sequencer_WaitEnd() returned
+enum SeqEndReason {
+    SEQ_END_NONE = 0,       // Timed out, still playing
+    SEQ_END_FINISHED,       // Reached the end of the song
+    SEQ_END_STOPPED         // Stopped, or replaced by another Play
+};
+
+// Where a song is played. The synth plays the song's polyphonic track and
+// falls back to the buzzer for songs that do not have one.
+enum SeqOutput {
+    SEQ_OUTPUT_BUZZER = 0,
+    SEQ_OUTPUT_SYNTH
+};
+
+// What listeners receive, one per note-on or note-off.
+// The bank stores no dynamics, so velocity is 127 for every note-on and 0 for note-offs.
+struct SeqNoteEvent {
+    uint32_t time_us;       // esp_timer_get_time() when it sounded, low 32 bits
+    uint32_t song_ms;       // Song position of the event
+    uint16_t frequency;     // Hz, 0 for note-offs and rests
+    uint16_t duration_ms;   // Buzzer notes; 0 on the poly track, which sends note-offs
+    uint8_t  velocity;
+    uint8_t  voice;         // Synth voice, 0 on the buzzer, SEQ_VOICE_ALL
+    bool     on;
+};
+
+// Sets up the LEDC channel, the timer and the engine task. Safe to call twice.
+void Sequencer_Init();
+
+// Starts a song from the beginning and makes the calling task its owner.
+// gate_percent shortens each note (100 = legato, 90 = slightly detached).
+// gate_percent only applies to the buzzer, the poly track has its own note-offs.
+bool Sequencer_Play(int song, uint8_t gate_percent = 100, SeqOutput output = SEQ_OUTPUT_BUZZER);
+void Sequencer_Stop();
+void Sequencer_SetPaused(bool paused);
+void Sequencer_Seek(uint32_t position_ms);
+void Sequencer_SetTempo(uint16_t percent);
+
+// Blocks the owner task until the song ends or the timeout expires.
+SeqEndReason Sequencer_WaitEnd(TickType_t timeout = portMAX_DELAY);
+
+// `queue` holds SeqNoteEvent items. Events are sent from the esp_timer task
+// without waiting. A queue may still get an event right after it is removed,
+// so keep listener queues for the life of the program.
+bool Sequencer_AddListener(QueueHandle_t queue);
+void Sequencer_RemoveListener(QueueHandle_t queue);
+
+// --- Playback state for the UI ---
+bool Sequencer_IsPlaying();
+bool Sequencer_IsPaused();
+int Sequencer_Song();                   // -1 when stopped
+bool Sequencer_IsSynth();               // Playing the poly track on the synth
+uint32_t Sequencer_LengthMs();          // Of the track being played
+uint32_t Sequencer_PositionMs();
+uint16_t Sequencer_NoteIndex();
+uint16_t Sequencer_NoteFrequency();     // 0 during rests and while paused
+uint16_t Sequencer_NoteDuration();
+
+#endif // NOTE_SEQUENCER_H
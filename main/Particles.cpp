@@ -0,0 +1,258 @@
+#include "Particles.h"
+#include "FixedMath.h"
+
+#define PARTICLE_SHIFT 8
+#define NO_EMITTER     0xFF
+
+struct EmitterSlot {
+    ParticleEmitter def;
+    uint16_t alive;
+    uint16_t rate_accum;        // 1/256 spawns carried to the next frame
+};
+
+// --- Pool (structure of arrays, live particles in [0, count)) ---
+static int32_t p_x[PARTICLE_POOL_MAX];
+static int32_t p_y[PARTICLE_POOL_MAX];
+static int16_t p_vx[PARTICLE_POOL_MAX];
+static int16_t p_vy[PARTICLE_POOL_MAX];
+static uint16_t p_life[PARTICLE_POOL_MAX];      // Frames left, 0 = no limit
+static uint16_t p_color[PARTICLE_POOL_MAX];     // Byte-swapped, as sprites store it
+static uint8_t p_radius[PARTICLE_POOL_MAX];
+static uint8_t p_emitter[PARTICLE_POOL_MAX];
+static uint8_t p_tag[PARTICLE_POOL_MAX];
+static uint16_t count = 0;
+
+// --- Emitters and Forces ---
+static EmitterSlot emitters[PARTICLE_MAX_EMITTERS];
+static uint8_t emitter_count = 0;
+static ParticleForce forces[PARTICLE_MAX_FORCES];
+static uint8_t force_count = 0;
+
+static int16_t bound_w = 240;
+static int16_t bound_h = 240;
+static uint32_t rng_state = 1;
+
+// Half-width of each row of a disc, [radius][|dy|]
+static uint8_t disc_span[PARTICLE_MAX_RADIUS + 1][PARTICLE_MAX_RADIUS + 1];
+static bool disc_ready = false;
+
+// =====================================================================================
+//                                      HELPERS
+// =====================================================================================
+
+static uint32_t nextRandom() {
+    uint32_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_state = x;
+    return x;
+}
+
+// lo..hi inclusive
+static int32_t randomRange(int32_t lo, int32_t hi) {
+    if (hi <= lo) return lo;
+    return lo + (int32_t)(nextRandom() % (uint32_t)(hi - lo + 1));
+}
+
+static void buildDiscSpans() {
+    for (int r = 0; r <= PARTICLE_MAX_RADIUS; r++) {
+        for (int dy = 0; dy <= r; dy++) {
+            disc_span[r][dy] = (uint8_t)Fix_Isqrt((uint32_t)(r * r - dy * dy + r)); // +r rounds the rim
+        }
+    }
+    disc_ready = true;
+}
+
+static void spawn(uint8_t id, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (count >= PARTICLE_POOL_MAX) return;
+    EmitterSlot& e = emitters[id];
+    const ParticleEmitter& d = e.def;
+    uint16_t i = count++;
+
+    int32_t px = randomRange(x, x + w - 1);
+    if (d.grid_x > 1) px -= px % d.grid_x;
+    p_x[i] = px << PARTICLE_SHIFT;
+    p_y[i] = randomRange(y, y + h - 1) << PARTICLE_SHIFT;
+    p_vx[i] = (int16_t)randomRange(d.vx_min, d.vx_max);
+    p_vy[i] = (int16_t)randomRange(d.vy_min, d.vy_max);
+    p_life[i] = (d.life_max == 0) ? 0 : (uint16_t)randomRange(d.life_min ? d.life_min : 1, d.life_max);
+    uint16_t color = (d.flags & PARTICLE_RANDOM_COLOR) ? (uint16_t)nextRandom() : d.color;
+    p_color[i] = (color >> 8) | (color << 8);
+    p_radius[i] = (d.radius > PARTICLE_MAX_RADIUS) ? PARTICLE_MAX_RADIUS : d.radius;
+    p_emitter[i] = id;
+    p_tag[i] = (uint8_t)randomRange(d.tag_min, d.tag_max);
+    e.alive++;
+}
+
+static void kill(uint16_t i) {
+    emitters[p_emitter[i]].alive--;
+    uint16_t last = --count;
+    if (i == last) return;
+    p_x[i] = p_x[last];
+    p_y[i] = p_y[last];
+    p_vx[i] = p_vx[last];
+    p_vy[i] = p_vy[last];
+    p_life[i] = p_life[last];
+    p_color[i] = p_color[last];
+    p_radius[i] = p_radius[last];
+    p_emitter[i] = p_emitter[last];
+    p_tag[i] = p_tag[last];
+}
+
+// Each force is one pass over the velocity arrays.
+static void applyForce(const ParticleForce& f) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (f.emitters && !(f.emitters & (1 << p_emitter[i]))) continue;
+        switch (f.type) {
+            case PARTICLE_FORCE_GRAVITY:
+                p_vx[i] += f.ax;
+                p_vy[i] += f.ay;
+                break;
+            case PARTICLE_FORCE_JITTER:
+                if (f.ax) p_vx[i] += (int16_t)randomRange(-f.ax, f.ax);
+                if (f.ay) p_vy[i] += (int16_t)randomRange(-f.ay, f.ay);
+                break;
+            case PARTICLE_FORCE_DRAG:
+                p_vx[i] -= (int16_t)(((int32_t)p_vx[i] * f.ax) / 256); // Toward zero: no bias either way
+                p_vy[i] -= (int16_t)(((int32_t)p_vy[i] * f.ax) / 256);
+                break;
+        }
+    }
+}
+
+// Returns false if the particle died.
+static bool applyEdge(uint16_t i) {
+    int32_t r = p_radius[i];
+    int32_t px = p_x[i] >> PARTICLE_SHIFT;
+    int32_t py = p_y[i] >> PARTICLE_SHIFT;
+    switch (emitters[p_emitter[i]].def.edge) {
+        case PARTICLE_EDGE_KILL: {
+            int32_t margin = r + 2; // Emitters may spawn just off screen
+            return px >= -margin && py >= -margin && px < bound_w + margin && py < bound_h + margin;
+        }
+        case PARTICLE_EDGE_WRAP:
+            if (px < 0) p_x[i] += (int32_t)bound_w << PARTICLE_SHIFT;
+            else if (px >= bound_w) p_x[i] -= (int32_t)bound_w << PARTICLE_SHIFT;
+            if (py < 0) p_y[i] += (int32_t)bound_h << PARTICLE_SHIFT;
+            else if (py >= bound_h) p_y[i] -= (int32_t)bound_h << PARTICLE_SHIFT;
+            return true;
+        case PARTICLE_EDGE_BOUNCE:
+            if ((px < r && p_vx[i] < 0) || (px >= bound_w - r && p_vx[i] > 0)) p_vx[i] = -p_vx[i];
+            if ((py < r && p_vy[i] < 0) || (py >= bound_h - r && p_vy[i] > 0)) p_vy[i] = -p_vy[i];
+            return true;
+    }
+    return true;
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void Particles_Reset(int16_t width, int16_t height) {
+    count = 0;
+    emitter_count = 0;
+    force_count = 0;
+    bound_w = width;
+    bound_h = height;
+    rng_state = esp_random() | 1;
+    if (!disc_ready) buildDiscSpans();
+}
+
+int Particles_AddEmitter(const ParticleEmitter& emitter) {
+    if (emitter_count >= PARTICLE_MAX_EMITTERS) return -1;
+    EmitterSlot& e = emitters[emitter_count];
+    e.def = emitter;
+    if (e.def.w < 1) e.def.w = 1;
+    if (e.def.h < 1) e.def.h = 1;
+    e.alive = 0;
+    e.rate_accum = 0;
+    return emitter_count++;
+}
+
+bool Particles_AddForce(const ParticleForce& force) {
+    if (force_count >= PARTICLE_MAX_FORCES) return false;
+    forces[force_count++] = force;
+    return true;
+}
+
+void Particles_Prefill(int emitter) {
+    if (emitter < 0 || emitter >= emitter_count) return;
+    EmitterSlot& e = emitters[emitter];
+    while (e.alive < e.def.max_alive && count < PARTICLE_POOL_MAX) {
+        spawn((uint8_t)emitter, 0, 0, bound_w, bound_h);
+    }
+}
+
+void Particles_Update() {
+    for (uint8_t f = 0; f < force_count; f++) applyForce(forces[f]);
+
+    uint16_t i = 0;
+    while (i < count) {
+        p_x[i] += p_vx[i];
+        p_y[i] += p_vy[i];
+        bool alive = true;
+        if (p_life[i] != 0 && --p_life[i] == 0) alive = false;
+        if (alive) alive = applyEdge(i);
+        if (alive) i++;
+        else kill(i); // The last particle moves into slot i and is handled next
+    }
+
+    for (uint8_t id = 0; id < emitter_count; id++) {
+        EmitterSlot& e = emitters[id];
+        e.rate_accum += e.def.rate;
+        while (e.rate_accum >= PARTICLE_ONE) {
+            if (e.alive >= e.def.max_alive || count >= PARTICLE_POOL_MAX) {
+                e.rate_accum = 0; // Capped: no burst once room frees up
+                break;
+            }
+            spawn(id, e.def.x, e.def.y, e.def.w, e.def.h);
+            e.rate_accum -= PARTICLE_ONE;
+        }
+    }
+}
+
+void Particles_Render(TFT_eSprite& sprite) {
+    int32_t w = sprite.width();
+    int32_t h = sprite.height();
+    uint16_t* buf = (uint16_t*)sprite.getPointer();
+    if (buf == NULL || sprite.getColorDepth() != 16) {
+        for (uint16_t i = 0; i < count; i++) {
+            uint16_t color = (p_color[i] >> 8) | (p_color[i] << 8);
+            int32_t px = p_x[i] >> PARTICLE_SHIFT, py = p_y[i] >> PARTICLE_SHIFT;
+            if (p_radius[i] == 0) sprite.drawPixel(px, py, color);
+            else sprite.fillCircle(px, py, p_radius[i], color);
+        }
+        return;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t px = p_x[i] >> PARTICLE_SHIFT;
+        int32_t py = p_y[i] >> PARTICLE_SHIFT;
+        uint16_t c = p_color[i];
+        int32_t r = p_radius[i];
+        if (r == 0) {
+            if ((uint32_t)px < (uint32_t)w && (uint32_t)py < (uint32_t)h) buf[py * w + px] = c;
+            continue;
+        }
+        for (int32_t dy = -r; dy <= r; dy++) {
+            int32_t row = py + dy;
+            if ((uint32_t)row >= (uint32_t)h) continue;
+            int32_t half = disc_span[r][dy < 0 ? -dy : dy];
+            int32_t x0 = px - half, x1 = px + half;
+            if (x0 < 0) x0 = 0;
+            if (x1 >= w) x1 = w - 1;
+            uint16_t* out = buf + row * w;
+            for (int32_t x = x0; x <= x1; x++) out[x] = c;
+        }
+    }
+}
+
+uint16_t Particles_Count() {
+    return count;
+}
+
+ParticleView Particles_View() {
+    ParticleView view = { count, p_x, p_y, p_tag };
+    return view;
+}
@@ -0,0 +1,80 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// One particle pool shared by the animated watchfaces; only one face runs at
+// a time. Storage is structure-of-arrays in fixed-size static arrays, live
+// particles packed at the front: spawning appends, killing moves the last
+// particle into the hole, nothing is ever allocated. Positions and velocities
+// are integers in 1/256 pixel. A face resets the pool, declares its emitters
+// and forces, then calls Particles_Update and Particles_Render once per frame.
+#define PARTICLE_POOL_MAX      768
+#define PARTICLE_MAX_EMITTERS  4
+#define PARTICLE_MAX_FORCES    4
+#define PARTICLE_MAX_RADIUS    8
+#define PARTICLE_ONE           256    // One pixel, or one pixel per frame
+
+// What happens when a particle reaches the edge of the screen.
+enum ParticleEdge : uint8_t {
+    PARTICLE_EDGE_KILL = 0,     // Dies once fully off screen; its emitter replaces it
+    PARTICLE_EDGE_WRAP,         // Reappears on the opposite side
+    PARTICLE_EDGE_BOUNCE,       // Velocity reflects, the particle stays on screen
+};
+
+#define PARTICLE_RANDOM_COLOR  0x01   // ParticleEmitter::flags: random colour per particle
+
+// Spawns particles at random inside its area with random velocity and life.
+struct ParticleEmitter {
+    int16_t x, y, w, h;         // Spawn area, pixels
+    uint8_t grid_x;             // Spawn x snaps to multiples of this (0 = any)
+    int16_t vx_min, vx_max;     // 1/256 pixel per frame
+    int16_t vy_min, vy_max;
+    uint16_t life_min, life_max;// Frames; 0 = lives until the edge rule kills it
+    uint16_t rate;              // Spawns per frame, 1/256 units
+    uint16_t max_alive;         // No spawns while this many of its particles live
+    uint16_t color;             // RGB565
+    uint8_t radius;             // 0 = single pixel, else a disc
+    ParticleEdge edge;
+    uint8_t tag_min, tag_max;   // Random byte per particle for the face (e.g. a glyph)
+    uint8_t flags;
+};
+
+enum ParticleForceType : uint8_t {
+    PARTICLE_FORCE_GRAVITY = 0, // Adds (ax, ay) to the velocity each frame
+    PARTICLE_FORCE_JITTER,      // Adds a random -ax..ax, -ay..ay each frame
+    PARTICLE_FORCE_DRAG,        // Removes ax/256 of the velocity each frame
+};
+
+struct ParticleForce {
+    ParticleForceType type;
+    int16_t ax, ay;             // 1/256 pixel per frame per frame
+    uint8_t emitters;           // Bit per emitter it acts on, 0 = all
+};
+
+// Read-only view of the live particles, for faces that draw them themselves.
+struct ParticleView {
+    uint16_t count;
+    const int32_t* x;           // 1/256 pixel
+    const int32_t* y;
+    const uint8_t* tag;
+};
+
+// Kills every particle and removes all emitters and forces.
+void Particles_Reset(int16_t width, int16_t height);
+// Returns the emitter id, or -1 when all slots are taken.
+int Particles_AddEmitter(const ParticleEmitter& emitter);
+bool Particles_AddForce(const ParticleForce& force);
+// Spawns the emitter's max_alive particles at once, spread over the screen.
+void Particles_Prefill(int emitter);
+
+// Forces, integration, life and edges, then emitter spawns.
+void Particles_Update();
+// Writes straight into a 16-bit sprite's buffer, other depths go through drawPixel.
+void Particles_Render(TFT_eSprite& sprite);
+
+uint16_t Particles_Count();
+ParticleView Particles_View();
+
+#endif // PARTICLES_H
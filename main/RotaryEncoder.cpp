@@ -15,7 +15,7 @@ static bool longPressHandled = false;          // Flag to indicate a long press
 // --- Button Configuration ---
 #define SWAP_CLK_DT 0
 static const unsigned long longPressThreshold = 2000;     // 2 seconds to trigger a long press
-static const unsigned long progressBarStartTime = 1000;   // Show progress bar after 1 second of hold
+static const unsigned long progressBarStartTime = LONG_PRESS_BAR_MS;   // Show progress bar after 1 second of hold
 
 // Initializes the rotary encoder pins and state
 void initRotaryEncoder() {
@@ -17,5 +17,8 @@ int readButton();
 // 获取按钮的当前去抖动状态 (HIGH: 未按下, LOW: 按下)
 int getButtonCurrentState(); // New function
 bool readButtonLongPress(); // New function for long press detection
+// readButtonLongPress draws its progress bar into menuSprite once the button
+// has been held this long, and clears it to black on an early release
+#define LONG_PRESS_BAR_MS 1000
 
 #endif
\ No newline at end of file
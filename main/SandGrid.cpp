@@ -0,0 +1,202 @@
+#include "SandGrid.h"
+
+#define CHUNK_SIZE  (1 << SAND_CHUNK_SHIFT)
+#define CHUNK_MASK  (CHUNK_SIZE - 1)
+#define MAX_CHUNKS_Y ((SAND_MAX_H + CHUNK_MASK) >> SAND_CHUNK_SHIFT)
+
+// Sand shades by material, RGB565; [0] is the empty cell
+static const uint16_t palette[SAND_GRAIN + SAND_SHADES] = {
+    TFT_BLACK, 0xFFE0, 0xFF40, 0xF6A0, 0xEE00,
+};
+
+// --- Material (row stride SAND_MAX_W) ---
+static uint8_t cells[SAND_MAX_W * SAND_MAX_H];
+static int16_t grid_w = 0;
+static int16_t grid_h = 0;
+static uint16_t count = 0;
+static uint32_t steps = 0;
+
+// --- Chunks (one bit per chunk column, one word per chunk row) ---
+static uint16_t awake[MAX_CHUNKS_Y];        // Scanned this step
+static uint16_t awake_next[MAX_CHUNKS_Y];   // Woken by this step's changes
+static uint16_t dirty[MAX_CHUNKS_Y];        // Changed since the last render
+static int16_t chunks_x = 0;
+static int16_t chunks_y = 0;
+static uint16_t column_mask = 0;
+
+// =====================================================================================
+//                                      HELPERS
+// =====================================================================================
+
+// A grain landed here: it may move again next step.
+static void filled(int16_t x, int16_t y) {
+    uint16_t bit = 1 << (x >> SAND_CHUNK_SHIFT);
+    awake_next[y >> SAND_CHUNK_SHIFT] |= bit;
+    dirty[y >> SAND_CHUNK_SHIFT] |= bit;
+}
+
+// A cell emptied: the grains above it may now fall, so wake the chunks
+// holding the three cells above. Rows still to be scanned this step see it
+// at once, the same as a full scan would.
+static void vacated(int16_t x, int16_t y) {
+    int16_t cx = x >> SAND_CHUNK_SHIFT, cy = y >> SAND_CHUNK_SHIFT;
+    uint16_t bit = 1 << cx;
+    uint16_t cols = bit;
+    if ((x & CHUNK_MASK) == 0) cols |= bit >> 1;
+    if ((x & CHUNK_MASK) == CHUNK_MASK) cols |= bit << 1;
+    cols &= column_mask;
+    if ((y & CHUNK_MASK) == 0) cy--; // The cells above are in the chunk row above
+    if (cy >= 0) {
+        awake[cy] |= cols;
+        awake_next[cy] |= cols;
+    }
+    dirty[y >> SAND_CHUNK_SHIFT] |= bit;
+}
+
+static void stepCell(int16_t x, int16_t y, bool drain, bool left_first) {
+    uint8_t* cell = &cells[y * SAND_MAX_W + x];
+    uint8_t material = *cell;
+    if (material == SAND_EMPTY) return;
+
+    if (y == grid_h - 1) {
+        if (!drain) return;
+        *cell = SAND_EMPTY;
+        count--;
+        vacated(x, y);
+        return;
+    }
+
+    // Straight down, else diagonally; the preferred side alternates per
+    // step so piles don't lean
+    uint8_t* below = cell + SAND_MAX_W;
+    int16_t to = x;
+    if (below[0] != SAND_EMPTY) {
+        int16_t first = left_first ? x - 1 : x + 1;
+        int16_t second = left_first ? x + 1 : x - 1;
+        if (first >= 0 && first < grid_w && below[first - x] == SAND_EMPTY) to = first;
+        else if (second >= 0 && second < grid_w && below[second - x] == SAND_EMPTY) to = second;
+        else return; // Resting; the chunk sleeps unless something else moves
+    }
+    below[to - x] = material;
+    *cell = SAND_EMPTY;
+    vacated(x, y);
+    filled(to, y + 1);
+}
+
+static void paintChunk(TFT_eSprite& sprite, uint16_t* buf, int16_t cx, int16_t cy) {
+    int16_t x0 = cx << SAND_CHUNK_SHIFT, y0 = cy << SAND_CHUNK_SHIFT;
+    int16_t x1 = min<int16_t>(x0 + CHUNK_SIZE, grid_w);
+    int16_t y1 = min<int16_t>(y0 + CHUNK_SIZE, grid_h);
+    int32_t stride = sprite.width();
+
+    for (int16_t y = y0; y < y1; y++) {
+        const uint8_t* row = &cells[y * SAND_MAX_W];
+        for (int16_t x = x0; x < x1; x++) {
+            uint16_t color = palette[row[x]];
+            if (buf == NULL) {
+                sprite.fillRect(x * SAND_CELL, y * SAND_CELL, SAND_CELL, SAND_CELL, color);
+                continue;
+            }
+            color = (color >> 8) | (color << 8); // Sprites store RGB565 byte-swapped
+            uint16_t* out = buf + (int32_t)y * SAND_CELL * stride + x * SAND_CELL;
+            for (int16_t dy = 0; dy < SAND_CELL; dy++, out += stride) {
+                for (int16_t dx = 0; dx < SAND_CELL; dx++) out[dx] = color;
+            }
+        }
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void Sand_Resize(int16_t width, int16_t height) {
+    int16_t w = min<int16_t>(width / SAND_CELL, SAND_MAX_W);
+    int16_t h = min<int16_t>(height / SAND_CELL, SAND_MAX_H);
+    if (w == grid_w && h == grid_h) return;
+    grid_w = w;
+    grid_h = h;
+    chunks_x = (grid_w + CHUNK_MASK) >> SAND_CHUNK_SHIFT;
+    chunks_y = (grid_h + CHUNK_MASK) >> SAND_CHUNK_SHIFT;
+    column_mask = (uint16_t)((1UL << chunks_x) - 1);
+    Sand_Clear();
+}
+
+void Sand_Clear() {
+    memset(cells, SAND_EMPTY, sizeof(cells));
+    memset(awake, 0, sizeof(awake));
+    memset(awake_next, 0, sizeof(awake_next));
+    for (int16_t cy = 0; cy < chunks_y; cy++) dirty[cy] = column_mask;
+    count = 0;
+}
+
+bool Sand_Spawn(int16_t x, int16_t y) {
+    if (x < 0 || y < 0 || x >= grid_w || y >= grid_h) return false;
+    uint8_t* cell = &cells[y * SAND_MAX_W + x];
+    if (*cell != SAND_EMPTY) return false;
+    *cell = SAND_GRAIN + esp_random() % SAND_SHADES;
+    count++;
+    filled(x, y);
+    return true;
+}
+
+void Sand_Update(bool drain) {
+    memcpy(awake, awake_next, sizeof(awake));
+    memset(awake_next, 0, sizeof(awake_next));
+    if (drain && chunks_y > 0) awake[chunks_y - 1] = column_mask; // Settled grains on the floor leave too
+
+    // Bottom row first: a grain only ever moves into the row below, which
+    // has been stepped already, so nothing moves twice in one step. The scan
+    // direction alternates with the diagonal preference.
+    bool left_first = steps & 1;
+    steps++;
+    for (int16_t cy = chunks_y - 1; cy >= 0; cy--) {
+        if (awake[cy] == 0) continue;
+        int16_t y_top = cy << SAND_CHUNK_SHIFT;
+        int16_t y_bottom = min<int16_t>(y_top + CHUNK_SIZE, grid_h) - 1;
+        for (int16_t y = y_bottom; y >= y_top; y--) {
+            uint16_t row_mask = awake[cy]; // Moves in the row below may have woken more
+            for (int16_t i = 0; i < chunks_x; i++) {
+                int16_t cx = left_first ? chunks_x - 1 - i : i;
+                if (!(row_mask & (1 << cx))) continue;
+                int16_t x0 = cx << SAND_CHUNK_SHIFT;
+                int16_t x1 = min<int16_t>(x0 + CHUNK_SIZE, grid_w) - 1;
+                if (left_first) {
+                    for (int16_t x = x1; x >= x0; x--) stepCell(x, y, drain, true);
+                } else {
+                    for (int16_t x = x0; x <= x1; x++) stepCell(x, y, drain, false);
+                }
+            }
+        }
+    }
+}
+
+void Sand_Render(TFT_eSprite& sprite, bool full) {
+    uint16_t* buf = (uint16_t*)sprite.getPointer();
+    if (sprite.getColorDepth() != 16) buf = NULL;
+    for (int16_t cy = 0; cy < chunks_y; cy++) {
+        uint16_t mask = full ? column_mask : dirty[cy];
+        dirty[cy] = 0;
+        for (int16_t cx = 0; mask != 0; cx++, mask >>= 1) {
+            if (mask & 1) paintChunk(sprite, buf, cx, cy);
+        }
+    }
+}
+
+uint16_t Sand_Count() {
+    return count;
+}
+
+int16_t Sand_Width() {
+    return grid_w;
+}
+
+int16_t Sand_Height() {
+    return grid_h;
+}
+
+uint16_t Sand_AwakeChunks() {
+    uint16_t n = 0;
+    for (int16_t cy = 0; cy < chunks_y; cy++) n += __builtin_popcount(awake_next[cy]);
+    return n;
+}
@@ -0,0 +1,43 @@
+#ifndef SAND_GRID_H
+#define SAND_GRID_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// Falling sand for the Sand Box face. The material is a byte per cell kept
+// apart from the sprite, split into 8x8-cell chunks with an awake bit each.
+// A step scans only the awake chunks. A grain that lands keeps its chunk
+// awake for the next step; a cell that empties wakes the chunks holding the
+// three cells above it, across chunk borders too. Settled sand falls asleep
+// and costs nothing. Chunks whose cells changed are marked dirty and
+// Sand_Render repaints only those, so the face keeps its sand in the sprite
+// between frames instead of clearing it.
+#define SAND_CELL          2       // Pixels per cell side
+#define SAND_MAX_W         120     // Cells
+#define SAND_MAX_H         120
+#define SAND_CHUNK_SHIFT   3       // 8x8 cells per chunk, at most 16 chunks a row
+#define SAND_SHADES        4
+
+// Cell materials. Grains are SAND_GRAIN..SAND_GRAIN + SAND_SHADES - 1, the
+// shade picked at spawn so the grain keeps its colour as it falls.
+#define SAND_EMPTY         0
+#define SAND_GRAIN         1
+
+// Sizes the grid for a sprite of this size; keeps the sand if it is unchanged.
+void Sand_Resize(int16_t width, int16_t height);
+void Sand_Clear();
+// Cell coordinates. False if the cell is taken or outside the grid.
+bool Sand_Spawn(int16_t x, int16_t y);
+// One step: grains fall straight down, else slide diagonally. With `drain`
+// the bottom row is open and grains leave through it.
+void Sand_Update(bool drain);
+// Repaints the dirty chunks, or every cell when `full` (after the sprite was
+// drawn over). Empty cells are painted black.
+void Sand_Render(TFT_eSprite& sprite, bool full);
+
+uint16_t Sand_Count();
+int16_t Sand_Width();           // Cells
+int16_t Sand_Height();
+uint16_t Sand_AwakeChunks();    // Chunks the next step will scan
+
+#endif // SAND_GRID_H
@@ -0,0 +1,205 @@
+#include "SensorHub.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define HUB_RING_MASK        (HUB_RING_LEN - 1)
+#define HUB_IDLE_WAIT_MS     1000     // Longest sleep, new drivers wake the task anyway
+#define CHIP_TEMP_PERIOD_MS  5000
+
+struct HubDriver {
+    const char* name;
+    uint32_t period_ms;
+    SensorPollFn poll;
+    uint32_t next_ms;           // Hub task only
+};
+
+struct HubSubscriber {
+    SensorCallback callback;
+    uint32_t channels;
+};
+
+// One ring per channel. The owning driver writes a slot, then advances head;
+// readers check head again after copying to drop slots overwritten meanwhile.
+struct HubChannel {
+    volatile float value[HUB_RING_LEN];
+    volatile uint32_t time_ms[HUB_RING_LEN];
+    volatile uint32_t head;     // Samples written, ever
+};
+
+static const char* const channelNames[SENSOR_CHANNEL_COUNT] = {
+    "ds18b20", "aht20_temp", "aht20_humidity", "lux", "chip_temp"
+};
+static const char* const channelUnits[SENSOR_CHANNEL_COUNT] = {
+    "C", "C", "%RH", "lux", "C"
+};
+
+// --- Hub State ---
+static TaskHandle_t hubTaskHandle = NULL;
+static HubChannel channels[SENSOR_CHANNEL_COUNT];
+static HubDriver drivers[HUB_MAX_DRIVERS];
+static volatile uint8_t driver_count = 0;
+static HubSubscriber subscribers[HUB_MAX_SUBSCRIBERS];
+static portMUX_TYPE hub_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// =====================================================================================
+//                                      HUB TASK
+// =====================================================================================
+
+// Runs every polled driver that is due, then sleeps until the next one is.
+static void SensorHub_Task(void *pvParameters) {
+    for (;;) {
+        uint32_t wait_ms = HUB_IDLE_WAIT_MS;
+        uint8_t count = driver_count;
+        for (uint8_t i = 0; i < count; i++) {
+            HubDriver& d = drivers[i];
+            if (d.poll == NULL) continue;
+
+            uint32_t now = millis();
+            if ((int32_t)(now - d.next_ms) >= 0) {
+                d.poll();
+                d.next_ms += d.period_ms;
+                now = millis();
+                // A slow read skips periods instead of bursting to catch up
+                if ((int32_t)(now - d.next_ms) >= 0) d.next_ms = now + d.period_ms;
+            }
+            uint32_t until = d.next_ms - now;
+            if (until < wait_ms) wait_ms = until;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+    }
+}
+
+// Internal temperature sensor, roughly the die temperature.
+static void pollChipTemp() {
+    SensorHub_Publish(SENSOR_CHIP_TEMP, temperatureRead());
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void SensorHub_Init() {
+    if (hubTaskHandle != NULL) return;
+    xTaskCreate(SensorHub_Task, "SensorHub", 3072, NULL, 1, &hubTaskHandle);
+    SensorHub_RegisterDriver("chip", CHIP_TEMP_PERIOD_MS, pollChipTemp);
+}
+
+bool SensorHub_RegisterDriver(const char* name, uint32_t period_ms, SensorPollFn poll) {
+    if (period_ms == 0) return false;
+    bool added = false;
+    taskENTER_CRITICAL(&hub_mux);
+    if (driver_count < HUB_MAX_DRIVERS) {
+        HubDriver& d = drivers[driver_count];
+        d.name = name;
+        d.period_ms = period_ms;
+        d.poll = poll;
+        d.next_ms = millis(); // First read right away
+        driver_count = driver_count + 1;
+        added = true;
+    }
+    taskEXIT_CRITICAL(&hub_mux);
+
+    if (!added) {
+        Serial.printf("SensorHub: no room for driver %s\n", name);
+        return false;
+    }
+    Serial.printf("SensorHub: %s every %lu ms\n", name, (unsigned long)period_ms);
+    if (poll != NULL && hubTaskHandle != NULL) xTaskNotifyGive(hubTaskHandle);
+    return true;
+}
+
+void SensorHub_Publish(SensorChannel channel, float value) {
+    if (channel >= SENSOR_CHANNEL_COUNT) return;
+    HubChannel& c = channels[channel];
+    SensorSample sample = { value, millis() };
+    uint32_t head = c.head;
+    c.value[head & HUB_RING_MASK] = sample.value;
+    c.time_ms[head & HUB_RING_MASK] = sample.time_ms;
+    c.head = head + 1;
+
+    // Callbacks run outside the critical section
+    HubSubscriber targets[HUB_MAX_SUBSCRIBERS];
+    taskENTER_CRITICAL(&hub_mux);
+    memcpy(targets, subscribers, sizeof(targets));
+    taskEXIT_CRITICAL(&hub_mux);
+    for (int i = 0; i < HUB_MAX_SUBSCRIBERS; i++) {
+        if (targets[i].callback != NULL && (targets[i].channels & SENSOR_MASK(channel))) {
+            targets[i].callback(channel, sample);
+        }
+    }
+}
+
+size_t SensorHub_History(SensorChannel channel, SensorSample* out, size_t max) {
+    if (channel >= SENSOR_CHANNEL_COUNT || max == 0) return 0;
+    HubChannel& c = channels[channel];
+
+    uint32_t head = c.head;
+    uint32_t n = head;
+    if (n > HUB_RING_LEN) n = HUB_RING_LEN;
+    if (n > max) n = max;
+    uint32_t first = head - n;
+    for (uint32_t k = 0; k < n; k++) {
+        uint32_t slot = (first + k) & HUB_RING_MASK;
+        out[k].value = c.value[slot];
+        out[k].time_ms = c.time_ms[slot];
+    }
+
+    // The writer may have lapped the oldest slots while they were copied;
+    // the slot at the new head may be half written too.
+    uint32_t after = c.head;
+    if (after - first > HUB_RING_LEN - 1) {
+        uint32_t drop = after - (HUB_RING_LEN - 1) - first;
+        if (drop > n) drop = n;
+        memmove(out, out + drop, (n - drop) * sizeof(SensorSample));
+        n -= drop;
+    }
+    return n;
+}
+
+bool SensorHub_Latest(SensorChannel channel, SensorSample* sample) {
+    return SensorHub_History(channel, sample, 1) == 1;
+}
+
+float SensorHub_Value(SensorChannel channel, float fallback) {
+    SensorSample sample;
+    return SensorHub_Latest(channel, &sample) ? sample.value : fallback;
+}
+
+bool SensorHub_Subscribe(SensorCallback callback, uint32_t channels) {
+    bool added = false;
+    taskENTER_CRITICAL(&hub_mux);
+    for (int i = 0; i < HUB_MAX_SUBSCRIBERS && !added; i++) {
+        if (subscribers[i].callback == callback) {
+            subscribers[i].channels = channels;
+            added = true;
+        }
+    }
+    for (int i = 0; i < HUB_MAX_SUBSCRIBERS && !added; i++) {
+        if (subscribers[i].callback == NULL) {
+            subscribers[i].callback = callback;
+            subscribers[i].channels = channels;
+            added = true;
+        }
+    }
+    taskEXIT_CRITICAL(&hub_mux);
+    return added;
+}
+
+void SensorHub_Unsubscribe(SensorCallback callback) {
+    taskENTER_CRITICAL(&hub_mux);
+    for (int i = 0; i < HUB_MAX_SUBSCRIBERS; i++) {
+        if (subscribers[i].callback == callback) {
+            subscribers[i].callback = NULL;
+            subscribers[i].channels = 0;
+        }
+    }
+    taskEXIT_CRITICAL(&hub_mux);
+}
+
+const char* SensorHub_ChannelName(SensorChannel channel) {
+    return (channel < SENSOR_CHANNEL_COUNT) ? channelNames[channel] : "";
+}
+
+const char* SensorHub_ChannelUnit(SensorChannel channel) {
+    return (channel < SENSOR_CHANNEL_COUNT) ? channelUnits[channel] : "";
+}
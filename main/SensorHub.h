@@ -0,0 +1,62 @@
+#ifndef SENSOR_HUB_H
+#define SENSOR_HUB_H
+
+#include <Arduino.h>
+
+// Single owner of all sensor readings. Each driver registers once with its
+// sample period: polled drivers are called on the hub task when they are due,
+// drivers with their own task (DS18B20) publish from it. Every channel keeps
+// its newest HUB_RING_LEN timestamped samples in a ring with one writer, so
+// readers never lock and never touch hardware.
+#define HUB_RING_LEN          64      // Samples per channel, power of two
+#define HUB_MAX_DRIVERS       8
+#define HUB_MAX_SUBSCRIBERS   8
+
+enum SensorChannel : uint8_t {
+    SENSOR_DS18B20_TEMP = 0,    // C, first probe on the bus; -127 after a failed read
+    SENSOR_AHT20_TEMP,          // C
+    SENSOR_AHT20_HUMIDITY,      // %RH
+    SENSOR_LUX,                 // lux, photoresistor on the ADC
+    SENSOR_CHIP_TEMP,           // C, ESP32-C3 internal sensor
+    SENSOR_CHANNEL_COUNT
+};
+
+#define SENSOR_MASK(channel)  (1UL << (channel))
+#define SENSOR_MASK_ALL       ((1UL << SENSOR_CHANNEL_COUNT) - 1)
+
+struct SensorSample {
+    float value;
+    uint32_t time_ms;           // millis() when it was read
+};
+
+// Polled driver: reads its hardware and calls SensorHub_Publish for its channels.
+typedef void (*SensorPollFn)();
+// Called on the publishing task; keep it short.
+typedef void (*SensorCallback)(SensorChannel channel, const SensorSample& sample);
+
+// Creates the hub task and registers the chip temperature driver.
+// Call before any driver registers.
+void SensorHub_Init();
+
+// `poll` runs every `period_ms` on the hub task. Pass NULL for drivers that
+// publish from their own task; the period is then informational.
+bool SensorHub_RegisterDriver(const char* name, uint32_t period_ms, SensorPollFn poll);
+
+// One writer per channel: the driver that owns it.
+void SensorHub_Publish(SensorChannel channel, float value);
+
+// Newest sample. False until the channel has published once.
+bool SensorHub_Latest(SensorChannel channel, SensorSample* sample);
+// Newest value, or `fallback` if there is none yet.
+float SensorHub_Value(SensorChannel channel, float fallback);
+// Copies up to `max` of the newest samples, oldest first. Returns the count.
+size_t SensorHub_History(SensorChannel channel, SensorSample* out, size_t max);
+
+// `channels` is a SENSOR_MASK() combination.
+bool SensorHub_Subscribe(SensorCallback callback, uint32_t channels);
+void SensorHub_Unsubscribe(SensorCallback callback);
+
+const char* SensorHub_ChannelName(SensorChannel channel);
+const char* SensorHub_ChannelUnit(SensorChannel channel);
+
+#endif // SENSOR_HUB_H
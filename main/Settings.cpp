@@ -0,0 +1,215 @@
+#include "Settings.h"
+#include <LittleFS.h>
+#include <rom/crc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#define SETTINGS_JOURNAL_PATH  SETTINGS_DIR "/journal.bin"
+#define SETTINGS_TEMP_PATH     SETTINGS_DIR "/journal.tmp"
+#define SETTINGS_RECORD_MAGIC  0x5E
+#define SETTINGS_FLAG_REMOVED  0x01
+
+// --- On-flash record layout ---
+// [header][value bytes], crc covers the header (with crc = 0) and the value.
+struct SettingsRecordHeader {
+    uint8_t  magic;
+    uint8_t  key;
+    uint8_t  version;
+    uint8_t  flags;
+    uint16_t length;
+    uint16_t reserved;
+    uint32_t crc;
+};
+
+struct SettingsEntry {
+    bool     present;
+    uint8_t  version;
+    uint16_t length;
+    uint8_t* data;
+};
+
+// --- Module-internal State ---
+static SemaphoreHandle_t settings_mutex = NULL;
+static SettingsEntry entries[SETTINGS_KEY_COUNT];
+static uint32_t journal_size = 0;
+
+// =====================================================================================
+//                                     JOURNAL HELPERS
+// =====================================================================================
+
+static uint32_t recordCrc(SettingsRecordHeader hdr, const uint8_t* data) {
+    hdr.crc = 0;
+    uint32_t crc = crc32_le(0, (const uint8_t*)&hdr, sizeof(hdr));
+    return crc32_le(crc, data, hdr.length);
+}
+
+// Replaces the cached value of a key. Returns false if out of memory.
+static bool setEntry(uint8_t key, uint8_t version, const uint8_t* data, size_t length) {
+    SettingsEntry& e = entries[key];
+    if (!e.present || e.length != length) {
+        uint8_t* buf = (uint8_t*)realloc(e.data, length ? length : 1);
+        if (buf == NULL) return false;
+        e.data = buf;
+    }
+    memcpy(e.data, data, length);
+    e.length = length;
+    e.version = version;
+    e.present = true;
+    return true;
+}
+
+static void clearEntry(uint8_t key) {
+    SettingsEntry& e = entries[key];
+    free(e.data);
+    e.data = NULL;
+    e.present = false;
+    e.length = 0;
+}
+
+static bool writeRecord(File& f, uint8_t key, uint8_t version, uint8_t flags, const uint8_t* data, size_t length) {
+    uint8_t record[sizeof(SettingsRecordHeader) + SETTINGS_MAX_VALUE];
+    SettingsRecordHeader hdr = {SETTINGS_RECORD_MAGIC, key, version, flags, (uint16_t)length, 0, 0};
+    hdr.crc = recordCrc(hdr, data);
+    memcpy(record, &hdr, sizeof(hdr));
+    if (length > 0) memcpy(record + sizeof(hdr), data, length);
+    // One write per record so a power cut leaves at most one torn record at the tail
+    return f.write(record, sizeof(hdr) + length) == sizeof(hdr) + length;
+}
+
+// Replays the journal. Returns false if it ended in a torn or corrupt record.
+static bool replayJournal() {
+    File f = LittleFS.open(SETTINGS_JOURNAL_PATH, "r");
+    if (!f) return true;
+
+    bool clean = true;
+    uint8_t data[SETTINGS_MAX_VALUE];
+    SettingsRecordHeader hdr;
+    journal_size = 0;
+    while (f.available()) {
+        if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)
+            || hdr.magic != SETTINGS_RECORD_MAGIC || hdr.key == 0 || hdr.key >= SETTINGS_KEY_COUNT
+            || hdr.length > SETTINGS_MAX_VALUE
+            || f.read(data, hdr.length) != hdr.length
+            || recordCrc(hdr, data) != hdr.crc) {
+            clean = false;
+            break;
+        }
+        if (hdr.flags & SETTINGS_FLAG_REMOVED) clearEntry(hdr.key);
+        else setEntry(hdr.key, hdr.version, data, hdr.length);
+        journal_size += sizeof(hdr) + hdr.length;
+    }
+    f.close();
+    return clean;
+}
+
+// Rewrites the journal with only the current value of each key. The new file
+// is written aside and renamed over the old one, so a crash keeps one of them.
+static bool compactJournal() {
+    File f = LittleFS.open(SETTINGS_TEMP_PATH, "w");
+    if (!f) return false;
+    uint32_t size = 0;
+    bool ok = true;
+    for (uint8_t key = 1; key < SETTINGS_KEY_COUNT && ok; key++) {
+        const SettingsEntry& e = entries[key];
+        if (!e.present) continue;
+        ok = writeRecord(f, key, e.version, 0, e.data, e.length);
+        size += sizeof(SettingsRecordHeader) + e.length;
+    }
+    f.close();
+    if (!ok) {
+        LittleFS.remove(SETTINGS_TEMP_PATH);
+        return false;
+    }
+    LittleFS.remove(SETTINGS_JOURNAL_PATH);
+    if (!LittleFS.rename(SETTINGS_TEMP_PATH, SETTINGS_JOURNAL_PATH)) return false;
+    journal_size = size;
+    Serial.printf("Settings: journal compacted to %u bytes\n", (unsigned)size);
+    return true;
+}
+
+static bool appendRecord(uint8_t key, uint8_t version, uint8_t flags, const uint8_t* data, size_t length) {
+    if (journal_size + sizeof(SettingsRecordHeader) + length > SETTINGS_JOURNAL_MAX) {
+        // The cache already holds the new value: compaction writes it out
+        return compactJournal();
+    }
+    File f = LittleFS.open(SETTINGS_JOURNAL_PATH, "a");
+    if (!f) return false;
+    bool ok = writeRecord(f, key, version, flags, data, length);
+    f.close();
+    if (ok) journal_size += sizeof(SettingsRecordHeader) + length;
+    return ok;
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+bool Settings_Init() {
+    if (settings_mutex != NULL) return true;
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("Settings: LittleFS mount failed");
+        return false;
+    }
+    if (!LittleFS.exists(SETTINGS_DIR)) {
+        LittleFS.mkdir(SETTINGS_DIR);
+    }
+
+    // Finish or discard an interrupted compaction
+    if (LittleFS.exists(SETTINGS_TEMP_PATH)) {
+        if (LittleFS.exists(SETTINGS_JOURNAL_PATH)) LittleFS.remove(SETTINGS_TEMP_PATH);
+        else LittleFS.rename(SETTINGS_TEMP_PATH, SETTINGS_JOURNAL_PATH);
+    }
+
+    memset(entries, 0, sizeof(entries));
+    if (!replayJournal()) {
+        // Never append after a torn record: rewrite what was recovered
+        Serial.println("Settings: torn journal tail, compacting");
+        compactJournal();
+    }
+
+    settings_mutex = xSemaphoreCreateMutex();
+    Serial.printf("Settings: journal %u bytes\n", (unsigned)journal_size);
+    return true;
+}
+
+bool Settings_Load(SettingsKey key, uint8_t version, void* data, size_t size) {
+    if (settings_mutex == NULL || key == 0 || key >= SETTINGS_KEY_COUNT) return false;
+    if (xSemaphoreTake(settings_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+    const SettingsEntry& e = entries[key];
+    bool ok = e.present && e.version == version && e.length == size;
+    if (ok) memcpy(data, e.data, size);
+
+    xSemaphoreGive(settings_mutex);
+    return ok;
+}
+
+bool Settings_Save(SettingsKey key, uint8_t version, const void* data, size_t size) {
+    if (settings_mutex == NULL || key == 0 || key >= SETTINGS_KEY_COUNT || size > SETTINGS_MAX_VALUE) return false;
+    if (xSemaphoreTake(settings_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+    const SettingsEntry& e = entries[key];
+    bool ok = true;
+    if (!e.present || e.version != version || e.length != size || memcmp(e.data, data, size) != 0) {
+        ok = setEntry(key, version, (const uint8_t*)data, size)
+             && appendRecord(key, version, 0, (const uint8_t*)data, size);
+    }
+
+    xSemaphoreGive(settings_mutex);
+    return ok;
+}
+
+bool Settings_Remove(SettingsKey key) {
+    if (settings_mutex == NULL || key == 0 || key >= SETTINGS_KEY_COUNT) return false;
+    if (xSemaphoreTake(settings_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+    bool ok = true;
+    if (entries[key].present) {
+        clearEntry(key);
+        ok = appendRecord(key, 0, SETTINGS_FLAG_REMOVED, NULL, 0);
+    }
+
+    xSemaphoreGive(settings_mutex);
+    return ok;
+}
@@ -0,0 +1,40 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <Arduino.h>
+
+// Typed key-value settings store, journaled on LittleFS.
+// Every save appends one small CRC-protected record, and only when the value
+// actually changed. The journal is replayed at boot (last valid record per key
+// wins) and compacted into a fresh file once it grows past SETTINGS_JOURNAL_MAX.
+// Each key carries a schema version; a load with a different version fails so
+// the owner can migrate or fall back to defaults.
+#define SETTINGS_DIR          "/settings"
+#define SETTINGS_JOURNAL_MAX  4096   // Compact when the journal exceeds this
+#define SETTINGS_MAX_VALUE    256    // Largest single value in bytes
+
+enum SettingsKey : uint8_t {
+    SETTINGS_KEY_ALARMS = 1,
+    SETTINGS_KEY_TARGETS,
+    SETTINGS_KEY_WIFI,
+    SETTINGS_KEY_WIFI_LEASE,
+    SETTINGS_KEY_PLAY_MODE,
+    SETTINGS_KEY_LED,
+    SETTINGS_KEY_MUSIC_OUTPUT,
+    SETTINGS_KEY_COUNT
+};
+
+// Mounts LittleFS if needed and replays the journal into RAM.
+bool Settings_Init();
+
+// Copies a stored value into `data`. Fails if the key is missing or was
+// written with a different version or size.
+bool Settings_Load(SettingsKey key, uint8_t version, void* data, size_t size);
+
+// Stores a value. A no-op if it is identical to what is already stored.
+bool Settings_Save(SettingsKey key, uint8_t version, const void* data, size_t size);
+
+// Deletes a key.
+bool Settings_Remove(SettingsKey key);
+
+#endif // SETTINGS_H
@@ -0,0 +1,250 @@
+#include "Spectrum.h"
+#include "Menu.h"
+#include "Alarm.h"
+#include "RotaryEncoder.h"
+#include <TFT_eSPI.h>
+#include <arduinoFFT.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "ADC.h"
+
+#define SPECTRUM_RING_MASK     (SPECTRUM_RING_LEN - 1)
+#define SPECTRUM_BINS          (SPECTRUM_FFT_SIZE / 2)
+
+// --- Layout ---
+#define PLOT_X        10
+#define PLOT_Y        40
+#define PLOT_W        220
+#define PLOT_H        SPECTRUM_BINS   // One row per bin in the spectrogram
+#define BAR_COUNT     32
+#define BAR_W         (PLOT_W / BAR_COUNT)
+#define PEAK_HOLD_FRAMES 15            // About half a second
+#define PEAK_FALL_PX  2
+
+// Levels are 8 * log2(magnitude), so 8 steps = 6 dB. The shown range runs
+// from about one ADC count of noise up to a full-scale sine.
+#define LEVEL_FLOOR   (7 * 8)
+#define LEVEL_RANGE   (13 * 8)
+
+enum SpectrumView {
+    VIEW_BARS,
+    VIEW_SPECTROGRAM,
+    VIEW_COUNT
+};
+
+// --- Capture State (written by the ADC sampler through the tap) ---
+static TaskHandle_t consumerTask = NULL;        // Notified after every hop
+static int16_t ring[SPECTRUM_RING_LEN];
+static volatile uint32_t ring_head = 0;         // Samples written, ever
+static uint32_t last_hop = 0;
+
+// --- Analysis State (screen task only) ---
+static int16_t vReal[SPECTRUM_FFT_SIZE];
+static int16_t vImag[SPECTRUM_FFT_SIZE];
+static uint8_t levels[SPECTRUM_BINS];
+static uint8_t peak_height[BAR_COUNT];
+static uint8_t peak_age[BAR_COUNT];
+static uint16_t heat_palette[64];
+
+// =====================================================================================
+//                                      CAPTURE
+// =====================================================================================
+
+// Runs on the ADC sampler task for every DMA frame.
+static void onSamples(const uint16_t* samples, size_t count) {
+    uint32_t head = ring_head;
+    for (size_t i = 0; i < count; i++) {
+        ring[head & SPECTRUM_RING_MASK] = samples[i];
+        head++;
+    }
+    ring_head = head;
+    if (head - last_hop >= SPECTRUM_HOP) {
+        last_hop = head;
+        TaskHandle_t consumer = consumerTask;
+        if (consumer != NULL) xTaskNotifyGive(consumer);
+    }
+}
+
+// =====================================================================================
+//                                      ANALYSIS
+// =====================================================================================
+
+// 8 * log2(v), with three fractional bits from the bits below the top one.
+static uint16_t log2Q3(uint32_t v) {
+    if (v == 0) return 0;
+    int top = 31 - __builtin_clz(v);
+    uint32_t frac = (top >= 3) ? (v >> (top - 3)) & 7 : (v << (3 - top)) & 7;
+    return top * 8 + frac;
+}
+
+// Runs one frame over the newest samples. Returns the dominant frequency in Hz.
+static float analyseFrame(ArduinoFFT<int16_t>& fft) {
+    uint32_t head = ring_head;
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        vReal[i] = (int16_t)(ring[(head - SPECTRUM_FFT_SIZE + i) & SPECTRUM_RING_MASK] << 3); // 12 bit -> Q15
+        vImag[i] = 0;
+    }
+    fft.dcRemoval();
+    fft.windowing(FFTWindow::Hann, FFTDirection::Forward);
+    fft.compute(FFTDirection::Forward);
+    fft.complexToMagnitude();
+
+    uint8_t exponent = fft.blockExponent();
+    for (int b = 0; b < SPECTRUM_BINS; b++) {
+        int level = (int)log2Q3((uint32_t)vReal[b]) + exponent * 8 - LEVEL_FLOOR;
+        if (level < 0) level = 0;
+        if (level > LEVEL_RANGE) level = LEVEL_RANGE;
+        levels[b] = level;
+    }
+    return fft.majorPeak();
+}
+
+// =====================================================================================
+//                                       DRAWING
+// =====================================================================================
+
+// Black -> blue -> red -> yellow -> white
+static void buildPalette() {
+    for (int i = 0; i < 64; i++) {
+        uint8_t r, g, b;
+        if (i < 16)      { r = 0;            g = 0;            b = i * 16; }
+        else if (i < 32) { r = (i - 16) * 16; g = 0;            b = 255 - (i - 16) * 16; }
+        else if (i < 48) { r = 255;          g = (i - 32) * 16; b = 0; }
+        else             { r = 255;          g = 255;          b = (i - 48) * 16; }
+        heat_palette[i] = menuSprite.color565(r, g, b);
+    }
+}
+
+static void drawHeader(float peak_hz, SpectrumView view) {
+    menuSprite.fillRect(0, 0, 239, PLOT_Y - 2, TFT_BLACK);
+    menuSprite.setTextDatum(TL_DATUM);
+    menuSprite.setTextColor(TFT_WHITE, TFT_BLACK);
+    menuSprite.setTextSize(2);
+    menuSprite.drawString("Spectrum", 10, 6);
+    menuSprite.setTextSize(1);
+    char buf[24];
+    snprintf(buf, sizeof(buf), "Peak %6.1f Hz", peak_hz);
+    menuSprite.setTextColor(TFT_YELLOW, TFT_BLACK);
+    menuSprite.drawString(buf, 130, 6);
+    menuSprite.setTextColor(TFT_DARKGREY, TFT_BLACK);
+    menuSprite.drawString(view == VIEW_BARS ? "Bars" : "Spectrogram", 130, 20);
+    if (view == VIEW_SPECTROGRAM) menuSprite.drawString("2 kHz", PLOT_X, PLOT_Y - 10); // Top of the frequency axis
+}
+
+// Bars run along x in frequency; the spectrogram has time along x and
+// frequency up the y axis, its top labelled by drawHeader.
+static void drawFooter(SpectrumView view) {
+    int y = PLOT_Y + PLOT_H + 6;
+    menuSprite.fillRect(0, y - 2, 239, 239 - y + 2, TFT_BLACK);
+    menuSprite.setTextSize(1);
+    menuSprite.setTextColor(TFT_DARKGREY, TFT_BLACK);
+    menuSprite.setTextDatum(TL_DATUM);
+    if (view == VIEW_BARS) {
+        menuSprite.drawString("0", PLOT_X, y);
+        menuSprite.setTextDatum(TC_DATUM);
+        menuSprite.drawString("1 kHz", PLOT_X + PLOT_W / 2, y);
+        menuSprite.setTextDatum(TR_DATUM);
+        menuSprite.drawString("2 kHz", PLOT_X + PLOT_W, y);
+    } else {
+        menuSprite.drawString("0 Hz", PLOT_X, y);
+        menuSprite.setTextDatum(TC_DATUM);
+        menuSprite.drawString("time ->", PLOT_X + PLOT_W / 2, y);
+        menuSprite.setTextDatum(TR_DATUM);
+        menuSprite.drawString("now", PLOT_X + PLOT_W, y);
+    }
+    menuSprite.setTextDatum(TC_DATUM);
+    menuSprite.drawString("Turn: view   Press: exit", 120, y + 16);
+    menuSprite.setTextDatum(TL_DATUM);
+}
+
+// Linear frequency bars, SPECTRUM_BINS / BAR_COUNT bins each, with peak hold.
+static void drawBars() {
+    const int bins_per_bar = SPECTRUM_BINS / BAR_COUNT;
+    menuSprite.fillRect(PLOT_X, PLOT_Y, PLOT_W, PLOT_H, TFT_BLACK);
+    for (int bar = 0; bar < BAR_COUNT; bar++) {
+        uint8_t level = 0;
+        for (int k = 0; k < bins_per_bar; k++) {
+            uint8_t l = levels[bar * bins_per_bar + k];
+            if (l > level) level = l;
+        }
+        int h = level * PLOT_H / LEVEL_RANGE;
+
+        if (h >= peak_height[bar]) {
+            peak_height[bar] = h;
+            peak_age[bar] = 0;
+        } else if (peak_age[bar] < PEAK_HOLD_FRAMES) {
+            peak_age[bar]++;
+        } else {
+            peak_height[bar] = (peak_height[bar] > h + PEAK_FALL_PX) ? peak_height[bar] - PEAK_FALL_PX : h;
+        }
+
+        int x = PLOT_X + bar * BAR_W;
+        uint16_t color = heat_palette[16 + level * 47 / LEVEL_RANGE];
+        menuSprite.fillRect(x, PLOT_Y + PLOT_H - h, BAR_W - 1, h, color);
+        menuSprite.drawFastHLine(x, PLOT_Y + PLOT_H - peak_height[bar], BAR_W - 1, TFT_WHITE);
+    }
+}
+
+// Scrolls the history left by a pixel and draws the new frame as the
+// rightmost column, low frequencies at the bottom.
+static void drawSpectrogramColumn() {
+    menuSprite.scroll(-1, 0);
+    int x = PLOT_X + PLOT_W - 1;
+    for (int b = 0; b < SPECTRUM_BINS; b++) {
+        menuSprite.drawPixel(x, PLOT_Y + PLOT_H - 1 - b, heat_palette[levels[b] * 63 / LEVEL_RANGE]);
+    }
+}
+
+static void resetView(SpectrumView view) {
+    menuSprite.fillSprite(TFT_BLACK);
+    memset(peak_height, 0, sizeof(peak_height));
+    memset(peak_age, 0, sizeof(peak_age));
+    if (view == VIEW_SPECTROGRAM) {
+        menuSprite.setScrollRect(PLOT_X, PLOT_Y, PLOT_W, PLOT_H, TFT_BLACK);
+    }
+    drawFooter(view);
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+void SpectrumMenu() {
+    buildPalette();
+    ArduinoFFT<int16_t> fft(vReal, vImag, SPECTRUM_FFT_SIZE, SPECTRUM_SAMPLE_RATE);
+    SpectrumView view = VIEW_BARS;
+    uint32_t previous_rate = ADC_SampleRate();
+    ring_head = 0;
+    last_hop = 0;
+    consumerTask = xTaskGetCurrentTaskHandle();
+    xTaskNotifyStateClear(NULL);
+    ADC_SetSampleRate(SPECTRUM_SAMPLE_RATE);
+    ADC_SetSampleTap(onSamples);
+    resetView(view);
+
+    while (1) {
+        if (exitSubMenu || g_alarm_is_ringing || readButton()) {
+            exitSubMenu = false;
+            break;
+        }
+        int encoderChange = readEncoder();
+        if (encoderChange != 0) {
+            view = (SpectrumView)((view + 1) % VIEW_COUNT);
+            resetView(view);
+        }
+
+        // One frame per hop; frames are dropped, not queued, if drawing lags
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)) == 0) continue;
+        if (ring_head < SPECTRUM_FFT_SIZE) continue;
+
+        float peak_hz = analyseFrame(fft);
+        if (view == VIEW_BARS) drawBars();
+        else drawSpectrogramColumn();
+        drawHeader(peak_hz, view);
+        menuSprite.pushSprite(0, 0);
+    }
+
+    ADC_SetSampleTap(NULL);
+    consumerTask = NULL;
+    ADC_SetSampleRate(previous_rate);
+}
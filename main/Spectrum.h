@@ -0,0 +1,18 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <Arduino.h>
+
+// Spectrum analyzer on the ADC header (photoresistor, or a mic on the same pin).
+// While it runs, the ADC sampler runs at SPECTRUM_SAMPLE_RATE and its sample tap
+// fills a ring; the screen takes the newest SPECTRUM_FFT_SIZE samples from it
+// for each frame, so sampling never stops while a frame is analysed or drawn.
+// Each frame is Hann-windowed and transformed with the Q15 FFT.
+#define SPECTRUM_SAMPLE_RATE   4000    // Hz, shows 0-2 kHz
+#define SPECTRUM_FFT_SIZE      256     // 15.6 Hz per bin
+#define SPECTRUM_HOP           128     // New samples per frame, 50 % overlap
+#define SPECTRUM_RING_LEN      1024    // Capture ring, power of two
+
+void SpectrumMenu();
+
+#endif // SPECTRUM_H
@@ -0,0 +1,228 @@
+#include "Synth.h"
+#include "Buzzer.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <driver/i2s.h>
+#include <esp_timer.h>
+#include <soc/i2s_periph.h>
+
+#define SYNTH_I2S_PORT       I2S_NUM_0
+#define SYNTH_LEVEL_FULL     (1 << 24)               // Envelope levels are Q24
+#define SYNTH_OSC_PEAK       8191                    // Four voices at full level fit in int16
+#define SYNTH_WAVETABLE_LEN  256
+
+// Envelope, in samples
+#define SYNTH_ATTACK         (SYNTH_SAMPLE_RATE * 5 / 1000)
+#define SYNTH_DECAY          (SYNTH_SAMPLE_RATE * 150 / 1000)
+#define SYNTH_SUSTAIN        (SYNTH_LEVEL_FULL / 2)
+#define SYNTH_RELEASE        (SYNTH_SAMPLE_RATE * 80 / 1000)
+
+enum EnvelopeStage : uint8_t {
+    ENV_OFF,
+    ENV_ATTACK,
+    ENV_DECAY,
+    ENV_SUSTAIN,
+    ENV_RELEASE
+};
+
+struct SynthVoice {
+    uint32_t phase;
+    uint32_t increment;     // Phase step per sample, 2^32 = one cycle
+    int32_t  level;         // Q24
+    EnvelopeStage stage;
+    uint8_t  seen_trigger;
+};
+
+// --- Voice registers (any task writes, render task reads) ---
+static volatile uint32_t reg_increment[SYNTH_VOICES];
+static volatile uint8_t reg_gate[SYNTH_VOICES];
+static volatile uint8_t reg_trigger[SYNTH_VOICES];     // Bumped on every note-on
+static volatile uint8_t reg_wave = SYNTH_WAVE_TRIANGLE;
+
+// --- Render State ---
+static TaskHandle_t synthTaskHandle = NULL;
+static SemaphoreHandle_t stopped_sem = NULL;
+static volatile bool keep_running = false;
+static SynthVoice voices[SYNTH_VOICES];
+static int16_t wavetable[SYNTH_WAVETABLE_LEN];
+static volatile uint16_t peak_load = 0;
+
+// =====================================================================================
+//                                       RENDER
+// =====================================================================================
+
+// Advances one voice's envelope by a block and returns the level at its end.
+static int32_t envelopeStep(SynthVoice& v) {
+    switch (v.stage) {
+        case ENV_ATTACK:
+            v.level += SYNTH_LEVEL_FULL / SYNTH_ATTACK * SYNTH_BLOCK;
+            if (v.level >= SYNTH_LEVEL_FULL) { v.level = SYNTH_LEVEL_FULL; v.stage = ENV_DECAY; }
+            break;
+        case ENV_DECAY:
+            v.level -= (SYNTH_LEVEL_FULL - SYNTH_SUSTAIN) / SYNTH_DECAY * SYNTH_BLOCK;
+            if (v.level <= SYNTH_SUSTAIN) { v.level = SYNTH_SUSTAIN; v.stage = ENV_SUSTAIN; }
+            break;
+        case ENV_RELEASE:
+            v.level -= SYNTH_LEVEL_FULL / SYNTH_RELEASE * SYNTH_BLOCK;
+            if (v.level <= 0) { v.level = 0; v.stage = ENV_OFF; }
+            break;
+        default:
+            break;
+    }
+    return v.level;
+}
+
+// Picks up note-on/off from the registers at the start of a block.
+static void syncVoice(int i) {
+    SynthVoice& v = voices[i];
+    uint8_t trigger = reg_trigger[i];
+    if (trigger != v.seen_trigger) {
+        v.seen_trigger = trigger;
+        v.increment = reg_increment[i];
+        v.stage = ENV_ATTACK;
+    } else if (!reg_gate[i] && v.stage != ENV_OFF && v.stage != ENV_RELEASE) {
+        v.stage = ENV_RELEASE;
+    }
+}
+
+static void renderBlock(int16_t* out) {
+    int32_t mix[SYNTH_BLOCK];
+    memset(mix, 0, sizeof(mix));
+    uint8_t wave = reg_wave;
+
+    for (int i = 0; i < SYNTH_VOICES; i++) {
+        syncVoice(i);
+        SynthVoice& v = voices[i];
+        if (v.stage == ENV_OFF) continue;
+
+        // Ramp the level linearly across the block to avoid zipper noise
+        int32_t level = v.level;
+        int32_t step = (envelopeStep(v) - level) / SYNTH_BLOCK;
+        uint32_t phase = v.phase;
+        uint32_t increment = v.increment;
+        for (int n = 0; n < SYNTH_BLOCK; n++) {
+            phase += increment;
+            int32_t osc;
+            if (wave == SYNTH_WAVE_SQUARE) {
+                osc = (phase & 0x80000000) ? -SYNTH_OSC_PEAK : SYNTH_OSC_PEAK;
+            } else if (wave == SYNTH_WAVE_TRIANGLE) {
+                uint32_t x = phase >> 16;                                   // 0..65535
+                osc = (int32_t)((x < 32768) ? x : 65535 - x) / 2 - 8192;    // -8192..8191
+            } else {
+                osc = wavetable[phase >> 24];
+            }
+            mix[n] += (osc * (level >> 9)) >> 15;                           // Q24 -> Q15 gain
+            level += step;
+        }
+        v.phase = phase;
+    }
+
+    for (int n = 0; n < SYNTH_BLOCK; n++) out[n] = (int16_t)mix[n];
+}
+
+static void Synth_Task(void *pvParameters) {
+    static int16_t block[SYNTH_BLOCK];
+    const int64_t block_us = (int64_t)SYNTH_BLOCK * 1000000 / SYNTH_SAMPLE_RATE;
+
+    while (keep_running) {
+        int64_t start = esp_timer_get_time();
+        renderBlock(block);
+        uint16_t load = (esp_timer_get_time() - start) * 1000 / block_us;
+        if (load > peak_load) peak_load = load;
+
+        size_t written;
+        i2s_write(SYNTH_I2S_PORT, block, sizeof(block), &written, portMAX_DELAY); // Paces the task
+    }
+
+    i2s_driver_uninstall(SYNTH_I2S_PORT);
+    pinMode(BUZZER_PIN, OUTPUT);
+    digitalWrite(BUZZER_PIN, LOW);
+    synthTaskHandle = NULL;
+    xSemaphoreGive(stopped_sem);
+    vTaskDelete(NULL);
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+bool Synth_Start() {
+    if (synthTaskHandle != NULL) return true;
+    if (stopped_sem == NULL) {
+        stopped_sem = xSemaphoreCreateBinary();
+        // One sine cycle for the wavetable voice, built once
+        for (int i = 0; i < SYNTH_WAVETABLE_LEN; i++) {
+            wavetable[i] = (int16_t)(sinf(2.0f * PI * i / SYNTH_WAVETABLE_LEN) * SYNTH_OSC_PEAK);
+        }
+    }
+
+    i2s_config_t config = {};
+    config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX | I2S_MODE_PDM);
+    config.sample_rate = SYNTH_SAMPLE_RATE;
+    config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+    config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+    config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+    config.intr_alloc_flags = 0;
+    config.dma_buf_count = SYNTH_DMA_BUFFERS;
+    config.dma_buf_len = SYNTH_BLOCK;
+    config.tx_desc_auto_clear = true; // Silence rather than a repeated buffer on underrun
+    if (i2s_driver_install(SYNTH_I2S_PORT, &config, 0, NULL) != ESP_OK) {
+        Serial.println("Synth: I2S driver install failed");
+        return false;
+    }
+
+    i2s_pin_config_t pins = {};
+    pins.mck_io_num = I2S_PIN_NO_CHANGE;
+    pins.bck_io_num = I2S_PIN_NO_CHANGE;
+    pins.ws_io_num = I2S_PIN_NO_CHANGE;
+    pins.data_out_num = BUZZER_PIN;
+    pins.data_in_num = I2S_PIN_NO_CHANGE;
+    i2s_set_pin(SYNTH_I2S_PORT, &pins);
+
+    memset(voices, 0, sizeof(voices));
+    for (int i = 0; i < SYNTH_VOICES; i++) {
+        reg_gate[i] = 0;
+        voices[i].seen_trigger = reg_trigger[i];
+    }
+    peak_load = 0;
+    keep_running = true;
+    xSemaphoreTake(stopped_sem, 0);
+    xTaskCreatePinnedToCore(Synth_Task, "Synth", 3072, NULL, 4, &synthTaskHandle, 0);
+    return true;
+}
+
+void Synth_Stop() {
+    if (synthTaskHandle == NULL) return;
+    keep_running = false;
+    // The task finishes its current block, about SYNTH_DMA_BUFFERS blocks at most
+    xSemaphoreTake(stopped_sem, pdMS_TO_TICKS(100));
+    Serial.printf("Synth: stopped, peak load %u.%u%%\n", peak_load / 10, peak_load % 10);
+}
+
+bool Synth_IsRunning() {
+    return synthTaskHandle != NULL;
+}
+
+void Synth_NoteOn(uint8_t voice, uint16_t frequency) {
+    if (voice >= SYNTH_VOICES) return;
+    reg_increment[voice] = (uint32_t)(((uint64_t)frequency << 32) / SYNTH_SAMPLE_RATE);
+    reg_gate[voice] = 1;
+    reg_trigger[voice] = reg_trigger[voice] + 1;
+}
+
+void Synth_NoteOff(uint8_t voice) {
+    if (voice < SYNTH_VOICES) reg_gate[voice] = 0;
+}
+
+void Synth_AllOff() {
+    for (int i = 0; i < SYNTH_VOICES; i++) reg_gate[i] = 0;
+}
+
+void Synth_SetWave(SynthWave wave) {
+    reg_wave = wave;
+}
+
+uint16_t Synth_CpuLoad() {
+    return peak_load;
+}
@@ -0,0 +1,38 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <Arduino.h>
+
+// Small polyphonic synth for the buzzer.
+// Voices are 32-bit phase accumulators with square, triangle or sine
+// (wavetable) oscillators and a linear ADSR envelope, mixed in fixed point
+// (no FPU on the C3). Blocks are rendered on a high-priority task and leave
+// through the I2S peripheral in PDM mode: a hardware sigma-delta bitstream
+// on BUZZER_PIN, fed by DMA, so no per-sample interrupt is needed.
+#define SYNTH_SAMPLE_RATE    16000
+#define SYNTH_VOICES         4
+#define SYNTH_BLOCK          64      // Samples per render, 4 ms
+#define SYNTH_DMA_BUFFERS    3       // Output latency is about this many blocks
+
+enum SynthWave {
+    SYNTH_WAVE_SQUARE,
+    SYNTH_WAVE_TRIANGLE,
+    SYNTH_WAVE_SINE
+};
+
+// Claims BUZZER_PIN and starts rendering. Safe to call while running.
+bool Synth_Start();
+// Stops rendering and hands BUZZER_PIN back to tone() and the sequencer.
+void Synth_Stop();
+bool Synth_IsRunning();
+
+// Voice control. Plain register writes, safe from any task or timer callback.
+void Synth_NoteOn(uint8_t voice, uint16_t frequency);
+void Synth_NoteOff(uint8_t voice);
+void Synth_AllOff();
+void Synth_SetWave(SynthWave wave);
+
+// Render time as a share of the block period, in 0.1 % (peak since start).
+uint16_t Synth_CpuLoad();
+
+#endif // SYNTH_H
@@ -22,9 +22,17 @@
 #include <OneWire.h>
 #include <DallasTemperature.h>
 #include "TargetSettings.h"
+#include "WebDashboard.h"
+#include "Settings.h"
+#include "TimeSeries.h"
+#include "MusicBank.h"
+#include "BleService.h"
+#include "SensorHub.h"
+#include "LedEngine.h"
+#include "AHT20.h"
+#include "MQTT.h"
 #define SCREEN_WIDTH 240
 #define SCREEN_HEIGHT 240
-extern DallasTemperature sensors;
 extern OneWire oneWire;
 extern Adafruit_NeoPixel strip;
 
@@ -35,10 +43,7 @@ TFT_eSprite menuSprite = TFT_eSprite(&tft);
 int tft_log_y = 40;
 int current_log_lines = 0;
 void setLEDColor(uint8_t r, uint8_t g, uint8_t b) {
-  for(int i=0; i<NUM_LEDS; i++) {
-    strip.setPixelColor(i, strip.Color(r, g, b));
-  }
-  strip.show();
+  LedEngine_Solid(Adafruit_NeoPixel::Color(r, g, b));
 }
 // 打字机效果函数
 void typeWriterEffect(const char* text, int x, int y, uint32_t color = TFT_WHITE, int delayMs = 30, bool playSound = false) {
@@ -112,10 +117,10 @@ void displaySystemInfoTypewriter() {
     tftLogInfo(sdkInfo);
 }
 
-// 显示EEPROM中存储的目标设置
+// 显示设置存储中的目标设置
 void displayEepromInfo() {
     tftClearLog();
-    tftLogInfo("TARGET SETTINGS (from EEPROM)");
+    tftLogInfo("TARGET SETTINGS");
     tft.drawFastHLine(0, 55, SCREEN_WIDTH, TFT_DARKCYAN);
 
     char buffer[64];
@@ -173,15 +178,15 @@ void hardwareTest() {
 
     // 温度传感器测试
     tftLogInfo("Testing DS18B20...");
-    sensors.begin();
-    int deviceCount = sensors.getDeviceCount();
+    // The update task owns the bus by now; use the addresses cached at init
+    int deviceCount = DS18B20_SensorCount();
     if (deviceCount == 0) {
         tftLogError("No DS18B20 sensors detected");
         return;
     }
 
     DeviceAddress deviceAddress;
-    if (sensors.getAddress(deviceAddress, 0)) {
+    if (DS18B20_GetAddress(0, deviceAddress)) {
         char addrStr[50];
         sprintf(addrStr, "Address: %02X:%02X:%02X:%02X:%02X:%02X:%02X:%02X",
                 deviceAddress[0], deviceAddress[1], deviceAddress[2], deviceAddress[3],
@@ -200,7 +205,7 @@ void hardwareTest() {
 
     // ADC测试
     tftLogInfo("Testing ADC...");
-    uint32_t adcRaw = adc1_get_raw(ADC1_CHANNEL_2);
+    uint32_t adcRaw = ADC_Latest().raw_q4 >> 4; // Sampler started in setupADC()
     char adcStr[25];
     sprintf(adcStr, "ADC: %lu OK", adcRaw);
     tftLogSuccess(adcStr);
@@ -208,7 +213,8 @@ void hardwareTest() {
 
 // 开机动画函数
 void bootAnimation() {
-    static int boot_song_index = numSongs-1; // "Windows XP"
+    static int boot_song_index;
+    boot_song_index = MusicBank_Count() - 1; // "Windows XP"
     xTaskCreatePinnedToCore(Buzzer_PlayMusic_Task, "BootSound", 8192, &boot_song_index, 1, NULL, 0);
     // tft.fillScreen(TFT_BLACK);
     const uint16_t* boot_gif[16] = {huaji_0,huaji_1,huaji_2,huaji_3,huaji_4,huaji_5,huaji_6,huaji_7,huaji_8,huaji_9,huaji_10,huaji_11,huaji_12,huaji_13,huaji_14,huaji_15};
@@ -241,7 +247,7 @@ void bootAnimation() {
     displaySystemInfoTypewriter();
     delay(1000);
 
-    // 显示EEPROM信息
+    // 显示设置信息
     displayEepromInfo();
     delay(1000);
     
@@ -271,10 +277,14 @@ void bootAnimation() {
 // 系统初始化函数
 void bootSystem() {
     Serial.begin(115200);
-    EEPROM.begin(EEPROM_SIZE);
+    EEPROM.begin(EEPROM_SIZE); // Old settings layout, read once for migration
+    Settings_Init();
+    MusicBank_Init();
     // 初始化硬件
     Buzzer_Init();
     initRotaryEncoder();
+    LedEngine_Init();
+    SensorHub_Init(); // Before any sensor driver registers
     DS18B20_Init();
     createDS18B20Task();
     tft.init();
@@ -284,6 +294,7 @@ void bootSystem() {
     menuSprite.createSprite(239, 239);
     TargetSettings_Init();
     setupADC();
+    AHT20_Init();
 
     // 运行开机动画
     bootAnimation();
@@ -297,6 +308,10 @@ void bootSystem() {
     synced = false;
     syncTime();
     xTaskCreate(TimeUpdate_Task, "Time Update Task", 2048, NULL, 5, NULL); // Add this line
+    TimeSeries_Init(); // Long-term sensor history on LittleFS
+    WebDashboard_Init(); // HTTP dashboard on its own low-priority task
+    BleService_Init(); // BLE GATT telemetry and command service
+    setupMQTT(); // Broker connection, telemetry and spool drain on their own task
     showMenuConfig();
 }
 
@@ -3,7 +3,8 @@
 #include "Buzzer.h"
 #include "weather.h" // For timeinfo
 #include "Menu.h"    // For menuSprite
-#include <EEPROM.h>
+#include "Settings.h"
+#include <EEPROM.h> // Legacy layout, only read for migration
 
 // --- UI Colors ---
 #define TARGET_HIGHLIGHT_COLOR      TFT_YELLOW
@@ -24,8 +25,16 @@ static bool data_loaded = false;
 // --- UI State ---
 enum class EditMode { YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, SAVE, CANCEL };
 
-// --- EEPROM Data Structure ---
+// --- Stored Data Structure ---
+#define TARGET_SETTINGS_VERSION 1
+
 struct TargetData {
+    time_t countdownTarget;
+    ProgressBarInfo progressBar;
+};
+
+// Layout written by older firmware at EEPROM_TARGET_START_ADDR
+struct LegacyTargetData {
     uint8_t magic_key;
     time_t countdownTarget;
     ProgressBarInfo progressBar;
@@ -214,11 +223,16 @@ void drawTargetElements(TFT_eSprite* sprite) {
 
 static void loadData() {
     TargetData data;
-    EEPROM.get(EEPROM_TARGET_START_ADDR, data);
+    LegacyTargetData legacy;
 
-    if (data.magic_key == EEPROM_TARGET_MAGIC_KEY) {
+    if (Settings_Load(SETTINGS_KEY_TARGETS, TARGET_SETTINGS_VERSION, &data, sizeof(data))) {
         countdownTarget = data.countdownTarget;
         progressBar = data.progressBar;
+    } else if (EEPROM.get(EEPROM_TARGET_START_ADDR, legacy).magic_key == EEPROM_TARGET_MAGIC_KEY) {
+        // Migrate targets saved by older firmware
+        countdownTarget = legacy.countdownTarget;
+        progressBar = legacy.progressBar;
+        saveData();
     } else {
         struct tm default_tm = {0};
         default_tm.tm_year = 125; default_tm.tm_mon = 0; default_tm.tm_mday = 1;
@@ -232,9 +246,8 @@ static void loadData() {
 }
 
 static void saveData() {
-    TargetData data = {EEPROM_TARGET_MAGIC_KEY, countdownTarget, progressBar};
-    EEPROM.put(EEPROM_TARGET_START_ADDR, data);
-    EEPROM.commit();
+    TargetData data = {countdownTarget, progressBar};
+    Settings_Save(SETTINGS_KEY_TARGETS, TARGET_SETTINGS_VERSION, &data, sizeof(data));
 }
 
 // =====================================================================================
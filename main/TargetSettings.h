@@ -4,7 +4,7 @@
 #include <time.h>
 #include <TFT_eSPI.h>
 
-// EEPROM start address for this module's data.
+// Legacy EEPROM location, only read once to migrate into the settings store.
 // Alarm data is at address 0 and takes about 51 bytes. We'll start at 100 for safety.
 #define EEPROM_TARGET_START_ADDR 100
 #define EEPROM_TARGET_MAGIC_KEY 0xDA // Different magic key to avoid conflicts
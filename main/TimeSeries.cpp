@@ -0,0 +1,302 @@
+#include "TimeSeries.h"
+#include <LittleFS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "SensorHub.h"
+
+#define TS_VALID_TIME  1600000000UL   // Don't record before NTP has set the clock
+
+// --- Tier Configuration ---
+struct TsTierConfig {
+    uint32_t period_s;
+    uint8_t  max_segments;
+};
+
+static const TsTierConfig tierConfig[TS_TIER_COUNT] = {
+    {TS_RAW_PERIOD_S, 4},   // 1024 records / 2 series * 10 s  = ~1.4 h
+    {60,              4},   // 1024 / 2 * 1 min                = ~8.5 h
+    {15 * 60,         2},   // 512 / 2 * 15 min                = ~2.7 days
+    {60 * 60,         4},   // 1024 / 2 * 1 h                  = ~21 days
+};
+
+struct TsTierState {
+    uint32_t tail_id;       // Oldest segment
+    uint32_t head_id;       // Segment being appended
+    uint32_t head_count;    // Records in the head segment
+};
+
+// Running min/sum/max of the bucket currently being filled
+struct TsAccumulator {
+    uint32_t bucket;
+    int32_t  sum;
+    int16_t  min;
+    int16_t  max;
+    uint16_t count;
+};
+
+// Hub samples received since the last raw record, averaged into it
+struct TsPending {
+    float sum;
+    uint16_t count;
+};
+
+// --- Module-internal State ---
+static SemaphoreHandle_t ts_mutex = NULL;
+static TsPending pending[TS_SERIES_COUNT];
+static portMUX_TYPE pending_mux = portMUX_INITIALIZER_UNLOCKED;
+static TsTierState tiers[TS_TIER_COUNT];
+static TsAccumulator accumulators[TS_TIER_COUNT][TS_SERIES_COUNT];
+
+// =====================================================================================
+//                                     FILE HELPERS
+// =====================================================================================
+
+static void tierDir(uint8_t tier, char* path, size_t size) {
+    snprintf(path, size, "%s/t%u", TS_DIR, (unsigned)tier);
+}
+
+static void segmentPath(uint8_t tier, uint32_t id, char* path, size_t size) {
+    snprintf(path, size, "%s/t%u/seg_%08u.bin", TS_DIR, (unsigned)tier, (unsigned)id);
+}
+
+static void recoverTier(uint8_t tier) {
+    char path[40];
+    tierDir(tier, path, sizeof(path));
+    if (!LittleFS.exists(path)) LittleFS.mkdir(path);
+
+    bool found = false;
+    uint32_t min_id = 0, max_id = 0;
+    File dir = LittleFS.open(path);
+    File entry = dir.openNextFile();
+    while (entry) {
+        const char* name = entry.name();
+        const char* base = strrchr(name, '/');
+        base = base ? base + 1 : name;
+        unsigned id;
+        if (sscanf(base, "seg_%u.bin", &id) == 1) {
+            if (!found || id < min_id) min_id = id;
+            if (!found || id > max_id) max_id = id;
+            found = true;
+        }
+        entry.close();
+        entry = dir.openNextFile();
+    }
+    dir.close();
+
+    TsTierState& t = tiers[tier];
+    t.tail_id = found ? min_id : 0;
+    t.head_id = found ? max_id : 0;
+    t.head_count = 0;
+    if (!found) return;
+
+    segmentPath(tier, t.head_id, path, sizeof(path));
+    File hf = LittleFS.open(path, "r");
+    if (hf) {
+        size_t size = hf.size();
+        hf.close();
+        t.head_count = size / sizeof(TsRecord);
+        // A torn record at the end: never append after it
+        if (size % sizeof(TsRecord) != 0) {
+            t.head_id++;
+            t.head_count = 0;
+        }
+    }
+}
+
+static void appendRecord(uint8_t tier, const TsRecord& record) {
+    TsTierState& t = tiers[tier];
+    if (t.head_count >= TS_SEGMENT_RECORDS) {
+        t.head_id++;
+        t.head_count = 0;
+    }
+    char path[40];
+    // Oldest-first eviction keeps each tier within its flash budget
+    while (t.head_id - t.tail_id + 1 > tierConfig[tier].max_segments) {
+        segmentPath(tier, t.tail_id, path, sizeof(path));
+        LittleFS.remove(path);
+        t.tail_id++;
+    }
+
+    segmentPath(tier, t.head_id, path, sizeof(path));
+    File f = LittleFS.open(path, "a");
+    if (!f) return;
+    if (f.write((const uint8_t*)&record, sizeof(record)) == sizeof(record)) t.head_count++;
+    f.close();
+}
+
+// =====================================================================================
+//                                     DOWNSAMPLING
+// =====================================================================================
+
+static void flushAccumulator(uint8_t tier, uint8_t series) {
+    TsAccumulator& a = accumulators[tier][series];
+    if (a.count == 0) return;
+    TsRecord r;
+    r.time = a.bucket * tierConfig[tier].period_s;
+    r.min = a.min;
+    r.avg = (int16_t)(a.sum / a.count);
+    r.max = a.max;
+    r.series = series;
+    r.samples = (a.count > 255) ? 255 : a.count;
+    appendRecord(tier, r);
+    a.count = 0;
+}
+
+// Folds one raw sample into every tier, emitting a record whenever a bucket closes.
+static void addSample(uint8_t series, uint32_t now, int16_t value) {
+    for (uint8_t tier = 0; tier < TS_TIER_COUNT; tier++) {
+        TsAccumulator& a = accumulators[tier][series];
+        uint32_t bucket = now / tierConfig[tier].period_s;
+        if (a.count > 0 && bucket != a.bucket) flushAccumulator(tier, series);
+        if (a.count == 0) {
+            a.bucket = bucket;
+            a.sum = 0;
+            a.min = value;
+            a.max = value;
+        }
+        a.sum += value;
+        if (value < a.min) a.min = value;
+        if (value > a.max) a.max = value;
+        a.count++;
+    }
+}
+
+// Runs on the publishing driver's task: only accumulates.
+static void onSensorSample(SensorChannel channel, const SensorSample& sample) {
+    TsSeries series;
+    if (channel == SENSOR_DS18B20_TEMP) {
+        if (sample.value <= -127.0f) return; // Failed read
+        series = TS_SERIES_TEMP;
+    } else if (channel == SENSOR_LUX) {
+        series = TS_SERIES_LUX;
+    } else {
+        return;
+    }
+    taskENTER_CRITICAL(&pending_mux);
+    pending[series].sum += sample.value;
+    pending[series].count++;
+    taskEXIT_CRITICAL(&pending_mux);
+}
+
+// One raw record per period from the samples that arrived in it; a series
+// that got none (sensor gone) records nothing rather than a stale value.
+static void TimeSeries_Task(void *pvParameters) {
+    TickType_t lastWake = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TS_RAW_PERIOD_S * 1000));
+        TsPending taken[TS_SERIES_COUNT];
+        taskENTER_CRITICAL(&pending_mux);
+        memcpy(taken, pending, sizeof(taken));
+        memset(pending, 0, sizeof(pending));
+        taskEXIT_CRITICAL(&pending_mux);
+
+        uint32_t now = time(nullptr);
+        if (now < TS_VALID_TIME) continue;
+
+        xSemaphoreTake(ts_mutex, portMAX_DELAY);
+        if (taken[TS_SERIES_TEMP].count > 0) {
+            float temp = taken[TS_SERIES_TEMP].sum / taken[TS_SERIES_TEMP].count;
+            addSample(TS_SERIES_TEMP, now, (int16_t)lroundf(temp * 10.0f));
+        }
+        if (taken[TS_SERIES_LUX].count > 0) {
+            float lux = taken[TS_SERIES_LUX].sum / taken[TS_SERIES_LUX].count;
+            addSample(TS_SERIES_LUX, now, (lux > 32767.0f) ? 32767 : (int16_t)lux);
+        }
+        xSemaphoreGive(ts_mutex);
+    }
+}
+
+// =====================================================================================
+//                                     PUBLIC API
+// =====================================================================================
+
+bool TimeSeries_Init() {
+    if (ts_mutex != NULL) return true;
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("TimeSeries: LittleFS mount failed");
+        return false;
+    }
+    if (!LittleFS.exists(TS_DIR)) LittleFS.mkdir(TS_DIR);
+    for (uint8_t tier = 0; tier < TS_TIER_COUNT; tier++) recoverTier(tier);
+    memset(accumulators, 0, sizeof(accumulators));
+
+    ts_mutex = xSemaphoreCreateMutex();
+    memset(pending, 0, sizeof(pending));
+    SensorHub_Subscribe(onSensorSample, SENSOR_MASK(SENSOR_DS18B20_TEMP) | SENSOR_MASK(SENSOR_LUX));
+    xTaskCreate(TimeSeries_Task, "TimeSeries", 3072, NULL, 1, NULL);
+    Serial.printf("TimeSeries: raw segments %u..%u\n", (unsigned)tiers[0].tail_id, (unsigned)tiers[0].head_id);
+    return true;
+}
+
+uint32_t TimeSeries_TierPeriod(uint8_t tier) {
+    return (tier < TS_TIER_COUNT) ? tierConfig[tier].period_s : 0;
+}
+
+void TimeSeries_Query(TsIterator* it, TsSeries series, uint8_t tier, uint32_t from, uint32_t to) {
+    memset(it, 0, sizeof(*it));
+    it->series = series;
+    it->tier = tier;
+    it->from = from;
+    it->to = to;
+    it->done = (ts_mutex == NULL || tier >= TS_TIER_COUNT);
+    if (!it->done) {
+        xSemaphoreTake(ts_mutex, portMAX_DELAY);
+        it->segment_id = tiers[tier].tail_id;
+        xSemaphoreGive(ts_mutex);
+    }
+}
+
+// Reads the next batch of records, skipping segments evicted in the meantime.
+static void fillBatch(TsIterator* it) {
+    it->batch_count = 0;
+    it->batch_pos = 0;
+
+    xSemaphoreTake(ts_mutex, portMAX_DELAY);
+    const TsTierState& t = tiers[it->tier];
+    if (it->segment_id < t.tail_id) {
+        it->segment_id = t.tail_id;
+        it->offset = 0;
+    }
+    while (it->batch_count == 0 && it->segment_id <= t.head_id) {
+        char path[40];
+        segmentPath(it->tier, it->segment_id, path, sizeof(path));
+        File f = LittleFS.open(path, "r");
+        size_t available = f ? f.size() / sizeof(TsRecord) : 0;
+        if (it->offset < available && f.seek(it->offset * sizeof(TsRecord))) {
+            size_t n = available - it->offset;
+            if (n > 16) n = 16;
+            size_t got = f.read((uint8_t*)it->batch, n * sizeof(TsRecord)) / sizeof(TsRecord);
+            it->batch_count = got;
+            it->offset += got;
+        }
+        if (f) f.close();
+        if (it->batch_count == 0) {
+            if (it->segment_id == t.head_id) break;
+            it->segment_id++;
+            it->offset = 0;
+        }
+    }
+    xSemaphoreGive(ts_mutex);
+
+    if (it->batch_count == 0) it->done = true;
+}
+
+bool TimeSeries_Next(TsIterator* it, TsRecord* record) {
+    while (!it->done) {
+        if (it->batch_pos >= it->batch_count) {
+            fillBatch(it);
+            continue;
+        }
+        const TsRecord& r = it->batch[it->batch_pos++];
+        if (r.series != it->series || r.time < it->from) continue;
+        if (r.time > it->to) {
+            it->done = true;
+            break;
+        }
+        *record = r;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,63 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <Arduino.h>
+#include <time.h>
+
+// Append-only sensor history on LittleFS (/ts/t<tier>/seg_<id>.bin).
+// Raw samples are folded into downsampled tiers as they arrive, each tier
+// keeping min/avg/max per bucket. Every tier is a ring of fixed-size segment
+// files, so flash use is bounded and the oldest segment is dropped first.
+//   Tier 0  raw     every TS_RAW_PERIOD_S   ~1.4 h
+//   Tier 1  1 min                           ~8.5 h
+//   Tier 2  15 min                          ~2.7 days
+//   Tier 3  hourly                          ~21 days
+#define TS_DIR               "/ts"
+#define TS_RAW_PERIOD_S      10
+#define TS_TIER_COUNT        4
+#define TS_SEGMENT_RECORDS   256    // 3 KB per segment file
+
+enum TsSeries : uint8_t {
+    TS_SERIES_TEMP = 0,     // DS18B20, 0.1 C
+    TS_SERIES_LUX,          // Light sensor, lux (clamped to int16)
+    TS_SERIES_COUNT
+};
+
+// One fixed-size record. For tier 0, min == avg == max.
+struct TsRecord {
+    uint32_t time;          // Bucket start, unix seconds
+    int16_t  min;
+    int16_t  avg;
+    int16_t  max;
+    uint8_t  series;
+    uint8_t  samples;       // Raw samples folded into this record (saturates at 255)
+};
+
+// Range query cursor. Records are read in small batches so no file stays
+// open between calls and the writer is never blocked for long.
+struct TsIterator {
+    uint8_t  series;
+    uint8_t  tier;
+    uint32_t from;
+    uint32_t to;
+    uint32_t segment_id;
+    uint32_t offset;        // Record index inside segment_id
+    TsRecord batch[16];
+    uint8_t  batch_count;
+    uint8_t  batch_pos;
+    bool     done;
+};
+
+// Mounts LittleFS, recovers the segment rings and starts the sampling task.
+bool TimeSeries_Init();
+
+// Seconds covered by one record of `tier`.
+uint32_t TimeSeries_TierPeriod(uint8_t tier);
+
+// Starts a query for records of `series` in [from, to], oldest first.
+void TimeSeries_Query(TsIterator* it, TsSeries series, uint8_t tier, uint32_t from, uint32_t to);
+
+// Fetches the next matching record. Returns false at the end of the range.
+bool TimeSeries_Next(TsIterator* it, TsRecord* record);
+
+#endif // TIME_SERIES_H
@@ -1,16 +1,20 @@
 #include <TFT_eSPI.h>
 #include <cmath>
 #include "Buzzer.h"
+#include "NoteSequencer.h"
 #include "Alarm.h"
-#include <vector>
 #include "Watchface.h"
 #include "MQTT.h"
 #include "RotaryEncoder.h"
 #include "weather.h" 
 #include "img.h"
 #include <time.h> // For struct tm
-#include "DS18B20.h"
+#include "SensorHub.h"
 #include "TargetSettings.h"
+#include "FixedMath.h"
+#include "Particles.h"
+#include "MeshData.h"
+#include "SandGrid.h"
 
 #define MENU_FONT 1
 #define WEATHER_INTERVAL_MIN 30
@@ -52,6 +56,7 @@ static void SandBoxWatchface();
 static void ProgressBarWatchface(); // New watchface
 static void ChargeWatchface();
 static void Cube3DWatchface();
+static void Solids3DWatchface();
 static void GalaxyWatchface();
 static void SimClockWatchface();
 static void PlaceholderWatchface();
@@ -82,6 +87,7 @@ const WatchfaceItem watchfaceItems[] = {
     {"Bouncing Balls", BallsWatchface},
     {"Sand Box", SandBoxWatchface},
     {"3D Cube", Cube3DWatchface},
+    {"3D Solids", Solids3DWatchface},
 };
 const int WATCHFACE_COUNT = sizeof(watchfaceItems) / sizeof(watchfaceItems[0]);
 
@@ -223,6 +229,7 @@ static void handleHourlyChime() {
 
             // If a song is already playing, stop it before starting a new one
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop(); // Before deleting the task that waits on it
                 vTaskDelete(g_hourlyMusicTaskHandle);
             }
 
@@ -337,8 +344,10 @@ static void drawCommonElements() {
     menuSprite.setTextDatum(BC_DATUM);
     menuSprite.setTextFont(1);
     menuSprite.setTextSize(1);
-    float temp = getDS18B20Temp();
+    float temp = SensorHub_Value(SENSOR_DS18B20_TEMP, -127.0f);
     String tempStr = "DS18B20: " + String(temp, 1) + " C";
+    float humidity = SensorHub_Value(SENSOR_AHT20_HUMIDITY, -1.0f);
+    if (humidity >= 0) tempStr += "  " + String(humidity, 0) + "%";
     menuSprite.setTextColor(DS18B20_TEMP_COLOR, TFT_BLACK);
     menuSprite.drawString(tempStr, 120, tft.height() - 35);
 
@@ -455,36 +464,19 @@ static void ChargeWatchface() {
 
 
 // --- 3D Cube ---
-#define CUBE_SIZE 25
-
-static const int16_t cube_vertices_start[] = {
-    -CUBE_SIZE, -CUBE_SIZE, -CUBE_SIZE,
-    CUBE_SIZE, -CUBE_SIZE, -CUBE_SIZE,
-    CUBE_SIZE, CUBE_SIZE, -CUBE_SIZE,
-    -CUBE_SIZE, CUBE_SIZE, -CUBE_SIZE,
-    -CUBE_SIZE, -CUBE_SIZE, CUBE_SIZE,
-    CUBE_SIZE, -CUBE_SIZE, CUBE_SIZE,
-    CUBE_SIZE, CUBE_SIZE, CUBE_SIZE,
-    -CUBE_SIZE, CUBE_SIZE, CUBE_SIZE
-};
-
-static const uint8_t cube_indices[] = {
-    0, 1, 1, 2, 2, 3, 3, 0,
-    4, 5, 5, 6, 6, 7, 7, 4,
-    0, 4, 1, 5, 2, 6, 3, 7
-};
-
 static void Cube3DWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval_Weather - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    static float rot = 0;
-    static float rotInc = 1;
-    int16_t cube_vertices[8 * 3];
+    // Each axis turns at its own rate; fix_angle_t wraps at a full turn
+    static fix_angle_t rot = 0, rot2 = 0, rot3 = 0;
+    static int rotInc = 1; // Tenths of a degree per frame
+    const Camera3D camera = { (int16_t)(tft.width() / 2), (int16_t)(tft.height() / 2), 128, 80 };
 
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -506,6 +498,7 @@ static void Cube3DWatchface() {
 
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -519,92 +512,129 @@ static void Cube3DWatchface() {
         getLocalTime(&timeinfo);
         menuSprite.fillSprite(TFT_BLACK);
         
-        memcpy(cube_vertices, cube_vertices_start, sizeof(cube_vertices_start));
+        fix_angle_t step = rotInc * 65536 / 3600;
+        rot += step;
+        rot2 += step * 3 / 2; // Adjusted rotation speed for different axes
+        rot3 += step * 2;
+
+        Mat4 model = Mat4_Multiply(Mat4_RotateX(rot3), Mat4_Multiply(Mat4_RotateY(rot2), Mat4_RotateZ(rot)));
+        Mesh3D_Transform(MESH_CUBE, model, camera);
+        Mesh3D_DrawEdges(menuSprite, TIME_TENTH_COLOR);
 
-        rot += rotInc / 10.0;
-        if(rot >= 360) rot = 0;
-        else if(rot < 0) rot = 359;
+        char timeStr[20];
+        int tenth = (millis() % 1000) / 100;
+        sprintf(timeStr, "%02d:%02d:%02d.%d", timeinfo.tm_hour, timeinfo.tm_min,timeinfo.tm_sec,tenth);
+        menuSprite.setTextFont(1);
+        menuSprite.setTextDatum(TC_DATUM);
+        menuSprite.setTextSize(4);
+        menuSprite.setTextColor(TIME_MAIN_COLOR, TFT_BLACK);
+        menuSprite.drawString(timeStr, tft.width()/2, 15);
 
-        float rot_rad = rot * M_PI / 180.0;
-        float rot_rad2 = (rot * 1.5) * M_PI / 180.0; // Adjusted rotation speed for different axes
-        float rot_rad3 = (rot * 2.0) * M_PI / 180.0;
 
-        float sin_rot = sin(rot_rad);
-        float cos_rot = cos(rot_rad);
-        float sin_rot2 = sin(rot_rad2);
-        float cos_rot2 = cos(rot_rad2);
-        float sin_rot3 = sin(rot_rad3);
-        float cos_rot3 = cos(rot_rad3);
+        menuSprite.pushSprite(0, 0);
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+}
 
-        for(int i=0; i<8; ++i) {
-            int16_t* vertex = &cube_vertices[i * 3];
-            int16_t x = vertex[0], y = vertex[1], z = vertex[2];
+// --- 3D Solids ---
+#define SOLIDS_FRAME_MS 33  // Held with vTaskDelayUntil, so the spin speed is steady
+#define SOLIDS_AMBIENT  48
 
-            int16_t x_new = x * cos_rot - y * sin_rot;
-            int16_t y_new = y * cos_rot + x * sin_rot;
-            x = x_new; y = y_new;
+struct SolidItem {
+    const Mesh3D* mesh;
+    uint16_t color;
+    fix16_t scale;
+};
 
-            x_new = x * cos_rot2 - z * sin_rot2;
-            z = z * cos_rot2 + x * sin_rot2;
-            x = x_new;
+static const SolidItem solidItems[] = {
+    { &MESH_GLOBE,       TFT_SKYBLUE, FIX_ONE },
+    { &MESH_ICOSAHEDRON, TFT_MAGENTA, FIX_ONE },
+    { &MESH_CUBE,        TFT_ORANGE,  FIX_FROM_INT(2) },
+};
+static const int SOLID_COUNT = sizeof(solidItems) / sizeof(solidItems[0]);
 
-            y_new = y * cos_rot3 - z * sin_rot3;
-            z = z * cos_rot3 + y * sin_rot3;
-            y = y_new;
+// Flat-shaded spinning meshes; the encoder picks the mesh.
+static void Solids3DWatchface() {
+    static int solidIndex = 0;
+    fix_angle_t spin = 0;
+    fix_angle_t wobble = 0;
+    const Camera3D camera = { (int16_t)(tft.width() / 2), (int16_t)(tft.height() / 2 + 20), 256, 200 };
+    TickType_t lastWake = xTaskGetTickCount();
 
-            int16_t z_new = z + 80;
-            x = (x * 128) / z_new;
-            y = (y * 128) / z_new;
+    while(1) {
+        if (exitSubMenu) {
+            exitSubMenu = false; // Reset flag
+            if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
+                vTaskDelete(g_hourlyMusicTaskHandle);
+                g_hourlyMusicTaskHandle = NULL;
+                noTone(BUZZER_PIN);
+                stopBuzzerTask = true;
+            }
+            return; // Exit watchface
+        }
+        if (g_alarm_is_ringing) { return; }
+        handlePeriodicSync();
+        handleHourlyChime();
 
-            x += tft.width() / 2;
-            y += tft.height() / 2;
+        int encoderChange = readEncoder();
+        if (encoderChange != 0) {
+            solidIndex = (solidIndex + (encoderChange > 0 ? 1 : SOLID_COUNT - 1)) % SOLID_COUNT;
+            tone(BUZZER_PIN, 1000, 50);
+        }
 
-            vertex[0] = x;
-            vertex[1] = y;
+        if (readButton()) {
+            if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
+                vTaskDelete(g_hourlyMusicTaskHandle);
+                g_hourlyMusicTaskHandle = NULL;
+                noTone(BUZZER_PIN);
+                stopBuzzerTask = true;
+            }
+            tone(BUZZER_PIN, 1500, 50);
+            menuSprite.setTextFont(MENU_FONT);
+            return;
         }
 
-        for(int i=0; i<12; ++i) {
-            const uint8_t* indices = &cube_indices[i * 2];
-            int16_t* p1 = &cube_vertices[indices[0] * 3];
-            int16_t* p2 = &cube_vertices[indices[1] * 3];
-            menuSprite.drawLine(p1[0], p1[1], p2[0], p2[1], TIME_TENTH_COLOR);
+        getLocalTime(&timeinfo);
+        menuSprite.fillSprite(TFT_BLACK);
+
+        // Spin about a tilted axis that slowly nods
+        spin += FIX_DEG(2);
+        wobble += FIX_DEG(1);
+        const SolidItem& item = solidItems[solidIndex];
+        fix_angle_t tilt = FIX_DEG(20) + Fix_ToInt(Fix_Sin(wobble) * FIX_DEG(10));
+        Mat4 model = Mat4_Multiply(Mat4_RotateX(tilt),
+                     Mat4_Multiply(Mat4_RotateZ(FIX_DEG(23)),
+                     Mat4_Multiply(Mat4_RotateY(spin), Mat4_Scale(item.scale))));
+        if (Mesh3D_Transform(*item.mesh, model, camera)) {
+            Mesh3D_DrawFaces(menuSprite, item.color, SOLIDS_AMBIENT);
         }
 
-        char timeStr[20];
-        int tenth = (millis() % 1000) / 100;
-        sprintf(timeStr, "%02d:%02d:%02d.%d", timeinfo.tm_hour, timeinfo.tm_min,timeinfo.tm_sec,tenth);
+        char timeStr[10];
+        sprintf(timeStr, "%02d:%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
         menuSprite.setTextFont(1);
         menuSprite.setTextDatum(TC_DATUM);
         menuSprite.setTextSize(4);
         menuSprite.setTextColor(TIME_MAIN_COLOR, TFT_BLACK);
         menuSprite.drawString(timeStr, tft.width()/2, 15);
 
-
         menuSprite.pushSprite(0, 0);
-        vTaskDelay(pdMS_TO_TICKS(20));
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SOLIDS_FRAME_MS));
     }
 }
 
 // --- Galaxy ---
-struct GalaxyStar {
-    int x;
-    int y;
-    int time;
-};
-
-static GalaxyStar galaxy_stars[50];
-
-static float galaxy_radians(float angle) {
-    return angle * M_PI / 180.0;
-}
+#define GALAXY_STARS 150    // Twinkling background stars
+#define GALAXY_STAR_LIFE 30 // Frames
 
 static void galaxy_draw_spiral_stars(uint16_t num_stars, uint16_t arm_length, uint16_t spread, uint16_t rotation_offset) {
     for (int i = 0; i < num_stars; i++) {
         int angle = i * spread + rotation_offset;
         int length = arm_length * i / num_stars;
         
-        int x = length * cos(galaxy_radians(angle)) * 3 / 5;
-        int y = length * sin(galaxy_radians(angle)) * 3 / 5;
+        int x = Fix_ToInt(length * Fix_Cos(FIX_DEG(angle)) * 3 / 5);
+        int y = Fix_ToInt(length * Fix_Sin(FIX_DEG(angle)) * 3 / 5);
         
         menuSprite.drawPixel(x + tft.width() / 2, y + tft.height() / 2, TFT_WHITE);
     }
@@ -620,40 +650,24 @@ static void galaxy_draw_main() {
     }
 }
 
-static void galaxy_random_drawStars() {
-    static uint32_t time_counter = 0;
-    if (time_counter % 2 == 0) {
-        int i = 0;
-        while (galaxy_stars[i].time && i < 50) {
-            i++;
-        }
-        if (i < 50) {
-            galaxy_stars[i].time = 30;
-            galaxy_stars[i].x = util_random(tft.width());
-            galaxy_stars[i].y = util_random(tft.height());
-        }
-    }
-
-    for (int i = 0; i < 50; i++) {
-        if (galaxy_stars[i].time > 0) {
-            galaxy_stars[i].time--;
-            menuSprite.drawPixel(galaxy_stars[i].x, galaxy_stars[i].y, TFT_WHITE);
-        }
-    }
-    time_counter++;
-}
-
 static void GalaxyWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval_Weather - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    for(int i=0; i<50; ++i) {
-        galaxy_stars[i].time = 0;
-    }
+    // Still stars that appear anywhere and fade out after GALAXY_STAR_LIFE frames
+    Particles_Reset(menuSprite.width(), menuSprite.height());
+    ParticleEmitter stars = {};
+    stars.w = menuSprite.width(); stars.h = menuSprite.height();
+    stars.life_min = GALAXY_STAR_LIFE; stars.life_max = GALAXY_STAR_LIFE;
+    stars.rate = GALAXY_STARS * PARTICLE_ONE / GALAXY_STAR_LIFE;
+    stars.max_alive = GALAXY_STARS;
+    stars.color = TFT_WHITE;
+    Particles_AddEmitter(stars);
 
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -667,6 +681,7 @@ static void GalaxyWatchface() {
 
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -681,7 +696,8 @@ static void GalaxyWatchface() {
         menuSprite.fillSprite(TFT_BLACK);
         
         galaxy_draw_main();
-        galaxy_random_drawStars();
+        Particles_Update();
+        Particles_Render(menuSprite);
 
         char timeStr[20];
         int tenth = (millis() % 1000) / 100;
@@ -706,6 +722,7 @@ static void SimClockWatchface() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -719,6 +736,7 @@ static void SimClockWatchface() {
 
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -812,6 +830,7 @@ static void PlaceholderWatchface() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -824,6 +843,7 @@ static void PlaceholderWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -943,6 +963,7 @@ static void VectorScrollWatchface() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -955,6 +976,7 @@ static void VectorScrollWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1059,6 +1081,7 @@ static void VectorScanWatchface() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1071,6 +1094,7 @@ static void VectorScanWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1137,6 +1161,7 @@ static void SimpleClockWatchface() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1150,6 +1175,7 @@ static void SimpleClockWatchface() {
 
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1188,24 +1214,26 @@ static void SimpleClockWatchface() {
 }
 
 // --- Terminal Sim & Code Rain ---
-#define RAIN_COLS 30
-char rain_chars[RAIN_COLS];
-int rain_pos[RAIN_COLS];
-int rain_speed[RAIN_COLS];
+#define RAIN_COL_WIDTH 8
+#define RAIN_DROPS 120      // Several drops per column; each gets a new glyph when it respawns
 
 static void shared_rain_logic(uint16_t color) {
     // lastSyncMillis_Weather = millis() - syncInterval - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    util_randomSeed(millis());
-    for(int i=0; i<RAIN_COLS; i++) {
-        rain_pos[i] = util_random_range(0, tft.height());
-        rain_speed[i] = util_random_range(1, 5);
-        rain_chars[i] = (char)util_random_range(33, 126);
-    }
+    Particles_Reset(menuSprite.width(), menuSprite.height());
+    ParticleEmitter drops = {};
+    drops.y = -2; drops.w = menuSprite.width(); drops.h = 2;
+    drops.grid_x = RAIN_COL_WIDTH;
+    drops.vy_min = 1 * PARTICLE_ONE; drops.vy_max = 4 * PARTICLE_ONE;
+    drops.rate = 3 * PARTICLE_ONE;
+    drops.max_alive = RAIN_DROPS;
+    drops.tag_min = 33; drops.tag_max = 126; // Printable ASCII
+    Particles_Prefill(Particles_AddEmitter(drops));
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1218,6 +1246,7 @@ static void shared_rain_logic(uint16_t color) {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1231,13 +1260,11 @@ static void shared_rain_logic(uint16_t color) {
         getLocalTime(&timeinfo);
         menuSprite.fillSprite(TFT_BLACK);
         
-        for(int i=0; i<RAIN_COLS; i++) {
-            rain_pos[i] += rain_speed[i];
-            if(rain_pos[i] > tft.height()) {
-                rain_pos[i] = 0;
-                rain_chars[i] = (char)util_random_range(33, 126);
-            }
-            draw_char(i * 8, rain_pos[i], rain_chars[i], color, TFT_BLACK, 1);
+        Particles_Update();
+        // Glyphs go through the font renderer, so this face draws them itself
+        ParticleView rain = Particles_View();
+        for(uint16_t i=0; i<rain.count; i++) {
+            draw_char(rain.x[i] / PARTICLE_ONE, rain.y[i] / PARTICLE_ONE, (char)rain.tag[i], color, TFT_BLACK, 1);
         }
         
         drawAdvancedCommonElements();
@@ -1268,17 +1295,28 @@ static void TerminalSimWatchface() { shared_rain_logic(TFT_GREEN); }
 static void CodeRainWatchface() { shared_rain_logic(TFT_CYAN); }
 
 // --- Snow ---
-#define SNOW_PARTICLES 100
-std::vector<std::pair<int, int>> snow_particles(SNOW_PARTICLES);
+#define SNOW_PARTICLES 600
 static void SnowWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    util_randomSeed(millis());
-    for(auto& p : snow_particles) { p.first = util_random_range(0, tft.width()); p.second = util_random_range(0, tft.height()); }
+    // Flakes fall in from the top; gravity against drag settles them near one
+    // pixel per frame while the jitter makes them drift.
+    Particles_Reset(menuSprite.width(), menuSprite.height());
+    ParticleEmitter flakes = {};
+    flakes.y = -2; flakes.w = menuSprite.width(); flakes.h = 2;
+    flakes.vy_min = PARTICLE_ONE / 2; flakes.vy_max = PARTICLE_ONE * 3 / 2;
+    flakes.rate = 4 * PARTICLE_ONE;
+    flakes.max_alive = SNOW_PARTICLES;
+    flakes.color = TFT_WHITE;
+    Particles_Prefill(Particles_AddEmitter(flakes));
+    Particles_AddForce({ PARTICLE_FORCE_GRAVITY, 0, PARTICLE_ONE / 16, 0 });
+    Particles_AddForce({ PARTICLE_FORCE_DRAG, PARTICLE_ONE / 16, 0, 0 });
+    Particles_AddForce({ PARTICLE_FORCE_JITTER, 24, 8, 0 });
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1291,6 +1329,7 @@ static void SnowWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1304,11 +1343,8 @@ static void SnowWatchface() {
         getLocalTime(&timeinfo);
         menuSprite.fillSprite(TFT_BLACK);
 
-        for(auto& p : snow_particles) {
-            p.second += 1;
-            if(p.second > tft.height()) { p.second = 0; p.first = util_random_range(0, tft.width()); }
-            menuSprite.drawPixel(p.first, p.second, TFT_WHITE);
-        }
+        Particles_Update();
+        Particles_Render(menuSprite);
         
         drawAdvancedCommonElements();
 
@@ -1339,11 +1375,12 @@ static void SnowWatchface() {
 static void WavesWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    float time = 0;
+    fix_angle_t phase = 0;
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1356,6 +1393,7 @@ static void WavesWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1370,11 +1408,11 @@ static void WavesWatchface() {
         menuSprite.fillSprite(TFT_BLACK);
 
         for(int x=0; x<tft.width(); x++) {
-            menuSprite.drawPixel(x, sin((float)x/20+time)*20+60, TFT_CYAN);
-            menuSprite.drawPixel(x, cos((float)x/15+time)*20+120, TFT_MAGENTA);
-            menuSprite.drawPixel(x, sin((float)x/10+time*2)*20+180, TFT_YELLOW);
+            menuSprite.drawPixel(x, Fix_ToInt(Fix_Sin(x * FIX_ANGLE_PER_RAD / 20 + phase) * 20) + 60, TFT_CYAN);
+            menuSprite.drawPixel(x, Fix_ToInt(Fix_Cos(x * FIX_ANGLE_PER_RAD / 15 + phase) * 20) + 120, TFT_MAGENTA);
+            menuSprite.drawPixel(x, Fix_ToInt(Fix_Sin(x * FIX_ANGLE_PER_RAD / 10 + phase * 2) * 20) + 180, TFT_YELLOW);
         }
-        time += 0.1;
+        phase += FIX_RAD(0.1);
         
         drawAdvancedCommonElements();
 
@@ -1405,11 +1443,12 @@ static void WavesWatchface() {
 static void NenoWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    float time = 0;
+    fix_angle_t phase = 0;
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1422,6 +1461,7 @@ static void NenoWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1435,11 +1475,12 @@ static void NenoWatchface() {
         getLocalTime(&timeinfo);
         menuSprite.fillSprite(TFT_BLACK);
 
-        float x1 = tft.width()/2+sin(time)*50, y1 = tft.height()/2+cos(time)*50;
-        float x2 = tft.width()/2+sin(time+PI)*50, y2 = tft.height()/2+cos(time+PI)*50;
+        int dx = Fix_ToInt(Fix_Sin(phase) * 50), dy = Fix_ToInt(Fix_Cos(phase) * 50);
+        int x1 = tft.width()/2+dx, y1 = tft.height()/2+dy;
+        int x2 = tft.width()/2-dx, y2 = tft.height()/2-dy; // Half a turn on
         menuSprite.drawLine(x1, y1, x2, y2, TFT_RED);
         menuSprite.drawLine(tft.width()-x1, y1, tft.width()-x2, y2, TFT_BLUE);
-        time += 0.05;
+        phase += FIX_RAD(0.05);
         
         drawAdvancedCommonElements();
 
@@ -1467,23 +1508,26 @@ static void NenoWatchface() {
 }
 
 // --- Bouncing Balls ---
-#define BALL_COUNT 5
-struct Ball { float x, y, vx, vy; uint16_t color; };
-std::vector<Ball> balls(BALL_COUNT);
+#define BALL_COUNT 40
+#define BALL_RADIUS 5
 
 static void BallsWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
-    util_randomSeed(millis());
-    for(auto& b : balls) {
-        b.x = util_random_range(10, tft.width()-10); b.y = util_random_range(10, tft.height()-10);
-        b.vx = util_random_range(-3, 3); b.vy = util_random_range(-3, 3);
-        b.color = util_random(0xFFFF);
-    }
+    Particles_Reset(menuSprite.width(), menuSprite.height());
+    ParticleEmitter balls = {};
+    balls.vx_min = -3 * PARTICLE_ONE; balls.vx_max = 3 * PARTICLE_ONE;
+    balls.vy_min = -3 * PARTICLE_ONE; balls.vy_max = 3 * PARTICLE_ONE;
+    balls.max_alive = BALL_COUNT;
+    balls.radius = BALL_RADIUS;
+    balls.edge = PARTICLE_EDGE_BOUNCE;
+    balls.flags = PARTICLE_RANDOM_COLOR;
+    Particles_Prefill(Particles_AddEmitter(balls));
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1496,6 +1540,7 @@ static void BallsWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1509,12 +1554,8 @@ static void BallsWatchface() {
         getLocalTime(&timeinfo);
         menuSprite.fillSprite(TFT_BLACK);
 
-        for(auto& b : balls) {
-            b.x += b.vx; b.y += b.vy;
-            if(b.x < 5 || b.x > tft.width()-5) b.vx *= -1;
-            if(b.y < 5 || b.y > tft.height()-5) b.vy *= -1;
-            menuSprite.fillCircle(b.x, b.y, 5, b.color);
-        }
+        Particles_Update();
+        Particles_Render(menuSprite);
         
         drawAdvancedCommonElements();
 
@@ -1542,17 +1583,19 @@ static void BallsWatchface() {
 }
 
 // --- Sand Box ---
-#define SAND_WIDTH 120
-#define SAND_HEIGHT 120
-byte sand_grid[SAND_WIDTH][SAND_HEIGHT] = {0};
+#define SAND_SPAWN_PER_FRAME 2
 
 static void SandBoxWatchface() {
     // lastSyncMillis_Weather = millis() - syncInterval - 1;
     // lastSyncMillis_Time = millis() - syncInterval - 1;
+    static bool draining = false; // Box full: open the floor until it is empty
+    Sand_Resize(menuSprite.width(), menuSprite.height());
+    int last_sec = -1;
     while(1) {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1565,6 +1608,7 @@ static void SandBoxWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1576,24 +1620,23 @@ static void SandBoxWatchface() {
         }
 
         getLocalTime(&timeinfo);
-        
-        if(util_random(100) < 20) sand_grid[util_random(SAND_WIDTH)][0] = 1;
-        menuSprite.fillSprite(TFT_BLACK);
 
-        for(int y=SAND_HEIGHT-2; y>=0; y--) {
-            for(int x=0; x<SAND_WIDTH; x++) {
-                if(sand_grid[x][y] == 1) {
-                    if(sand_grid[x][y+1] == 0) { sand_grid[x][y] = 0; sand_grid[x][y+1] = 1; }
-                    else if (x > 0 && sand_grid[x-1][y+1] == 0) { sand_grid[x][y] = 0; sand_grid[x-1][y+1] = 1; }
-                    else if (x < SAND_WIDTH-1 && sand_grid[x+1][y+1] == 0) { sand_grid[x][y] = 0; sand_grid[x+1][y+1] = 1; }
-                }
-            }
-        }
-        for(int y=0; y<SAND_HEIGHT; y++) {
-            for(int x=0; x<SAND_WIDTH; x++) {
-                if(sand_grid[x][y] == 1) menuSprite.drawPixel(x*2, y*2, TFT_YELLOW);
+        if (draining) {
+            if (Sand_Count() == 0) draining = false;
+        } else {
+            for (int i = 0; i < SAND_SPAWN_PER_FRAME; i++) {
+                if (Sand_Spawn(util_random(Sand_Width()), 0)) continue;
+                if (Sand_Count() > Sand_Width() * Sand_Height() / 2) draining = true;
             }
         }
+        Sand_Update(draining);
+
+        // The sand stays in the sprite and only moved chunks are repainted.
+        // Once a second repaint it all, so text that got shorter leaves no trace.
+        bool full = timeinfo.tm_sec != last_sec;
+        last_sec = timeinfo.tm_sec;
+        if (full) menuSprite.fillSprite(TFT_BLACK);
+        Sand_Render(menuSprite, full);
         
         drawAdvancedCommonElements();
 
@@ -1633,6 +1676,7 @@ static void ProgressBarWatchface() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1645,6 +1689,7 @@ static void ProgressBarWatchface() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1740,6 +1785,7 @@ static void VectorScrollWatchface_SEG() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1752,6 +1798,7 @@ static void VectorScrollWatchface_SEG() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1890,6 +1937,7 @@ static void VectorScanWatchface_SEG() {
         if (exitSubMenu) {
             exitSubMenu = false; // Reset flag
             if (g_hourlyMusicTaskHandle != NULL) { // Also stop music if playing
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
@@ -1902,6 +1950,7 @@ static void VectorScanWatchface_SEG() {
         handleHourlyChime();
         if (readButton()) {
             if (g_hourlyMusicTaskHandle != NULL) {
+                Sequencer_Stop();
                 vTaskDelete(g_hourlyMusicTaskHandle);
                 g_hourlyMusicTaskHandle = NULL;
                 noTone(BUZZER_PIN);
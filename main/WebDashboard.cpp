@@ -0,0 +1,275 @@
+#include "WebDashboard.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WebServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "SensorHub.h"
+#include "MqttSpool.h"
+#include "TimeSeries.h"
+
+// --- Objects ---
+// The captive portal in WiFiManager.cpp never returns, so port 80 is free here.
+static WebServer dashServer(80);
+static TaskHandle_t webTaskHandle = NULL;
+
+// --- History Ring Buffer ---
+struct HistorySample {
+    uint32_t uptime_s;
+    int16_t temp_c10;   // DS18B20 temperature in 0.1 C
+    uint16_t lux;
+    uint32_t free_heap;
+};
+
+static HistorySample history[WEB_HISTORY_SIZE];
+static uint16_t history_head = 0;   // Next slot to write
+static uint16_t history_count = 0;
+static unsigned long lastSampleTime = 0;
+
+// =====================================================================================
+//                                     HTML PAGE
+// =====================================================================================
+
+static const char dashboard_html[] PROGMEM = R"rawliteral(
+<!DOCTYPE html>
+<html>
+<head>
+    <title>Desk Clock</title>
+    <meta name="viewport" content="width=device-width, initial-scale=1">
+    <style>
+        body { font-family: Arial, sans-serif; background-color: #282c34; color: #fff; text-align: center; }
+        .container { max-width: 640px; margin: 0 auto; padding: 20px; }
+        h1 { color: #61afef; }
+        .cards { display: flex; flex-wrap: wrap; justify-content: center; }
+        .card { background-color: #3c4049; border-radius: 5px; margin: 6px; padding: 12px; min-width: 120px; }
+        .value { font-size: 24px; font-weight: bold; color: #98c379; }
+        canvas { width: 100%; height: 180px; background-color: #3c4049; border-radius: 5px; margin-top: 10px; }
+        a { color: #61afef; }
+    </style>
+</head>
+<body>
+    <div class="container">
+        <h1>Desk Clock</h1>
+        <div class="cards">
+            <div class="card">Temp<div class="value" id="temp">--</div></div>
+            <div class="card">Lux<div class="value" id="lux">--</div></div>
+            <div class="card">Heap<div class="value" id="heap">--</div></div>
+            <div class="card">RSSI<div class="value" id="rssi">--</div></div>
+        </div>
+        <canvas id="chart" width="600" height="180"></canvas>
+        <p><a href="/api/history.csv">Download CSV</a> |
+           <a href="/api/series?series=temp&tier=2">Temp, 15 min</a> |
+           <a href="/api/series?series=temp&tier=3">Temp, hourly</a></p>
+    </div>
+    <script>
+        function plot(rows) {
+            var c = document.getElementById('chart'), g = c.getContext('2d');
+            g.clearRect(0, 0, c.width, c.height);
+            if (rows.length < 2) return;
+            var lo = 1e9, hi = -1e9;
+            rows.forEach(function (r) { lo = Math.min(lo, r[1]); hi = Math.max(hi, r[1]); });
+            if (hi - lo < 1) { hi += 0.5; lo -= 0.5; }
+            g.strokeStyle = '#e5c07b'; g.beginPath();
+            rows.forEach(function (r, i) {
+                var x = i * c.width / (rows.length - 1);
+                var y = c.height - (r[1] - lo) * c.height / (hi - lo);
+                if (i) g.lineTo(x, y); else g.moveTo(x, y);
+            });
+            g.stroke();
+        }
+        function refresh() {
+            fetch('/api/now').then(function (r) { return r.json(); }).then(function (d) {
+                document.getElementById('temp').textContent = d.temp.toFixed(1) + ' C';
+                document.getElementById('lux').textContent = d.lux.toFixed(0);
+                document.getElementById('heap').textContent = (d.heap / 1024).toFixed(0) + ' KB';
+                document.getElementById('rssi').textContent = d.rssi + ' dBm';
+            });
+            fetch('/api/history').then(function (r) { return r.json(); }).then(function (d) { plot(d.rows); });
+        }
+        refresh();
+        setInterval(refresh, 10000);
+    </script>
+</body>
+</html>
+)rawliteral";
+
+// =====================================================================================
+//                                     SAMPLING
+// =====================================================================================
+
+static void sampleHistory() {
+    HistorySample& s = history[history_head];
+    s.uptime_s = millis() / 1000;
+    s.temp_c10 = (int16_t)(SensorHub_Value(SENSOR_DS18B20_TEMP, -127.0f) * 10.0f);
+    float lux = SensorHub_Value(SENSOR_LUX, 0.0f);
+    s.lux = (lux > 65535.0f) ? 65535 : (uint16_t)lux;
+    s.free_heap = ESP.getFreeHeap();
+
+    history_head = (history_head + 1) % WEB_HISTORY_SIZE;
+    if (history_count < WEB_HISTORY_SIZE) history_count++;
+}
+
+// =====================================================================================
+//                                 WEB SERVER HANDLERS
+// =====================================================================================
+
+static void handleDashboard() {
+    dashServer.send_P(200, "text/html", dashboard_html);
+}
+
+static void handleNow() {
+    char json[200];
+    snprintf(json, sizeof(json),
+             "{\"uptime\":%lu,\"temp\":%.2f,\"lux\":%.1f,\"humidity\":%.1f,\"heap\":%u,\"rssi\":%d,\"spool\":%u}",
+             millis() / 1000, SensorHub_Value(SENSOR_DS18B20_TEMP, -127.0f), SensorHub_Value(SENSOR_LUX, 0.0f),
+             SensorHub_Value(SENSOR_AHT20_HUMIDITY, -1.0f), (unsigned)ESP.getFreeHeap(),
+             WiFi.RSSI(), (unsigned)MqttSpool_Count());
+    dashServer.send(200, "application/json", json);
+}
+
+// Every hub channel with its newest sample, or the ring of one channel as CSV.
+//   /api/sensors                    - JSON, one entry per channel
+//   /api/sensors?channel=<name>     - CSV, age_ms,value oldest first
+static void handleSensors() {
+    uint32_t now = millis();
+    if (dashServer.hasArg("channel")) {
+        String name = dashServer.arg("channel");
+        for (uint8_t ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+            if (name != SensorHub_ChannelName((SensorChannel)ch)) continue;
+            static SensorSample samples[HUB_RING_LEN]; // Server task only
+            size_t count = SensorHub_History((SensorChannel)ch, samples, HUB_RING_LEN);
+            String csv = "age_ms,value\n";
+            csv.reserve(count * 16 + 16);
+            for (size_t i = 0; i < count; i++) {
+                csv += String(now - samples[i].time_ms) + "," + String(samples[i].value, 2) + "\n";
+            }
+            dashServer.send(200, "text/csv", csv);
+            return;
+        }
+        dashServer.send(404, "text/plain", "Unknown channel");
+        return;
+    }
+
+    char json[512];
+    size_t used = snprintf(json, sizeof(json), "[");
+    for (uint8_t ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+        SensorSample s;
+        bool valid = SensorHub_Latest((SensorChannel)ch, &s);
+        used += snprintf(json + used, sizeof(json) - used, "%s{\"name\":\"%s\",\"unit\":\"%s\"",
+                         ch ? "," : "", SensorHub_ChannelName((SensorChannel)ch), SensorHub_ChannelUnit((SensorChannel)ch));
+        if (valid) {
+            used += snprintf(json + used, sizeof(json) - used, ",\"value\":%.2f,\"age_ms\":%lu}",
+                             s.value, (unsigned long)(now - s.time_ms));
+        } else {
+            used += snprintf(json + used, sizeof(json) - used, ",\"value\":null}");
+        }
+    }
+    snprintf(json + used, sizeof(json) - used, "]");
+    dashServer.send(200, "application/json", json);
+}
+
+// Streams the ring buffer oldest-first as chunked transfer encoding,
+// a few rows per chunk, so no full document is ever built in RAM.
+static void streamHistory(bool csv) {
+    dashServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    dashServer.send(200, csv ? "text/csv" : "application/json", "");
+
+    // Snapshot the indices: sampling happens on this same task, so they can't move underneath us
+    uint16_t count = history_count;
+    uint16_t start = (history_head + WEB_HISTORY_SIZE - count) % WEB_HISTORY_SIZE;
+
+    char chunk[512];
+    size_t used = csv ? snprintf(chunk, sizeof(chunk), "uptime_s,temp_c,lux,free_heap\n")
+                      : snprintf(chunk, sizeof(chunk), "{\"period_ms\":%d,\"rows\":[", WEB_HISTORY_PERIOD_MS);
+    for (uint16_t i = 0; i < count; i++) {
+        const HistorySample& s = history[(start + i) % WEB_HISTORY_SIZE];
+        int n;
+        if (csv) {
+            n = snprintf(chunk + used, sizeof(chunk) - used, "%lu,%.1f,%u,%lu\n",
+                         (unsigned long)s.uptime_s, s.temp_c10 / 10.0f, s.lux, (unsigned long)s.free_heap);
+        } else {
+            n = snprintf(chunk + used, sizeof(chunk) - used, "%s[%lu,%.1f,%u,%lu]", (i == 0) ? "" : ",",
+                         (unsigned long)s.uptime_s, s.temp_c10 / 10.0f, s.lux, (unsigned long)s.free_heap);
+        }
+        used += n;
+        if (used > sizeof(chunk) - 64) {
+            dashServer.sendContent(chunk, used);
+            used = 0;
+        }
+    }
+    if (!csv) used += snprintf(chunk + used, sizeof(chunk) - used, "]}");
+    if (used > 0) dashServer.sendContent(chunk, used);
+    dashServer.sendContent(""); // Terminating zero-length chunk
+}
+
+// Streams a range from the on-flash time-series store as chunked CSV.
+//   /api/series?series=temp|lux&tier=0..3&from=<unix>&to=<unix>
+static void handleSeries() {
+    TsSeries series = (dashServer.arg("series") == "lux") ? TS_SERIES_LUX : TS_SERIES_TEMP;
+    uint8_t tier = dashServer.hasArg("tier") ? dashServer.arg("tier").toInt() : 1;
+    uint32_t to = dashServer.hasArg("to") ? strtoul(dashServer.arg("to").c_str(), NULL, 10) : time(nullptr);
+    uint32_t from = dashServer.hasArg("from") ? strtoul(dashServer.arg("from").c_str(), NULL, 10) : 0;
+    if (tier >= TS_TIER_COUNT) {
+        dashServer.send(400, "text/plain", "tier must be 0..3");
+        return;
+    }
+
+    dashServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    dashServer.send(200, "text/csv", "");
+
+    // Temperatures are stored in 0.1 C
+    float scale = (series == TS_SERIES_TEMP) ? 0.1f : 1.0f;
+    char chunk[512];
+    size_t used = snprintf(chunk, sizeof(chunk), "time,min,avg,max,samples\n");
+    TsIterator it;
+    TsRecord r;
+    TimeSeries_Query(&it, series, tier, from, to);
+    while (TimeSeries_Next(&it, &r)) {
+        used += snprintf(chunk + used, sizeof(chunk) - used, "%lu,%.1f,%.1f,%.1f,%u\n", (unsigned long)r.time,
+                         r.min * scale, r.avg * scale, r.max * scale, r.samples);
+        if (used > sizeof(chunk) - 64) {
+            dashServer.sendContent(chunk, used);
+            used = 0;
+        }
+    }
+    if (used > 0) dashServer.sendContent(chunk, used);
+    dashServer.sendContent(""); // Terminating zero-length chunk
+}
+
+static void handleHistoryJson() { streamHistory(false); }
+static void handleHistoryCsv() { streamHistory(true); }
+
+static void handleNotFound() {
+    dashServer.send(404, "text/plain", "Not found");
+}
+
+// =====================================================================================
+//                                     SERVER TASK
+// =====================================================================================
+
+static void WebDashboard_Task(void *pvParameters) {
+    dashServer.on("/", handleDashboard);
+    dashServer.on("/api/now", handleNow);
+    dashServer.on("/api/sensors", handleSensors);
+    dashServer.on("/api/history", handleHistoryJson);
+    dashServer.on("/api/history.csv", handleHistoryCsv);
+    dashServer.on("/api/series", handleSeries);
+    dashServer.onNotFound(handleNotFound);
+    dashServer.begin();
+    Serial.print("Dashboard running at http://");
+    Serial.println(WiFi.localIP());
+
+    for (;;) {
+        if (millis() - lastSampleTime >= WEB_HISTORY_PERIOD_MS || lastSampleTime == 0) {
+            lastSampleTime = millis();
+            sampleHistory();
+        }
+        dashServer.handleClient();
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+void WebDashboard_Init() {
+    if (webTaskHandle != NULL) return;
+    xTaskCreate(WebDashboard_Task, "WebDashboard", 6144, NULL, 1, &webTaskHandle);
+}
@@ -0,0 +1,17 @@
+#ifndef WEBDASHBOARD_H
+#define WEBDASHBOARD_H
+
+// Permanent HTTP dashboard served on port 80 once WiFi is connected.
+//   /                 - HTML dashboard
+//   /api/now          - current readings as JSON
+//   /api/sensors      - every sensor hub channel, or one channel's recent samples
+//   /api/history      - recent temperature/lux/heap history, chunked JSON
+//   /api/history.csv  - the same history as chunked CSV
+//   /api/series       - long-term min/avg/max from the TimeSeries store, chunked CSV
+#define WEB_HISTORY_SIZE       360     // Samples kept in RAM
+#define WEB_HISTORY_PERIOD_MS  10000   // One sample every 10 s -> 1 hour
+
+// Starts the web server on its own low-priority task.
+void WebDashboard_Init();
+
+#endif // WEBDASHBOARD_H
@@ -3,7 +3,11 @@
 #include <WebServer.h>
 #include <DNSServer.h>
 #include <AsyncUDP.h>
-#include <Preferences.h>
+#include <Preferences.h> // Legacy credential storage, only read for migration
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include "Settings.h"
 #include "Menu.h" // For using the menuSprite for display
 #include "System.h" // For tftLog
 #include "weather.h" // For connectWiFi() fallback
@@ -16,6 +20,45 @@ Preferences preferences;
 // --- Variables ---
 const char* ap_ssid = "WeatherClock_Setup";
 
+// --- Stored Credentials ---
+#define WIFI_SETTINGS_VERSION 1
+#define WIFI_LEASE_SETTINGS_VERSION 3
+
+struct WiFiCredentials {
+    char ssid[33];
+    char password[65];
+};
+
+// --- Fast Reconnect Cache ---
+// Last good BSSID/channel and DHCP lease, stored as one settings record so a
+// reconnect can skip the scan and DHCP round-trips. The lease is only reused
+// as a static IP up to its renewal time (T1, half the lease), after which the
+// server may hand the address out again; past that the directed connect
+// still skips the scan but asks DHCP.
+#define FAST_CONNECT_TIMEOUT_MS 1500
+#define FAST_CONNECT_MAX_FAILS  3
+#define FAST_CONNECT_VALID_TIME 1600000000UL   // Clock not set by NTP before this
+
+struct FastConnectCache {
+    char ssid[33];              // The lease only applies to this network
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns1;
+    uint32_t dns2;
+    uint32_t lease_s;           // Lease time granted, 0 if unknown
+    uint32_t acquired;          // Unix time the lease was granted, 0 if the clock wasn't set
+};
+
+static FastConnectCache fastCache;
+static bool fastCacheValid = false;
+static volatile uint8_t fastConnectFails = 0;
+static volatile bool fastCacheStale = false;   // Set from the event task, cleared on next begin
+static bool staticLeaseApplied = false;         // The current connect reused the cached lease
+static bool wifiEventsRegistered = false;
+
 // =====================================================================================
 //                                     HTML PAGE
 // =====================================================================================
@@ -57,6 +100,144 @@ const char* wifi_manager_html = R"rawliteral(
 </html>
 )rawliteral";
 
+// =====================================================================================
+//                                 FAST RECONNECT
+// =====================================================================================
+
+static void loadFastConnectCache() {
+    fastCacheValid = Settings_Load(SETTINGS_KEY_WIFI_LEASE, WIFI_LEASE_SETTINGS_VERSION, &fastCache, sizeof(fastCache))
+                     && fastCache.channel != 0 && fastCache.ip != 0;
+}
+
+// Lease time the DHCP client got, 0 if unknown.
+static uint32_t dhcpLeaseSeconds() {
+    esp_netif_t* netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    struct netif* lwip = netif ? (struct netif*)esp_netif_get_netif_impl(netif) : NULL;
+    struct dhcp* dhcp = lwip ? netif_dhcp_data(lwip) : NULL;
+    return dhcp ? dhcp->offered_t0_lease : 0;
+}
+
+static bool leaseStillValid() {
+    uint32_t now = time(nullptr);
+    if (now < FAST_CONNECT_VALID_TIME || fastCache.acquired == 0 || fastCache.lease_s == 0) return false;
+    return now - fastCache.acquired < fastCache.lease_s / 2;
+}
+
+// Stores the current BSSID/channel/lease, only writing flash when something changed.
+static void saveFastConnectCache() {
+    FastConnectCache current{}; // Zeroed padding, or the memcmp below never matches
+    strlcpy(current.ssid, WiFi.SSID().c_str(), sizeof(current.ssid));
+    memcpy(current.bssid, WiFi.BSSID(), sizeof(current.bssid));
+    current.channel = WiFi.channel();
+    current.ip = (uint32_t)WiFi.localIP();
+    current.gateway = (uint32_t)WiFi.gatewayIP();
+    current.subnet = (uint32_t)WiFi.subnetMask();
+    current.dns1 = (uint32_t)WiFi.dnsIP(0);
+    current.dns2 = (uint32_t)WiFi.dnsIP(1);
+    if (staticLeaseApplied) {
+        // No DHCP exchange happened: the lease is as old as it was
+        current.lease_s = fastCache.lease_s;
+        current.acquired = fastCache.acquired;
+    } else {
+        uint32_t now = time(nullptr);
+        current.lease_s = dhcpLeaseSeconds();
+        current.acquired = (now >= FAST_CONNECT_VALID_TIME) ? now : 0;
+    }
+
+    if (fastCacheValid && memcmp(&current, &fastCache, sizeof(current)) == 0) return;
+    fastCache = current;
+    fastCacheValid = true;
+    Settings_Save(SETTINGS_KEY_WIFI_LEASE, WIFI_LEASE_SETTINGS_VERSION, &fastCache, sizeof(fastCache));
+    Serial.println("Fast-connect cache updated.");
+}
+
+static void clearFastConnectCache() {
+    fastCacheValid = false;
+    Settings_Remove(SETTINGS_KEY_WIFI_LEASE);
+    // Back to DHCP for the next plain connect
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+}
+
+static void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        fastConnectFails = 0;
+        saveFastConnectCache();
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+        // The driver's auto-reconnect reuses the directed BSSID/channel config.
+        // If the AP keeps failing (moved channel, replaced router), drop the cache.
+        if (fastCacheValid && ++fastConnectFails >= FAST_CONNECT_MAX_FAILS) {
+            Serial.println("Fast-connect cache stale, clearing.");
+            fastCacheValid = false;
+            fastCacheStale = true;
+            fastConnectFails = 0;
+            WiFi.setAutoReconnect(false); // Stop retrying the locked BSSID; the next begin does a full connect
+        }
+    }
+}
+
+static void registerWiFiEvents() {
+    if (wifiEventsRegistered) return;
+    WiFi.onEvent(onWiFiEvent, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    WiFi.onEvent(onWiFiEvent, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    wifiEventsRegistered = true;
+}
+
+static bool cacheMatches(const char* ssid) {
+    return fastCacheValid && strcmp(fastCache.ssid, ssid) == 0;
+}
+
+// Starts a connection attempt without blocking. Uses the cached BSSID and
+// channel when available, plus the cached lease while it is still valid;
+// otherwise DHCP.
+bool beginWiFiFastReconnect(const char* ssid, const char* pass) {
+    registerWiFiEvents();
+    if (fastCacheStale) {
+        clearFastConnectCache();
+        fastCacheStale = false;
+    } else if (!fastCacheValid) {
+        loadFastConnectCache();
+    }
+
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(true);
+    WiFi.setSleep(false);
+    staticLeaseApplied = cacheMatches(ssid) && leaseStillValid();
+    if (staticLeaseApplied) {
+        WiFi.config(IPAddress(fastCache.ip), IPAddress(fastCache.gateway), IPAddress(fastCache.subnet),
+                    IPAddress(fastCache.dns1), IPAddress(fastCache.dns2));
+    } else {
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    }
+    if (cacheMatches(ssid)) {
+        WiFi.begin(ssid, pass, fastCache.channel, fastCache.bssid, true);
+        return true;
+    }
+    WiFi.begin(ssid, pass);
+    return false;
+}
+
+// Directed connect with the cached parameters, polling every 20 ms.
+// Returns false (and clears the cache) if the AP does not answer in time.
+bool fastConnectWiFi(const char* ssid, const char* pass) {
+    loadFastConnectCache();
+    if (!cacheMatches(ssid)) return false;
+
+    unsigned long start = millis();
+    beginWiFiFastReconnect(ssid, pass);
+    while (WiFi.status() != WL_CONNECTED && millis() - start < FAST_CONNECT_TIMEOUT_MS) {
+        delay(20);
+    }
+    if (WiFi.status() == WL_CONNECTED) {
+        Serial.printf("Fast connect in %lu ms\n", millis() - start);
+        return true;
+    }
+
+    Serial.println("Fast connect failed, falling back to full connect.");
+    WiFi.disconnect();
+    clearFastConnectCache();
+    return false;
+}
+
 // =====================================================================================
 //                                 WEB SERVER HANDLERS
 // =====================================================================================
@@ -85,11 +266,11 @@ void handleSave() {
     Serial.println("SSID: " + ssid);
     Serial.println("Password: " + password);
 
-    // Save credentials to Preferences
-    preferences.begin("wifi-creds", false);
-    preferences.putString("ssid", ssid);
-    preferences.putString("password", password);
-    preferences.end();
+    // Save credentials to the settings store
+    WiFiCredentials creds = {};
+    strncpy(creds.ssid, ssid.c_str(), sizeof(creds.ssid) - 1);
+    strncpy(creds.password, password.c_str(), sizeof(creds.password) - 1);
+    Settings_Save(SETTINGS_KEY_WIFI, WIFI_SETTINGS_VERSION, &creds, sizeof(creds));
 
     // Display saving message
     menuSprite.fillScreen(TFT_BLACK);
@@ -119,23 +300,33 @@ bool connectWiFi_with_Manager() {
     tft.fillScreen(TFT_BLACK);
     tftClearLog();
 
-    preferences.begin("wifi-creds", true); // Read-only mode first
-    String saved_ssid = preferences.getString("ssid", "");
-    String saved_pass = preferences.getString("password", "");
-    preferences.end();
+    WiFiCredentials creds = {};
+    if (!Settings_Load(SETTINGS_KEY_WIFI, WIFI_SETTINGS_VERSION, &creds, sizeof(creds))) {
+        // Migrate credentials saved by older firmware
+        preferences.begin("wifi-creds", true);
+        preferences.getString("ssid", creds.ssid, sizeof(creds.ssid));
+        preferences.getString("password", creds.password, sizeof(creds.password));
+        preferences.end();
+        if (creds.ssid[0] != '\0') Settings_Save(SETTINGS_KEY_WIFI, WIFI_SETTINGS_VERSION, &creds, sizeof(creds));
+    }
+    String saved_ssid = creds.ssid;
+    String saved_pass = creds.password;
 
     // --- Try to connect with saved credentials ---
     if (saved_ssid.length() > 0) {
+        // Directed connect to the last known AP, no scan and no DHCP
+        if (fastConnectWiFi(saved_ssid.c_str(), saved_pass.c_str())) {
+            tftLog("Fast reconnect OK", TFT_GREEN);
+            return true;
+        }
+
         tftLog("Found saved network:", TFT_WHITE);
         tftLog(saved_ssid.c_str(), TFT_CYAN);
         tftLog("Connecting...", TFT_WHITE);
 
-        WiFi.mode(WIFI_STA);
-        WiFi.setAutoReconnect(true);
         WiFi.persistent(true);
-        WiFi.setSleep(false);
         WiFi.setTxPower(WIFI_POWER_19_5dBm);
-        WiFi.begin(saved_ssid.c_str(), saved_pass.c_str());
+        beginWiFiFastReconnect(saved_ssid.c_str(), saved_pass.c_str()); // Cache was cleared: plain DHCP connect
         tftLog("WiFi.begin() called", TFT_YELLOW);
         int attempts = 0;
         while (WiFi.status() != WL_CONNECTED && attempts < 10) {
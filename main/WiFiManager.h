@@ -6,4 +6,14 @@
 // Returns true if already connected, false if it starts the config portal.
 bool connectWiFi_with_Manager();
 
+// Starts a non-blocking connect, directed at the cached BSSID/channel when
+// available, reusing the cached lease as a static IP only until its renewal
+// time. Returns true if the cache was used.
+bool beginWiFiFastReconnect(const char* ssid, const char* pass);
+
+// Blocking directed connect with the cached BSSID/channel/lease, at most
+// about 1.5 s. False if there is no cache for this SSID or the
+// AP did not answer; the cache is dropped in the latter case.
+bool fastConnectWiFi(const char* ssid, const char* pass);
+
 #endif // WIFIMANAGER_H
@@ -5,7 +5,8 @@
 #include "RotaryEncoder.h"
 #include "Alarm.h"
 #include "Buzzer.h" // For BUZZER_PIN
-#include "LED.h" // Include LED.h to use the global strip object
+#include "LED.h" // For Adafruit_NeoPixel::Color
+#include "LedEngine.h"
 
 // Global flag to signal task to stop
 volatile bool stopAnimationTask = false;
@@ -35,8 +36,7 @@ void Animation_task(void *pvParameters)
     uint8_t r = (fg_color & 0xF800) >> 8;
     uint8_t g = (fg_color & 0x07E0) >> 3;
     uint8_t b = (fg_color & 0x001F) << 3;
-    strip.fill(strip.Color(r, g, b)); // Use the global strip object
-    strip.show();
+    LedEngine_Fade(Adafruit_NeoPixel::Color(r, g, b), delay_ms / 2);
 
     // 3. Play a sound effect using tone() with a duration
     tone(BUZZER_PIN, random(800, 1500), delay_ms);
@@ -51,8 +51,7 @@ void Animation_task(void *pvParameters)
 
   // Cleanup before exiting
   noTone(BUZZER_PIN);
-  strip.clear();
-  strip.show();
+  LedEngine_Off();
   animationTaskHandle = NULL; // Clear the handle
   vTaskDelete(NULL); // Delete self
 }
@@ -61,9 +60,6 @@ void AnimationMenu()
 {
   tft.fillScreen(TFT_BLACK);
   
-  // Initialize NeoPixel strip
-  strip.show(); // Initialize all pixels to 'off'
-
   stopAnimationTask = false; // Reset the flag
   
   // Make sure no old task is running
@@ -0,0 +1,228 @@
+/*
+
+        Host benchmark: FixedMath.h against libm
+
+        Build and run from this folder:
+          g++ -O2 -std=c++17 -I../.. fixed_math_benchmark.cpp -o fixed_math_benchmark
+          ./fixed_math_benchmark
+
+        For every function it sweeps the input range, compares each result
+        with the double libm reference and reports the largest error, in the
+        units the table at the top of FixedMath.h uses, plus the time per
+        call against the float libm call it replaces.
+
+        Exp2 and Pow are scored relative to the reference, and only where the
+        result is at least 1.0 and below FIX_MAX: under 1.0 the Q16.16 step
+        (1.5e-5) is the error, above FIX_MAX the result saturates.
+
+        Host timings say little about the ESP32-C3: a desktop CPU has an FPU,
+        the C3 emulates every float operation in software, so libm is far
+        slower there than the ratio here suggests. The error columns carry
+        over as they are.
+
+*/
+
+#include "FixedMath.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static const int repeats = 20;
+static const double twoPi = 6.283185307179586;
+
+static volatile int64_t sink; // Keeps the timed loops from being optimised out
+
+static double wrapAngle(double units) {
+  units = fmod(units, 65536.0);
+  if (units > 32768) units -= 65536;
+  if (units < -32768) units += 65536;
+  return units;
+}
+
+template <typename F> static double nsPerCall(size_t calls, F body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++) body();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (repeats * (double)calls);
+}
+
+static void report(const char *name, const char *error, double fixNs,
+                   double libmNs) {
+  printf("  %-12s %-34s %7.2f ns   libm %7.2f ns\n", name, error, fixNs,
+         libmNs);
+}
+
+static void benchSin() {
+  double worst = 0;
+  for (uint32_t a = 0; a < 65536; a++) {
+    double ref = sin(a * twoPi / 65536) * 65536;
+    worst = fmax(worst, fabs(Fix_Sin((fix_angle_t)a) - ref));
+  }
+  double fixNs = nsPerCall(65536, [] {
+    int64_t acc = 0;
+    for (uint32_t a = 0; a < 65536; a++) acc += Fix_Sin((fix_angle_t)a);
+    sink = acc;
+  });
+  double libmNs = nsPerCall(65536, [] {
+    float acc = 0;
+    for (uint32_t a = 0; a < 65536; a++) acc += sinf(a * (float)(twoPi / 65536));
+    sink = (int64_t)acc;
+  });
+  char error[64];
+  snprintf(error, sizeof(error), "%.2f LSB (%.2g)", worst, worst / 65536);
+  report("Fix_Sin", error, fixNs, libmNs);
+}
+
+static void benchAtan2() {
+  std::vector<int32_t> xs, ys;
+  for (int32_t y = -1000; y <= 1000; y += 7) {
+    for (int32_t x = -1000; x <= 1000; x += 7) {
+      xs.push_back(x);
+      ys.push_back(y);
+    }
+  }
+  // Large operands exercise the pre-shift
+  for (int32_t k = -40; k <= 40; k++) {
+    xs.push_back(k * 50000000);
+    ys.push_back(2000000000 - k * 3000000);
+  }
+  double worst = 0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    if (xs[i] == 0 && ys[i] == 0) continue;
+    double ref = atan2((double)ys[i], (double)xs[i]) * 65536 / twoPi;
+    worst = fmax(worst, fabs(wrapAngle(Fix_Atan2(ys[i], xs[i]) - ref)));
+  }
+  double fixNs = nsPerCall(xs.size(), [&] {
+    int64_t acc = 0;
+    for (size_t i = 0; i < xs.size(); i++) acc += Fix_Atan2(ys[i], xs[i]);
+    sink = acc;
+  });
+  double libmNs = nsPerCall(xs.size(), [&] {
+    float acc = 0;
+    for (size_t i = 0; i < xs.size(); i++) acc += atan2f((float)ys[i], (float)xs[i]);
+    sink = (int64_t)acc;
+  });
+  char error[64];
+  snprintf(error, sizeof(error), "%.2f angle units (%.4f deg)", worst,
+           worst * 360 / 65536);
+  report("Fix_Atan2", error, fixNs, libmNs);
+}
+
+static void benchSqrt() {
+  std::vector<fix16_t> xs;
+  for (int64_t x = 1; x <= FIX_MAX; x += 997) xs.push_back((fix16_t)x);
+  xs.push_back(FIX_MAX);
+  uint32_t wrong = 0;
+  for (fix16_t x : xs) {
+    uint64_t ref = (uint64_t)floorl(sqrtl((long double)x * 65536));
+    if ((uint64_t)Fix_Sqrt(x) != ref) wrong++;
+  }
+  double fixNs = nsPerCall(xs.size(), [&] {
+    int64_t acc = 0;
+    for (fix16_t x : xs) acc += Fix_Sqrt(x);
+    sink = acc;
+  });
+  double libmNs = nsPerCall(xs.size(), [&] {
+    float acc = 0;
+    for (fix16_t x : xs) acc += sqrtf(x * (1.0f / 65536));
+    sink = (int64_t)acc;
+  });
+  char error[64];
+  if (wrong == 0) snprintf(error, sizeof(error), "exact (floor)");
+  else snprintf(error, sizeof(error), "%u of %zu not floor", wrong, xs.size());
+  report("Fix_Sqrt", error, fixNs, libmNs);
+}
+
+static void benchLog2() {
+  std::vector<fix16_t> xs;
+  for (int64_t x = 1; x <= FIX_MAX; x += 613) xs.push_back((fix16_t)x);
+  double worst = 0;
+  for (fix16_t x : xs) {
+    double ref = log2(x / 65536.0) * 65536;
+    worst = fmax(worst, fabs(Fix_Log2(x) - ref));
+  }
+  double fixNs = nsPerCall(xs.size(), [&] {
+    int64_t acc = 0;
+    for (fix16_t x : xs) acc += Fix_Log2(x);
+    sink = acc;
+  });
+  double libmNs = nsPerCall(xs.size(), [&] {
+    float acc = 0;
+    for (fix16_t x : xs) acc += log2f(x * (1.0f / 65536));
+    sink = (int64_t)acc;
+  });
+  char error[64];
+  snprintf(error, sizeof(error), "%.2f LSB", worst);
+  report("Fix_Log2", error, fixNs, libmNs);
+}
+
+static void benchExp2() {
+  std::vector<fix16_t> xs;
+  for (int64_t x = -17 * (int64_t)FIX_ONE; x < 15 * (int64_t)FIX_ONE; x += 3)
+    xs.push_back((fix16_t)x);
+  double worst = 0;
+  for (fix16_t x : xs) {
+    double ref = exp2(x / 65536.0) * 65536;
+    if (ref < FIX_ONE || ref >= FIX_MAX) continue;
+    worst = fmax(worst, fabs(Fix_Exp2(x) - ref) / ref);
+  }
+  double fixNs = nsPerCall(xs.size(), [&] {
+    int64_t acc = 0;
+    for (fix16_t x : xs) acc += Fix_Exp2(x);
+    sink = acc;
+  });
+  double libmNs = nsPerCall(xs.size(), [&] {
+    float acc = 0;
+    for (fix16_t x : xs) acc += exp2f(x * (1.0f / 65536));
+    sink = (int64_t)acc;
+  });
+  char error[64];
+  snprintf(error, sizeof(error), "%.2g relative", worst);
+  report("Fix_Exp2", error, fixNs, libmNs);
+}
+
+static void benchPow() {
+  // Bases from just above 0 to 256, exponents from -4 to 4. The error grows
+  // with |y|, which scales the Log2 error, by about 1e-5 per unit
+  std::vector<fix16_t> xs, ys;
+  for (int64_t x = 64; x <= 256 * (int64_t)FIX_ONE; x = x * 17 / 16 + 1) {
+    for (int64_t y = -4 * (int64_t)FIX_ONE; y <= 4 * (int64_t)FIX_ONE; y += 97) {
+      xs.push_back((fix16_t)x);
+      ys.push_back((fix16_t)y);
+    }
+  }
+  double worst = 0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    double ref = pow(xs[i] / 65536.0, ys[i] / 65536.0) * 65536;
+    if (ref < FIX_ONE || ref >= FIX_MAX) continue;
+    worst = fmax(worst, fabs(Fix_Pow(xs[i], ys[i]) - ref) / ref);
+  }
+  double fixNs = nsPerCall(xs.size(), [&] {
+    int64_t acc = 0;
+    for (size_t i = 0; i < xs.size(); i++) acc += Fix_Pow(xs[i], ys[i]);
+    sink = acc;
+  });
+  double libmNs = nsPerCall(xs.size(), [&] {
+    float acc = 0;
+    for (size_t i = 0; i < xs.size(); i++)
+      acc += powf(xs[i] * (1.0f / 65536), ys[i] * (1.0f / 65536));
+    sink = (int64_t)acc;
+  });
+  char error[64];
+  snprintf(error, sizeof(error), "%.2g relative", worst);
+  report("Fix_Pow", error, fixNs, libmNs);
+}
+
+int main() {
+  printf("FixedMath benchmark, largest error against double libm, %d passes\n\n",
+         repeats);
+  benchSin();
+  benchAtan2();
+  benchSqrt();
+  benchLog2();
+  benchExp2();
+  benchPow();
+  return 0;
+}
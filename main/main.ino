@@ -22,27 +22,24 @@ void setup() {
         return;
     }
     Serial.println("LittleFS mounted successfully");
-    
-    // Initialize MQTT, assuming WiFi is now connected
-    // connectMQTT(); 
+    // MQTT is set up by bootSystem() once WiFi is connected
 }
 
 void loop() {
     // Alarm_Loop_Check(); // Now runs in a background task
-    // loopMQTT(); // Keep the MQTT client running
-
-    // // Check if a menu navigation was requested via MQTT
-    // if (requestedMenuAction != nullptr) {
-    //     // A menu was requested via MQTT
-    //     void (*actionToRun)() = (void (*)())requestedMenuAction; // Copy to a local, non-volatile variable
-    //     requestedMenuAction = nullptr; // Reset the flag immediately
-        
-    //     actionToRun();      // Execute the requested menu function
-    //     showMenuConfig();   // Redraw the main menu after the submenu exits
-    // } else {
-    //     // No MQTT command, proceed with normal encoder-based menu
-    //     showMenu();
-    // }
-    showMenu();
+    // loopMQTT() runs in its own task, started by setupMQTT()
+
+    // Check if a menu navigation was requested remotely (MQTT or BLE)
+    if (requestedMenuAction != nullptr) {
+        void (*actionToRun)() = (void (*)())requestedMenuAction; // Copy to a local, non-volatile variable
+        requestedMenuAction = nullptr; // Reset the flag immediately
+        exitSubMenu = false; // The "leave current screen" request has been served
+
+        actionToRun();      // Execute the requested menu function
+        showMenuConfig();   // Redraw the main menu after the submenu exits
+    } else {
+        // No remote command, proceed with normal encoder-based menu
+        showMenu();
+    }
     vTaskDelay(pdMS_TO_TICKS(15));
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+# PC 性能监控发送端
+# Sends CPU/GPU/RAM/network/disk stats to the clock's Performance screen
+# using the framed binary protocol described in performance.h:
+#   COBS( [type][version][payload][crc16 lo][crc16 hi] ) + 0x00
+#
+# Requirements: pip install pyserial psutil   (optional: nvidia-ml-py for GPU)
+# Usage:        python pc_monitor_sender.py COM5 --rate 10
+import argparse
+import struct
+import sys
+import time
+
+import psutil
+import serial
+
+try:
+    import pynvml
+    pynvml.nvmlInit()
+    GPU_HANDLE = pynvml.nvmlDeviceGetHandleByIndex(0)
+except Exception:
+    GPU_HANDLE = None
+
+# --- Protocol constants (must match performance.h) ---
+PCMON_VERSION = 1
+PCMON_FRAME_STATS = 0x01
+PCMON_FRAME_NAMES = 0x02
+PCMON_MAX_CORES = 16
+PCMON_NAME_LEN = 63
+
+
+def crc16_ccitt(data: bytes) -> int:
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray()
+    block = bytearray()
+    for b in data:
+        if b == 0:
+            out.append(len(block) + 1)
+            out += block
+            block.clear()
+        else:
+            block.append(b)
+            if len(block) == 254:
+                out.append(255)
+                out += block
+                block.clear()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def build_frame(frame_type: int, payload: bytes) -> bytes:
+    body = bytes([frame_type, PCMON_VERSION]) + payload
+    body += struct.pack('<H', crc16_ccitt(body))
+    return cobs_encode(body) + b'\x00'
+
+
+def clamp(value, lo, hi):
+    return max(lo, min(hi, int(value)))
+
+
+def read_cpu_temp() -> int:
+    try:
+        temps = psutil.sensors_temperatures()
+    except AttributeError:  # Not available on Windows
+        return 0
+    for name in ('coretemp', 'k10temp', 'cpu_thermal', 'acpitz'):
+        if name in temps and temps[name]:
+            return int(temps[name][0].current)
+    return 0
+
+
+def read_gpu():
+    if GPU_HANDLE is None:
+        return 0, 0, 'Unknown'
+    util = pynvml.nvmlDeviceGetUtilizationRates(GPU_HANDLE).gpu
+    temp = pynvml.nvmlDeviceGetTemperature(GPU_HANDLE, pynvml.NVML_TEMPERATURE_GPU)
+    name = pynvml.nvmlDeviceGetName(GPU_HANDLE)
+    if isinstance(name, bytes):
+        name = name.decode()
+    return util, temp, name
+
+
+def cpu_name() -> str:
+    import platform
+    name = platform.processor() or platform.machine()
+    if sys.platform.startswith('linux'):
+        try:
+            with open('/proc/cpuinfo') as f:
+                for line in f:
+                    if line.startswith('model name'):
+                        return line.split(':', 1)[1].strip()
+        except OSError:
+            pass
+    return name
+
+
+def stats_frame(seq: int, rates: dict) -> bytes:
+    cores = psutil.cpu_percent(percpu=True)[:PCMON_MAX_CORES]
+    mem = psutil.virtual_memory()
+    gpu_load, gpu_temp, _ = read_gpu()
+    payload = struct.pack(
+        '<BBbBbHHHIIIIB',
+        seq & 0xFF,
+        clamp(sum(cores) / max(len(cores), 1), 0, 100),
+        clamp(read_cpu_temp(), -128, 127),
+        clamp(gpu_load, 0, 100),
+        clamp(gpu_temp, -128, 127),
+        clamp(mem.percent * 10, 0, 1000),
+        clamp(mem.used // (1024 * 1024), 0, 0xFFFF),
+        clamp(mem.total // (1024 * 1024), 0, 0xFFFF),
+        clamp(rates['net_rx'], 0, 0xFFFFFFFF),
+        clamp(rates['net_tx'], 0, 0xFFFFFFFF),
+        clamp(rates['disk_read'], 0, 0xFFFFFFFF),
+        clamp(rates['disk_write'], 0, 0xFFFFFFFF),
+        len(cores),
+    )
+    payload += bytes(clamp(c, 0, 100) for c in cores)
+    return build_frame(PCMON_FRAME_STATS, payload)
+
+
+def names_frame() -> bytes:
+    cpu = cpu_name().encode('utf-8')[:PCMON_NAME_LEN]
+    gpu = read_gpu()[2].encode('utf-8')[:PCMON_NAME_LEN]
+    return build_frame(PCMON_FRAME_NAMES, bytes([len(cpu)]) + cpu + bytes([len(gpu)]) + gpu)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Send PC stats to the desk clock')
+    parser.add_argument('port', help='Serial port, e.g. COM5 or /dev/ttyUSB0')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--rate', type=float, default=10.0, help='Frames per second')
+    args = parser.parse_args()
+
+    period = 1.0 / args.rate
+    ser = serial.Serial(args.port, args.baud, timeout=0)
+    psutil.cpu_percent(percpu=True)  # Prime the CPU counters
+
+    net = psutil.net_io_counters()
+    disk = psutil.disk_io_counters()
+    last = time.monotonic()
+    seq = 0
+    next_names = 0.0
+    print(f'Sending to {args.port} at {args.rate:.1f} Hz, Ctrl+C to stop')
+
+    while True:
+        time.sleep(period)
+        now = time.monotonic()
+        dt = max(now - last, 1e-3)
+        net_now = psutil.net_io_counters()
+        disk_now = psutil.disk_io_counters()
+        rates = {
+            'net_rx': (net_now.bytes_recv - net.bytes_recv) / dt,
+            'net_tx': (net_now.bytes_sent - net.bytes_sent) / dt,
+            'disk_read': (disk_now.read_bytes - disk.read_bytes) / dt if disk else 0,
+            'disk_write': (disk_now.write_bytes - disk.write_bytes) / dt if disk else 0,
+        }
+        net, disk, last = net_now, disk_now, now
+
+        if now >= next_names:  # Names rarely change, resend every 2 s
+            ser.write(names_frame())
+            next_names = now + 2.0
+        ser.write(stats_frame(seq, rates))
+        seq += 1
+        ser.read(ser.in_waiting or 0)  # Discard the device's debug output
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
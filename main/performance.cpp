@@ -4,6 +4,7 @@
 #include "Menu.h"
 #include "MQTT.h"
 #include "RotaryEncoder.h"
+#include "SensorHub.h"
 #include "Alarm.h"
 // -----------------------------
 // 🔧 配置区
@@ -20,6 +21,14 @@ struct PCData {
   int gpuTemp;
   int gpuLoad;
   float ramLoad;
+  uint16_t ramUsedMB;
+  uint16_t ramTotalMB;
+  uint32_t netRxBps;
+  uint32_t netTxBps;
+  uint32_t diskReadBps;
+  uint32_t diskWriteBps;
+  uint8_t coreCount;
+  uint8_t coreLoad[PCMON_MAX_CORES];
   bool valid;
 };
 float esp32c3_temp = 0.0f;
@@ -31,18 +40,17 @@ struct PCData pcData = {.cpuName = "Unknown",
                         .gpuLoad = 0,
                         .ramLoad = 0.0,
                         .valid = false};
-char inputBuffer[BUFFER_SIZE];
+uint8_t inputBuffer[BUFFER_SIZE];
 uint16_t bufferIndex = 0;
-bool stringComplete = false;
+bool frameOverflow = false;               // Drop bytes until the next delimiter
+unsigned long lastFrameTime = 0;
+static TaskHandle_t serialTaskHandle = NULL;
 SemaphoreHandle_t xPCDataMutex = NULL;
 extern TFT_eSPI tft; // 声明外部 TFT 对象
 
-// Combined chart for all four traces
-GraphWidget combinedChart = GraphWidget(&tft);
-TraceWidget cpuLoadTrace = TraceWidget(&combinedChart);
-TraceWidget gpuLoadTrace = TraceWidget(&combinedChart);
-TraceWidget cpuTempTrace = TraceWidget(&combinedChart);
-TraceWidget gpuTempTrace = TraceWidget(&combinedChart);
+// Combined scrolling chart for all four series
+ChartWidget combinedChart = ChartWidget(&tft);
+static int8_t cpuLoadSeries, gpuLoadSeries, ramLoadSeries, gpuTempSeries;
 
 // 绘制静态元素
 void drawPerformanceStaticElements() {
@@ -60,11 +68,15 @@ void drawPerformanceStaticElements() {
   tft.setTextColor(TFT_ORANGE, BG_COLOR);
   tft.drawString("ESP:", DATA_X, DATA_Y + 3 * LINE_HEIGHT);
 
-  // Combined Chart Setup
-  combinedChart.createGraph(COMBINED_CHART_WIDTH, COMBINED_CHART_HEIGHT, tft.color565(5, 5, 5));
-  combinedChart.setGraphScale(0.0, 100.0, 0.0, 100.0); // X and Y scale from 0 to 100
-  combinedChart.setGraphGrid(0.0, 25.0, 0.0, 25.0, TFT_DARKGREY);
-  combinedChart.drawGraph(COMBINED_CHART_X, COMBINED_CHART_Y);
+  // Combined Chart Setup: 2 px per sample, the last ~50 s at one sample per 500 ms
+  combinedChart.createChart(COMBINED_CHART_WIDTH, COMBINED_CHART_HEIGHT, 2, tft.color565(5, 5, 5));
+  cpuLoadSeries = combinedChart.addSeries(TFT_GREEN);
+  gpuLoadSeries = combinedChart.addSeries(TFT_BLUE);
+  ramLoadSeries = combinedChart.addSeries(TFT_RED);
+  gpuTempSeries = combinedChart.addSeries(TFT_ORANGE);
+  combinedChart.setChartScale(0.0, 100.0); // Percentages, and GPU temperature in C
+  combinedChart.setChartGrid(25, 4, TFT_DARKGREY);
+  combinedChart.drawChart(COMBINED_CHART_X, COMBINED_CHART_Y);
   
   // Legend for combined chart
   tft.setTextSize(1); // Smaller text for legend
@@ -94,52 +106,92 @@ void drawPerformanceStaticElements() {
   tft.drawString("0", COMBINED_CHART_X - 15, combinedChart.getPointY(0));
   tft.drawString("50", COMBINED_CHART_X - 15, combinedChart.getPointY(50));
   tft.drawString("100", COMBINED_CHART_X - 15, combinedChart.getPointY(100));
+}
+
+// Bytes/s as "999B", "1.2K", "12K", "1.2M"...
+static void formatRate(uint32_t bps, char *out, size_t size) {
+  const char units[] = {'B', 'K', 'M', 'G'};
+  float value = bps;
+  uint8_t unit = 0;
+  while (value >= 1000.0f && unit < sizeof(units) - 1) {
+    value /= 1024.0f;
+    unit++;
+  }
+  if (unit == 0) snprintf(out, size, "%u%c", (unsigned)bps, units[0]);
+  else if (value < 10.0f) snprintf(out, size, "%.1f%c", value, units[unit]);
+  else snprintf(out, size, "%.0f%c", value, units[unit]);
+}
+
+static void drawIoRates(const PCData &data) {
+  char rx[8], tx[8], rd[8], wr[8];
+  formatRate(data.netRxBps, rx, sizeof(rx));
+  formatRate(data.netTxBps, tx, sizeof(tx));
+  formatRate(data.diskReadBps, rd, sizeof(rd));
+  formatRate(data.diskWriteBps, wr, sizeof(wr));
 
-  cpuLoadTrace.startTrace(TFT_GREEN);
-  gpuLoadTrace.startTrace(TFT_BLUE);
-  cpuTempTrace.startTrace(TFT_RED);
-  gpuTempTrace.startTrace(TFT_ORANGE);
+  tft.setTextSize(1);
+  tft.fillRect(IO_TEXT_X, IO_TEXT_Y, CORE_BARS_X - IO_TEXT_X - 2, 2 * IO_LINE_HEIGHT, BG_COLOR);
+  tft.setTextColor(TFT_CYAN, BG_COLOR);
+  tft.drawString("NET " + String(rx) + "/" + String(tx), IO_TEXT_X, IO_TEXT_Y);
+  tft.setTextColor(TFT_YELLOW, BG_COLOR);
+  tft.drawString("DSK " + String(rd) + "/" + String(wr), IO_TEXT_X, IO_TEXT_Y + IO_LINE_HEIGHT);
+}
+
+// One bar per logical core, as many as fit
+static void drawCoreBars(const PCData &data) {
+  tft.fillRect(CORE_BARS_X, CORE_BARS_Y, CORE_BARS_WIDTH, CORE_BARS_HEIGHT, BG_COLOR);
+  if (data.coreCount == 0) return;
+  int slot = CORE_BARS_WIDTH / data.coreCount;
+  for (uint8_t i = 0; i < data.coreCount; i++) {
+    int height = min<int>(data.coreLoad[i], 100) * CORE_BARS_HEIGHT / 100;
+    int x = CORE_BARS_X + i * slot;
+    tft.drawFastHLine(x, CORE_BARS_Y + CORE_BARS_HEIGHT - 1, max(slot - 1, 1), TFT_DARKGREY);
+    if (height > 0) tft.fillRect(x, CORE_BARS_Y + CORE_BARS_HEIGHT - height, max(slot - 1, 1), height, CORE_BAR_COLOR);
+  }
 }
 
 // 更新 PC 数据
 void updatePerformanceData() {
+  // Copy under the lock (the serial task writes pcData), draw outside it
   if (xSemaphoreTake(xPCDataMutex, 10) != pdTRUE)
     return;
+  if (pcData.valid && millis() - lastFrameTime > 3000) {
+    pcData.valid = false; // PC agent stopped sending
+  }
+  PCData data = pcData;
+  xSemaphoreGive(xPCDataMutex);
+
   tft.setTextColor(VALUE_COLOR, BG_COLOR);
   tft.setTextSize(2);
-  if (pcData.valid) {
+  if (data.valid) {
     // CPU Data
     tft.fillRect(DATA_X + VALUE_OFFSET_X, DATA_Y, VALUE_WIDTH, LINE_HEIGHT, BG_COLOR);
     tft.setTextColor(TFT_GREEN, BG_COLOR);
-    tft.drawString(String(pcData.cpuLoad) + "% " + String(pcData.cpuTemp) + "C", DATA_X + VALUE_OFFSET_X, DATA_Y);
+    tft.drawString(String(data.cpuLoad) + "% " + String(data.cpuTemp) + "C", DATA_X + VALUE_OFFSET_X, DATA_Y);
     
     // GPU Data
     tft.fillRect(DATA_X + VALUE_OFFSET_X, DATA_Y + LINE_HEIGHT, VALUE_WIDTH, LINE_HEIGHT, BG_COLOR);
     tft.setTextColor(TFT_BLUE, BG_COLOR);
-    tft.drawString(String(pcData.gpuLoad) + "% " + String(pcData.gpuTemp) + "C", DATA_X + VALUE_OFFSET_X, DATA_Y + LINE_HEIGHT);
+    tft.drawString(String(data.gpuLoad) + "% " + String(data.gpuTemp) + "C", DATA_X + VALUE_OFFSET_X, DATA_Y + LINE_HEIGHT);
 
     // RAM Data
     tft.fillRect(DATA_X + VALUE_OFFSET_X, DATA_Y + 2 * LINE_HEIGHT, VALUE_WIDTH, LINE_HEIGHT, BG_COLOR);
     tft.setTextColor(TFT_RED, BG_COLOR);
-    tft.drawString(String(pcData.ramLoad, 1) + "%", DATA_X + VALUE_OFFSET_X, DATA_Y + 2 * LINE_HEIGHT);
-
-    static float gx = 0.0;
-    cpuLoadTrace.addPoint(gx, pcData.cpuLoad);
-    gpuLoadTrace.addPoint(gx, pcData.gpuLoad);
-    cpuTempTrace.addPoint(gx, pcData.ramLoad);
-    gpuTempTrace.addPoint(gx, pcData.gpuTemp);
-    gx += 1.0;
-    if (gx > 100.0) {
-      gx = 0.0;
-      combinedChart.drawGraph(COMBINED_CHART_X, COMBINED_CHART_Y);
-      cpuLoadTrace.startTrace(TFT_GREEN);
-      gpuLoadTrace.startTrace(TFT_BLUE);
-      cpuTempTrace.startTrace(TFT_RED);
-      gpuTempTrace.startTrace(TFT_ORANGE);
-    }
+    tft.drawString(String(data.ramLoad, 1) + "%", DATA_X + VALUE_OFFSET_X, DATA_Y + 2 * LINE_HEIGHT);
+
+    // Network, disk and per-core load
+    drawIoRates(data);
+    drawCoreBars(data);
+
+    combinedChart.addPoint(cpuLoadSeries, data.cpuLoad);
+    combinedChart.addPoint(gpuLoadSeries, data.gpuLoad);
+    combinedChart.addPoint(ramLoadSeries, data.ramLoad);
+    combinedChart.addPoint(gpuTempSeries, data.gpuTemp);
+    combinedChart.drawChart(COMBINED_CHART_X, COMBINED_CHART_Y);
 
   } else {
     tft.fillRect(DATA_X + VALUE_OFFSET_X, DATA_Y, VALUE_WIDTH, 3 * LINE_HEIGHT, BG_COLOR);
+    tft.fillRect(IO_TEXT_X, IO_TEXT_Y, CORE_BARS_X + CORE_BARS_WIDTH - IO_TEXT_X, 2 * IO_LINE_HEIGHT, BG_COLOR);
     tft.setTextColor(ERROR_COLOR, BG_COLOR);
     tft.setTextSize(2);
     tft.drawString("No Data", DATA_X + VALUE_OFFSET_X, DATA_Y);
@@ -150,95 +202,119 @@ void updatePerformanceData() {
   tft.setTextColor(TFT_ORANGE, BG_COLOR);
   tft.setTextSize(2);
   tft.drawString(String(esp32c3_temp, 1) + " C", DATA_X + VALUE_OFFSET_X, DATA_Y + 3 * LINE_HEIGHT);
-  
-  xSemaphoreGive(xPCDataMutex);
 }
 
 // 重置缓冲区
 void resetBuffer() {
   bufferIndex = 0;
-  inputBuffer[0] = '\0';
+  frameOverflow = false;
 }
 
-// 解析 PC 数据
-void parsePCData() {
-  struct PCData newData = {.cpuName = "Unknown",
-                           .gpuName = "Unknown",
-                           .cpuTemp = 0,
-                           .cpuLoad = 0,
-                           .gpuTemp = 0,
-                           .gpuLoad = 0,
-                           .ramLoad = 0.0,
-                           .valid = false};
-  char *ptr = nullptr;
-  ptr = strstr(inputBuffer, "C");
-  if (ptr) {
-    char *degree = strchr(ptr, 'c');
-    char *limit = strchr(ptr, '%');
-    if (degree && limit && degree < limit) {
-      char temp[8] = {0}, load[8] = {0};
-      strncpy(temp, ptr + 1, degree - ptr - 1);
-      strncpy(load, degree + 2, limit - degree - 2);
-      newData.cpuTemp = atoi(temp);
-      newData.cpuLoad = atoi(load);
+// CRC16-CCITT (poly 0x1021, init 0xFFFF)
+static uint16_t crc16_ccitt(const uint8_t *data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  while (length--) {
+    crc ^= (uint16_t)(*data++) << 8;
+    for (int i = 0; i < 8; i++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
     }
   }
-  ptr = strstr(inputBuffer, "G");
-  if (ptr) {
-    char *degree = strstr(ptr, "c");
-    char *limit = strchr(ptr, '%');
-    if (degree && limit && degree < limit) {
-      char temp[8] = {0}, load[8] = {0};
-      strncpy(temp, ptr + 1, degree - ptr - 1);
-      strncpy(load, degree + 2, limit - degree - 2);
-      newData.gpuTemp = atoi(temp);
-      newData.gpuLoad = atoi(load);
+  return crc;
+}
+
+// Decodes a COBS block in place (output is never longer than input).
+// Returns the decoded length, or 0 on a malformed block.
+static size_t cobsDecode(uint8_t *buf, size_t length) {
+  size_t read = 0, write = 0;
+  while (read < length) {
+    uint8_t code = buf[read++];
+    if (code == 0 || read + code - 1 > length) return 0;
+    for (uint8_t i = 1; i < code; i++) {
+      buf[write++] = buf[read++];
     }
-  }
-  ptr = strstr(inputBuffer, "RL");
-  if (ptr) {
-    ptr += 2;
-    char *end = strchr(ptr, '|');
-    if (end) {
-      char load[8] = {0};
-      strncpy(load, ptr, end - ptr);
-      newData.ramLoad = atof(load);
+    if (code != 0xFF && read < length) {
+      buf[write++] = 0;
     }
   }
-  ptr = strstr(inputBuffer, "CPU:");
-  if (ptr) {
-    ptr += 4;
-    char *end = strstr(ptr, "GPU:");
-    if (!end)
-      end = inputBuffer + strlen(inputBuffer);
-    if (end - ptr < sizeof(newData.cpuName) - 1) {
-      strncpy(newData.cpuName, ptr, end - ptr);
-      newData.cpuName[end - ptr] = '\0';
-      for (int i = strlen(newData.cpuName) - 1;
-           i >= 0 && newData.cpuName[i] == ' '; i--)
-        newData.cpuName[i] = '\0';
+  return write;
+}
+
+static void copyName(char *dst, size_t dst_size, const uint8_t *src, size_t length) {
+  if (length >= dst_size) length = dst_size - 1;
+  memcpy(dst, src, length);
+  dst[length] = '\0';
+}
+
+// 解析 PC 数据帧
+void handlePCFrame(const uint8_t *frame, size_t length) {
+  if (length < 4) return;
+  uint16_t crc = frame[length - 2] | (frame[length - 1] << 8);
+  if (crc16_ccitt(frame, length - 2) != crc) return;
+  if (frame[1] != PCMON_VERSION) return;
+
+  const uint8_t *payload = frame + 2;
+  size_t payload_len = length - 4;
+
+  if (frame[0] == PCMON_FRAME_STATS) {
+    // The fixed fields and core_count loads must all be there: a truncated
+    // frame would otherwise read as zeros
+    const size_t fixed_len = offsetof(PCMonStatsPayload, core_load);
+    if (payload_len < fixed_len) return;
+    PCMonStatsPayload stats;
+    memset(&stats, 0, sizeof(stats));
+    memcpy(&stats, payload, min(payload_len, sizeof(stats)));
+    if (stats.core_count > PCMON_MAX_CORES) stats.core_count = PCMON_MAX_CORES;
+    if (payload_len < fixed_len + stats.core_count) return;
+
+    if (xSemaphoreTake(xPCDataMutex, portMAX_DELAY) == pdTRUE) {
+      pcData.cpuLoad = stats.cpu_load;
+      pcData.cpuTemp = stats.cpu_temp;
+      pcData.gpuLoad = stats.gpu_load;
+      pcData.gpuTemp = stats.gpu_temp;
+      pcData.ramLoad = stats.ram_load_x10 / 10.0f;
+      pcData.ramUsedMB = stats.ram_used_mb;
+      pcData.ramTotalMB = stats.ram_total_mb;
+      pcData.netRxBps = stats.net_rx_bps;
+      pcData.netTxBps = stats.net_tx_bps;
+      pcData.diskReadBps = stats.disk_read_bps;
+      pcData.diskWriteBps = stats.disk_write_bps;
+      pcData.coreCount = stats.core_count;
+      memcpy(pcData.coreLoad, stats.core_load, sizeof(pcData.coreLoad));
+      pcData.valid = true;
+      lastFrameTime = millis();
+      xSemaphoreGive(xPCDataMutex);
     }
-  }
-  ptr = strstr(inputBuffer, "GPU:");
-  if (ptr) {
-    ptr += 4;
-    char *end = strchr(ptr, '|');
-    if (!end)
-      end = inputBuffer + strlen(inputBuffer);
-    if (end - ptr < sizeof(newData.gpuName) - 1) {
-      strncpy(newData.gpuName, ptr, end - ptr);
-      newData.gpuName[end - ptr] = '\0';
-      for (int i = strlen(newData.gpuName) - 1;
-           i >= 0 && newData.gpuName[i] == ' '; i--)
-        newData.gpuName[i] = '\0';
+  } else if (frame[0] == PCMON_FRAME_NAMES) {
+    // [cpu_len][cpu name][gpu_len][gpu name]
+    if (payload_len < 2) return;
+    size_t cpu_len = payload[0];
+    if (1 + cpu_len + 1 > payload_len) return;
+    size_t gpu_len = payload[1 + cpu_len];
+    if (2 + cpu_len + gpu_len > payload_len) return;
+
+    if (xSemaphoreTake(xPCDataMutex, portMAX_DELAY) == pdTRUE) {
+      copyName(pcData.cpuName, sizeof(pcData.cpuName), payload + 1, cpu_len);
+      copyName(pcData.gpuName, sizeof(pcData.gpuName), payload + 2 + cpu_len, gpu_len);
+      xSemaphoreGive(xPCDataMutex);
     }
   }
-  if (newData.cpuTemp > 0 || newData.gpuTemp > 0 || newData.ramLoad > 0) {
-    newData.valid = true;
-  }
-  if (xSemaphoreTake(xPCDataMutex, portMAX_DELAY) == pdTRUE) {
-    pcData = newData;
-    xSemaphoreGive(xPCDataMutex);
+}
+
+// Feeds received bytes into the frame assembler
+static void feedSerialBytes(const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    uint8_t b = data[i];
+    if (b == 0x00) {
+      if (!frameOverflow && bufferIndex > 0) {
+        size_t decoded = cobsDecode(inputBuffer, bufferIndex);
+        if (decoded > 0) handlePCFrame(inputBuffer, decoded);
+      }
+      resetBuffer();
+    } else if (bufferIndex < BUFFER_SIZE) {
+      inputBuffer[bufferIndex++] = b;
+    } else {
+      frameOverflow = true;
+    }
   }
 }
 
@@ -256,37 +332,51 @@ void Performance_Init_Task(void *pvParameters) {
 void Performance_Task(void *pvParameters) {
   for (;;)
  {
-    esp32c3_temp = temperatureRead();
+    esp32c3_temp = SensorHub_Value(SENSOR_CHIP_TEMP, esp32c3_temp);
     updatePerformanceData();
     vTaskDelay(pdMS_TO_TICKS(500)); // Update every second for smoother chart updates
   }
 }
 
 // 串口接收任务
+// Woken by the UART driver's RX event (via HardwareSerial::onReceive) and
+// drains everything available in bulk reads, so it sleeps between frames.
+static void onSerialReceive() {
+  if (serialTaskHandle != NULL) xTaskNotifyGive(serialTaskHandle);
+}
+
 void SERIAL_Task(void *pvParameters) {
+  uint8_t chunk[128];
+  resetBuffer();
+  serialTaskHandle = xTaskGetCurrentTaskHandle();
+#if ARDUINO_USB_CDC_ON_BOOT
+  const TickType_t waitTicks = pdMS_TO_TICKS(20); // USB CDC has no UART event queue
+#else
+  const TickType_t waitTicks = portMAX_DELAY;
+  Serial.onReceive(onSerialReceive);
+#endif
   for (;;)
  {
-    if (Serial.available()) {
-      char inChar = (char)Serial.read();
-      if (bufferIndex < BUFFER_SIZE - 1) {
-        inputBuffer[bufferIndex++] = inChar;
-        inputBuffer[bufferIndex] = '\0';
-      } else {
-        resetBuffer();
-      }
-      if (inChar == '\n') {
-        stringComplete = true;
-      }
+    ulTaskNotifyTake(pdTRUE, waitTicks);
+    int avail;
+    while ((avail = Serial.available()) > 0) {
+      size_t n = Serial.read(chunk, min((size_t)avail, sizeof(chunk)));
+      feedSerialBytes(chunk, n);
     }
-    if (stringComplete) {
-      parsePCData();
-      stringComplete = false;
-      resetBuffer();
-    }
-    vTaskDelay(pdMS_TO_TICKS(10));
   }
 }
 
+static void stopPerformanceTasks() {
+#if !ARDUINO_USB_CDC_ON_BOOT
+  Serial.onReceive(NULL);
+#endif
+  serialTaskHandle = NULL;
+  vTaskDelete(xTaskGetHandle("Perf_Show"));
+  vTaskDelete(xTaskGetHandle("Serial_Rx"));
+  vSemaphoreDelete(xPCDataMutex);
+  combinedChart.deleteChart();
+}
+
 // -----------------------------
 // 性能监控菜单入口
 // -----------------------------
@@ -296,22 +386,19 @@ void performanceMenu() {
   xPCDataMutex = xSemaphoreCreateMutex();
   xTaskCreatePinnedToCore(Performance_Init_Task, "Perf_Init", 8192, NULL, 2, NULL, 0);
   xTaskCreatePinnedToCore(Performance_Task, "Perf_Show", 8192, NULL, 1, NULL, 0);
-  xTaskCreatePinnedToCore(SERIAL_Task, "Serial_Rx", 2048, NULL, 1, NULL, 0);
+  xTaskCreatePinnedToCore(SERIAL_Task, "Serial_Rx", 3072, NULL, 2, NULL, 0);
   while (1) {
     if (exitSubMenu) {
         exitSubMenu = false; // Reset flag
-        vTaskDelete(xTaskGetHandle("Perf_Show"));
-        vTaskDelete(xTaskGetHandle("Serial_Rx"));
-        vSemaphoreDelete(xPCDataMutex);
+        stopPerformanceTasks();
         break;
     }
     if (g_alarm_is_ringing) { // ADDED LINE
+        stopPerformanceTasks();
         break; // Exit loop to perform cleanup
     }
     if (readButton()) {
-      vTaskDelete(xTaskGetHandle("Perf_Show"));
-      vTaskDelete(xTaskGetHandle("Serial_Rx"));
-      vSemaphoreDelete(xPCDataMutex);
+      stopPerformanceTasks();
       break;
     }
     vTaskDelay(pdMS_TO_TICKS(10));
@@ -18,7 +18,7 @@
 #define LOGO_X         5
 #define LOGO_Y_TOP     5
 #define LOGO_Y_BOTTOM  75
-#define BUFFER_SIZE    256
+#define BUFFER_SIZE    256   // Max decoded frame size
 
 // Combined Chart Dimensions and Position
 #define COMBINED_CHART_WIDTH    200
@@ -35,6 +35,16 @@
 #define LEGEND_SPACING_WIDE 80
 #define LEGEND_LINE_HEIGHT 15
 
+// Network/disk rates and per-core load, between the legend and the chart
+#define IO_TEXT_X        95
+#define IO_TEXT_Y        134
+#define IO_LINE_HEIGHT   10
+#define CORE_BARS_X      178
+#define CORE_BARS_Y      134
+#define CORE_BARS_WIDTH  60
+#define CORE_BARS_HEIGHT 18
+#define CORE_BAR_COLOR   TFT_GREEN
+
 // Arc display settings
 #define ARC_CPU_X 40
 #define ARC_CPU_Y 60
@@ -47,6 +57,36 @@
 #define ARC_CPU_COLOR TFT_GREEN
 #define ARC_GPU_COLOR TFT_BLUE
 
+// -----------------------------
+// PC 监控串口协议
+// -----------------------------
+// Each frame is COBS-encoded and terminated by a 0x00 byte.
+// Decoded frame: [type][version][payload...][crc16 lo][crc16 hi]
+// CRC16-CCITT (poly 0x1021, init 0xFFFF) covers type, version and payload.
+// All multi-byte fields are little-endian. pc_monitor_sender.py is the host side.
+#define PCMON_VERSION          1
+#define PCMON_FRAME_STATS      0x01
+#define PCMON_FRAME_NAMES      0x02
+#define PCMON_MAX_CORES        16
+#define PCMON_NAME_LEN         63
+
+struct __attribute__((packed)) PCMonStatsPayload {
+  uint8_t  seq;
+  uint8_t  cpu_load;         // %
+  int8_t   cpu_temp;         // C
+  uint8_t  gpu_load;         // %
+  int8_t   gpu_temp;         // C
+  uint16_t ram_load_x10;     // 0.1 %
+  uint16_t ram_used_mb;
+  uint16_t ram_total_mb;
+  uint32_t net_rx_bps;       // bytes/s
+  uint32_t net_tx_bps;
+  uint32_t disk_read_bps;
+  uint32_t disk_write_bps;
+  uint8_t  core_count;
+  uint8_t  core_load[PCMON_MAX_CORES]; // Only core_count entries are sent
+};
+
 // -----------------------------
 // 函数声明
 // -----------------------------
@@ -55,7 +95,7 @@ void drawPerformanceStaticElements();
 void updatePerformanceData();
 void showPerformanceError(const char *msg);
 void resetBuffer();
-void parsePCData();
+void handlePCFrame(const uint8_t *frame, size_t length);
 void Performance_Init_Task(void *pvParameters);
 void Performance_Task(void *pvParameters);
 void SERIAL_Task(void *pvParameters);
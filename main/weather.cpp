@@ -95,8 +95,7 @@ bool ensureWiFiConnected() {
             Serial.println("Initiating WiFi connection...");
             // Modified: Include time in status string
             sprintf(wifiStatusStr, "WiFi: Connecting at %02d:%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-            WiFi.mode(WIFI_STA);
-            WiFi.begin(ssid, password); // Non-blocking call
+            beginWiFiFastReconnect(ssid, password); // Non-blocking call, directed if cached
             wifiConnectAttemptStartMillis = millis();
             lastWiFiRetryMillis = millis(); // Update last retry time
             currentWiFiState = WIFI_STATE_CONNECTING;
@@ -149,6 +148,23 @@ bool connectWiFi() {
         delay(2000);
         return true;
     }
+
+    // Directed connect to the cached AP first; the scan and the slow
+    // begin/poll below only run when that fails.
+    tft.fillScreen(BG_COLOR);
+    tft.setTextSize(2);
+    tft.setTextDatum(MC_DATUM);
+    tft.drawString("Connecting WiFi...", 120, 20);
+    tft_log_y = 40;
+    if (fastConnectWiFi(ssid, password)) {
+        tftLog("Fast reconnect OK", TFT_GREEN);
+        Serial.println("Fast reconnect OK");
+        WiFi.setDNS(IPAddress(8, 8, 8, 8), IPAddress(8, 8, 4, 4)); // As the full connect below does
+        strcpy(wifiStatusStr, "WiFi: Connected");
+        wifi_connected = true;
+        return true;
+    }
+
     tft.fillScreen(BG_COLOR);
     tft.setTextSize(2);
     tft.setTextDatum(MC_DATUM);